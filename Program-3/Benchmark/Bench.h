@@ -0,0 +1,33 @@
+/// \file Bench.h
+/// \brief Interface for the benchmark timer class CBench.
+
+#ifndef __L4RC_BENCHMARK_BENCH_H__
+#define __L4RC_BENCHMARK_BENCH_H__
+
+#include <chrono>
+
+/// \brief Benchmark timer.
+///
+/// A simple wall clock timer for benchmarks. It runs a function a given
+/// number of times and reports the average time per call in nanoseconds.
+/// Run a benchmark a few times first to warm up the caches.
+
+class CBench{
+  public:
+    /// Time a function.
+    /// \param f A function, usually a lambda.
+    /// \param n Number of times to call it.
+    /// \return Average time per call in nanoseconds.
+
+    template<class F> static double Time(F f, unsigned n){
+      const auto t0 = std::chrono::high_resolution_clock::now();
+
+      for(unsigned i=0; i<n; i++)
+        f();
+
+      const auto t1 = std::chrono::high_resolution_clock::now();
+      return std::chrono::duration<double, std::nano>(t1 - t0).count()/n;
+    } //Time
+}; //CBench
+
+#endif //__L4RC_BENCHMARK_BENCH_H__
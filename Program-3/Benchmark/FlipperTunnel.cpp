@@ -0,0 +1,122 @@
+/// \file FlipperTunnel.cpp
+/// \brief Code for the flipper tunnelling scene class CFlipperTunnelScene.
+
+#include "FlipperTunnel.h"
+#include "CapsuleShape.h"
+
+const float RADIUS = 12.5f; ///< Radius of dynamic circles, same as the ball sprite.
+const float ROTSPEED = 4.0f; ///< Flipper rotational speed in revs per second, same as the game.
+const float DOWN_ANGLE = 11.0f*XM_PI/6.0f; ///< Orientation of flipper when fully down.
+const float UP_ANGLE = XM_PI/4.0f; ///< Orientation of flipper when fully up.
+const float DROP_HEIGHT = 30.0f; ///< Height above the flipper of the falling dynamic circles.
+const float DROP_SPEED = 300.0f; ///< Speed of the falling dynamic circles.
+const unsigned SOLVER_ITERATIONS = 4; ///< Contact solver iterations per substep, the solver's minimum.
+
+/// Make a flipper the same size and shape as the game's right flipper with
+/// n dynamic circles spread along its length. Half of them lie on it
+/// and the other half are falling onto it.
+/// \param n Number of dynamic circles.
+/// \param substeps Number of substeps per frame.
+/// \param bSwept true to sweep dynamic circles through the rotating flipper.
+
+CFlipperTunnelScene::CFlipperTunnelScene(unsigned n, unsigned substeps, bool bSwept):
+  m_nSubsteps(substeps), m_bSwept(bSwept)
+{
+  m_fGravity = -200.0f;
+
+  const float r0 = 10.0f; //radius of end 0
+  const float r1 = 6.5f; //radius of end 1
+  const float len = 58.0f; //distance between centers
+
+  CCapsuleDesc capDesc(Vector2(0.0f), r0, Vector2(len, 0.0f), r1, 0.1f);
+  capDesc.m_eMotionType = eMotion::Kinematic;
+  m_cFlipper.AddShape(m_cStore.Get(m_cStore.Make(&capDesc)));
+  m_cFlipper.SetRotCenter(Vector2(0.0f));
+  m_cFlipper.SetOrientation(DOWN_ANGLE);
+  m_cFlipper.SetRotSpeed(ROTSPEED); //counterclockwise, that is, up
+
+  const float s = sinf(DOWN_ANGLE);
+  const float c = cosf(DOWN_ANGLE);
+
+  CDynamicCircleDesc d;
+  d.m_fRadius = RADIUS;
+  d.m_fElasticity = 0.9f;
+
+  for(unsigned i=0; i<n; i++){
+    const float u = n > 1? len*i/(n - 1): 0.0f; //distance along flipper
+    const bool bDrop = i%2 == 1; //whether this one is falling
+    const float h = r0 - (r0 - r1)*u/len + RADIUS + (bDrop? DROP_HEIGHT: 0.5f); //height above axis
+
+    d.m_vPos = RotatePt(Vector2(u, h), Vector2(0.0f), s, c);
+    d.m_vVel = bDrop? Vector2(0.0f, -DROP_SPEED): Vector2(0.0f);
+
+    CDynamicCircle* p = (CDynamicCircle*)m_cStore.Get(m_cStore.Make(&d));
+    p->SetPos(d.m_vPos);
+    Add(p);
+  } //for
+} //constructor
+
+/// Step through one 60Hz frame, dividing it into substeps. In each substep
+/// the flipper is rotated and stopped if it has gone past the up angle,
+/// then the dynamic circles are moved and their contacts with the flipper
+/// resolved by the contact solver. The flipper is rotated here instead of
+/// by the world so that it can be stopped before the rotating shapes are
+/// listed, and the world's candidates aren't used since the dynamic circles
+/// don't collide with each other.
+
+void CFlipperTunnelScene::StepFrame(){
+  m_fTimeStep = 1.0f/(60.0f*m_nSubsteps);
+
+  for(unsigned j=0; j<m_nSubsteps; j++){
+    m_cFlipper.move();
+
+    const float a = m_cFlipper.GetOrientation();
+
+    if(a < XM_PI && a > UP_ANGLE){ //gone past up angle
+      m_cFlipper.SetOrientation(UP_ANGLE);
+      m_cFlipper.SetRotSpeed(0.0f);
+    } //if
+
+    m_stdRotating.clear();
+
+    for(auto const& p: m_cFlipper.GetShapes())
+      if(p->GetRotating())
+        m_stdRotating.push_back(p);
+
+    for(auto const& pCirc: m_stdCircles){
+      pCirc->UpdateSleep();
+
+      if(m_bSwept)SweptMove(pCirc);
+      else pCirc->move();
+    } //for
+
+    m_cSolver.Begin();
+
+    for(auto const& pCirc: m_stdCircles)
+      for(auto const& pShape: m_cFlipper.GetShapes())
+        NarrowPhase(pShape, pCirc);
+
+    m_cSolver.Solve(SOLVER_ITERATIONS);
+  } //for
+} //StepFrame
+
+/// Get the number of dynamic circles that the flipper has passed through.
+/// \return Number of dynamic circles whose centers are under the flipper.
+
+unsigned CFlipperTunnelScene::GetThroughCount(){
+  const CCapsuleShape* p = (CCapsuleShape*)m_cFlipper.GetShapes()[0];
+  const Vector2 axis = p->GetAxis();
+  const Vector2 n = perp(axis); //upward normal to axis
+  const float len = (p->GetPt1() - p->GetPt0()).Length();
+  unsigned count = 0;
+
+  for(auto const& pCirc: m_stdCircles){
+    const Vector2 q = pCirc->GetPos() - p->GetPt0();
+    const float u = axis.Dot(q); //distance along axis
+
+    if(n.Dot(q) < 0.0f && u >= -p->GetRadius0() && u <= len + p->GetRadius1())
+      ++count;
+  } //for
+
+  return count;
+} //GetThroughCount
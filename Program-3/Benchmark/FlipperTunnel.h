@@ -0,0 +1,44 @@
+/// \file FlipperTunnel.h
+/// \brief Interface for the flipper tunnelling scene class CFlipperTunnelScene.
+
+#ifndef __L4RC_BENCHMARK_FLIPPERTUNNEL_H__
+#define __L4RC_BENCHMARK_FLIPPERTUNNEL_H__
+
+#include <vector>
+
+#include "World.h"
+#include "ShapeStore.h"
+
+/// \brief Flipper tunnelling scene.
+///
+/// A headless scene for measuring tunnelling through a rotating flipper,
+/// consisting of a single flipper the same size as the game's left flipper
+/// and some dynamic circles lying on it or falling onto it. The flipper
+/// flips up as soon as the scene starts. The dynamic circles don't collide
+/// with each other, so each one is a separate trial. Any dynamic circle that
+/// ends up under the flipper has been passed through by it. Each frame is
+/// divided into a number of substeps, in each of which the flipper is rotated,
+/// the dynamic circles are moved, either simply or by the world's swept move,
+/// which sweeps them through the rotating flipper, and the contacts with the
+/// flipper found by the world's narrow phase are resolved by the contact
+/// solver, the way that the game does it.
+
+class CFlipperTunnelScene:
+  public CShapeCommon,
+  public CWorld
+{
+  private:
+    CShapeStore m_cStore; ///< Shape store, owns all shapes.
+    CCompoundShape m_cFlipper; ///< Flipper.
+
+    unsigned m_nSubsteps = 1; ///< Number of substeps per frame.
+    bool m_bSwept = false; ///< Whether to sweep through the rotating flipper.
+
+  public:
+    CFlipperTunnelScene(unsigned, unsigned, bool); ///< Constructor.
+
+    void StepFrame(); ///< Step through one frame.
+    unsigned GetThroughCount(); ///< Get number of dynamic circles under the flipper.
+}; //CFlipperTunnelScene
+
+#endif //__L4RC_BENCHMARK_FLIPPERTUNNEL_H__
@@ -0,0 +1,82 @@
+/// \file Flippers.cpp
+/// \brief Code for the flipper scene class CFlipperScene.
+
+#include "Flippers.h"
+#include "Circle.h"
+#include "CapsuleShape.h"
+
+const float SPACING = 160.0f; ///< Distance between centers of rotation of flippers.
+
+/// Make a row of n flippers, each the same size and with the same
+/// initial orientation as the left flipper in the game.
+/// \param n Number of flippers.
+/// \param bCapsule Whether to make each flipper a capsule instead of four shapes.
+
+CFlipperScene::CFlipperScene(unsigned n, bool bCapsule){
+  m_fTimeStep = 1.0f/240.0f; //same as the game
+  m_stdFlippers.resize(n);
+
+  for(unsigned i=0; i<n; i++){
+    const Vector2 p(i*SPACING, 0.0f); //center of rotation
+    CCompoundShape& flipper = m_stdFlippers[i];
+
+    if(bCapsule){
+      CCapsuleDesc capDesc(p, 10.0f, p + Vector2(58.0f, 0.0f), 6.5f, 0.1f);
+      capDesc.m_eMotionType = eMotion::Kinematic;
+      CShape* q = m_cStore.Get(m_cStore.Make(&capDesc));
+
+      flipper.AddShape(q);
+      m_stdShapes.push_back(q);
+    } //if
+
+    else{
+      CCircleDesc circDesc(p, 10.0f, 0.2f);
+      circDesc.m_eMotionType = eMotion::Kinematic;
+      CCircle* pCirc0 = (CCircle*)m_cStore.Get(m_cStore.Make(&circDesc));
+
+      circDesc.m_vPos = p + Vector2(58.0f, 0.0f);
+      circDesc.m_fRadius = 6.5f;
+      CCircle* pCirc1 = (CCircle*)m_cStore.Get(m_cStore.Make(&circDesc));
+
+      CLineSegDesc lsDesc0;
+      lsDesc0.m_fElasticity = 0.1f;
+      lsDesc0.m_eMotionType = eMotion::Kinematic;
+      CLineSegDesc lsDesc1(lsDesc0);
+      pCirc1->Tangents(pCirc0, lsDesc0, lsDesc1);
+
+      for(CShape* q: {(CShape*)pCirc0, (CShape*)pCirc1, 
+        m_cStore.Get(m_cStore.Make(&lsDesc0)), m_cStore.Get(m_cStore.Make(&lsDesc1))})
+      {
+        flipper.AddShape(q);
+        m_stdShapes.push_back(q);
+      } //for
+    } //else
+
+    flipper.SetRotCenter(p);
+    flipper.SetOrientation(11.0f*XM_PI/6.0f);
+  } //for
+} //constructor
+
+/// Set the rotation speed of all of the flippers. Zero parks them.
+/// \param s Rotation speed in revolutions per second.
+
+void CFlipperScene::SetRotSpeed(float s){
+  for(auto& p: m_stdFlippers)
+    p.SetRotSpeed(s);
+} //SetRotSpeed
+
+/// Move each kinematic shape by itself, which is what the game used to do.
+/// Each one computes the sine and cosine of its own orientation.
+
+void CFlipperScene::StepShapes(){
+  for(auto const& p: m_stdShapes)
+    p->move();
+} //StepShapes
+
+/// Move each flipper as a whole, computing the sine and cosine of its
+/// orientation once for all of its shapes.
+
+void CFlipperScene::StepCompounds(){
+  for(auto& p: m_stdFlippers)
+    p.move();
+} //StepCompounds
@@ -0,0 +1,35 @@
+/// \file Flippers.h
+/// \brief Interface for the flipper scene class CFlipperScene.
+
+#ifndef __L4RC_BENCHMARK_FLIPPERS_H__
+#define __L4RC_BENCHMARK_FLIPPERS_H__
+
+#include <vector>
+
+#include "Compound.h"
+#include "ShapeStore.h"
+
+/// \brief Flipper scene.
+///
+/// A headless scene for measuring the cost of moving kinematic shapes,
+/// consisting of a row of flippers, each of which is a compound shape made
+/// up of either two kinematic circles and two kinematic line segments that
+/// are tangent to both of them, which is how the game used to make them, or
+/// a single kinematic capsule, which is how it makes them now. There are no
+/// dynamic circles, so only the transforms are measured.
+
+class CFlipperScene: public CShapeCommon{
+  private:
+    CShapeStore m_cStore; ///< Shape store, owns all shapes.
+    std::vector<CCompoundShape> m_stdFlippers; ///< Flippers.
+    std::vector<CShape*> m_stdShapes; ///< Kinematic shapes in all flippers.
+
+  public:
+    CFlipperScene(unsigned, bool =false); ///< Constructor.
+
+    void SetRotSpeed(float); ///< Set rotation speed of all flippers.
+    void StepShapes(); ///< Move each kinematic shape by itself.
+    void StepCompounds(); ///< Move each flipper as a whole.
+}; //CFlipperScene
+
+#endif //__L4RC_BENCHMARK_FLIPPERS_H__
@@ -0,0 +1,1153 @@
+/// \file Main.cpp 
+/// \brief Headless benchmarks for the Shapes library.
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "Bench.h"
+#include "Scene.h"
+#include "Tunnel.h"
+#include "FlipperTunnel.h"
+#include "Flippers.h"
+#include "Table.h"
+#include "Pile.h"
+#include "Reference.h"
+#include "LineSegBatch.h"
+#include "ShapeStore.h"
+#include "SlotMap.h"
+#include "TableDesc.h"
+#include "Grid.h"
+#include "CollisionStats.h"
+
+volatile float g_fSink = 0.0f; ///< Somewhere to put results so that they aren't optimized away.
+
+const char TABLE_SOURCE[] = "Media/Tables/default.txt"; ///< Game table, source form.
+const char TABLE_COMPILED[] = "Media/Tables/default.bin"; ///< Game table, compiled form.
+const float TABLE_CELL_SIZE = 32.0f; ///< Grid cell size that the game uses.
+
+/// Vertices of the game's pentagonal bumper, relative to its center.
+
+const Vector2 g_vPentagon[5] = {
+  Vector2(0.0f, 35.0f), Vector2(33.2801f, 10.8368f), Vector2(20.60855f, -28.32214f),
+  Vector2(-20.60855f, -28.32214f), Vector2(-33.2801f, 10.8368f)
+}; //g_vPentagon
+
+/// Time one step of a scene with sweep and prune against one step
+/// with all pairs of dynamic circles tested, for increasing numbers
+/// of dynamic circles. Brute force is skipped when it would take
+/// too long to be worth waiting for.
+
+void BenchSweepAndPrune(){
+  printf("Sweep and prune\n");
+  printf("%8s %16s %16s %12s\n", "balls", "brute ns/step", "sweep ns/step", "pairs/step");
+
+  for(unsigned n: {1, 10, 100, 1000}){
+    const unsigned steps = n < 100? 10000: n < 1000? 1000: 100;
+
+    CScene brute(n);
+    CScene sweep(n);
+
+    CBench::Time([&](){brute.StepBruteForce();}, steps/10); //warm up
+    CBench::Time([&](){sweep.StepSweep();}, steps/10); //warm up
+
+    const double t0 = CBench::Time([&](){brute.StepBruteForce();}, steps);
+    const double t1 = CBench::Time([&](){sweep.StepSweep();}, steps);
+
+    printf("%8u %16.0f %16.0f %12zu\n", n, t0, t1, sweep.GetPairCount());
+  } //for
+
+  printf("\n");
+} //BenchSweepAndPrune
+
+/// Time testing a dynamic circle against a batch of line segments one at
+/// a time using CLineSeg::PreCollide() against all at once using
+/// CLineSegBatch::Collide(). The line segments are short and scattered
+/// around the circle so that some of them collide with it.
+
+void BenchLineSegBatch(){
+  printf("Line segment batch\n");
+  printf("%8s %16s %16s %8s\n", "segs", "scalar ns/test", "batch ns/test", "hits");
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> pos(-64.0f, 64.0f);
+
+  CDynamicCircleDesc d;
+  d.m_fRadius = 12.5f;
+  CDynamicCircle circ(d);
+  circ.SetPos(Vector2(0.0f));
+
+  for(UINT n: {4, 16, 64, 256}){
+    std::vector<CLineSeg*> linesegs;
+    CLineSegBatch batch;
+
+    for(UINT i=0; i<n; i++){
+      const Vector2 p0(pos(rng), pos(rng));
+      const Vector2 p1 = p0 + Vector2(pos(rng), pos(rng))/2.0f;
+      CLineSegDesc lsDesc(p0, p1);
+      linesegs.push_back(new CLineSeg(lsDesc));
+      batch.Add(linesegs.back(), i);
+    } //for
+
+    const unsigned steps = 100000;
+    UINT hits = 0;
+    std::vector<UINT> result;
+
+    const double t0 = CBench::Time([&](){
+      hits = 0;
+
+      for(auto const& p: linesegs){
+        CContactDesc cd(p, &circ);
+        if(p->PreCollide(cd))++hits;
+      } //for
+    }, steps);
+
+    const double t1 = CBench::Time([&](){
+      result.clear();
+      batch.Collide(&circ, 0, batch.GetSize(), result);
+    }, steps);
+
+    printf("%8u %16.2f %16.2f %8u\n", n, t0/n, t1/n, hits);
+
+    for(auto const& p: linesegs)
+      delete p;
+  } //for
+
+  printf("\n");
+} //BenchLineSegBatch
+
+/// Count the number of very fast dynamic circles that tunnel out of a
+/// small box in one second, and time a frame, for different numbers of
+/// substeps per frame with and without time of impact. The number of
+/// broad phase passes per frame is the number of substeps.
+
+void BenchTunnelling(){
+  printf("Tunnelling\n");
+  printf("%8s %8s %10s %16s\n", "substeps", "swept", "escaped", "ns/frame");
+
+  const unsigned n = 1000; //number of dynamic circles
+  const unsigned frames = 60; //one second
+
+  for(unsigned substeps: {1, 2, 4})
+    for(bool bSwept: {false, true}){
+      CTunnelScene scene(n, substeps, bSwept);
+      const double t = CBench::Time([&](){scene.StepFrame();}, frames);
+      printf("%8u %8s %10u %16.0f\n", substeps, bSwept? "yes": "no", scene.GetEscapeCount(), t);
+    } //for
+
+  printf("\n");
+} //BenchTunnelling
+
+/// Flip a flipper up under dynamic circles lying on it or falling onto it,
+/// with and without sweeping them through the rotating flipper, for
+/// several numbers of substeps per frame, and count how many of them the
+/// flipper has passed through when it has finished flipping.
+
+void BenchFlipperTunnelling(){
+  printf("Flipper tunnelling\n");
+  printf("%8s %8s %10s %16s\n", "substeps", "swept", "through", "ns/frame");
+
+  const unsigned n = 256; //number of dynamic circles
+  const unsigned frames = 8; //long enough for a full flip
+
+  for(unsigned substeps: {1, 2, 4})
+    for(bool bSwept: {false, true}){
+      CFlipperTunnelScene scene(n, substeps, bSwept);
+      const double t = CBench::Time([&](){scene.StepFrame();}, frames);
+      printf("%8u %8s %10u %16.0f\n", substeps, bSwept? "yes": "no", scene.GetThroughCount(), t);
+    } //for
+
+  printf("\n");
+} //BenchFlipperTunnelling
+
+/// Time a frame of a scene with a fixed four substeps, which is what the
+/// game used to do, against a frame with as many substeps as the substep
+/// scheduler chooses. The dynamic circles in the scene move at no more
+/// than 400 pixels per second, which is typical of most frames in the game.
+
+void BenchScheduler(){
+  printf("Substep scheduler\n");
+  printf("%8s %16s %16s %10s\n", "balls", "fixed ns/frame", "sched ns/frame", "substeps");
+
+  CSubstepScheduler fixed;
+  fixed.SetBounds(4, 4, 1);
+
+  CSubstepScheduler sched;
+  sched.SetBounds(1, 4, 1);
+
+  for(unsigned n: {1, 10, 100, 1000}){
+    const unsigned frames = n < 100? 10000: n < 1000? 1000: 100;
+
+    CScene scene0(n);
+    CScene scene1(n);
+    UINT substeps = 0;
+
+    const double t0 = CBench::Time([&](){scene0.StepFrame(fixed);}, frames);
+    const double t1 = CBench::Time([&](){substeps = scene1.StepFrame(sched);}, frames);
+
+    printf("%8u %16.0f %16.0f %10u\n", n, t0, t1, substeps);
+  } //for
+
+  printf("\n");
+} //BenchScheduler
+
+/// Time a step with several collision passes, with and without the
+/// candidate pair cache, and count the AABB tests and line segment batch
+/// tests per step using the collision statistics.
+
+void BenchPairCache(){
+  printf("Candidate pair cache\n");
+  printf("%8s %8s %14s %14s %14s %14s\n", "balls", "passes", 
+    "fresh ns/step", "cached ns/step", "fresh tests", "cached tests");
+
+  for(unsigned n: {10, 100, 1000})
+    for(UINT passes: {2, 4}){
+      const unsigned steps = n < 100? 10000: n < 1000? 1000: 100;
+      double t[2]; //time per step
+      UINT tests[2]; //AABB and narrow phase tests per step
+
+      for(int i=0; i<2; i++){
+        CScene scene(n);
+        CCollisionStats::EndFrame(); //start counting from zero
+        t[i] = CBench::Time([&](){scene.StepPasses(passes, i == 1);}, steps);
+        CCollisionStats::EndFrame();
+
+        const CCollisionCounts& c = CCollisionStats::GetFrame();
+        tests[i] = (c.GetAabbTests() + c.GetPreCollides())/steps;
+      } //for
+
+      printf("%8u %8u %14.0f %14.0f %14u %14u\n", n, passes, t[0], t[1], tests[0], tests[1]);
+    } //for
+
+  printf("\n");
+} //BenchPairCache
+
+/// Time a substep's worth of kinematic transforms for a row of flippers,
+/// moving each shape by itself against moving each flipper as a whole,
+/// both while the flippers are rotating and while they are parked. The last
+/// column moves each flipper as a whole when it is a single capsule.
+
+void BenchFlippers(){
+  printf("Kinematic transforms\n");
+  printf("%8s %10s %16s %16s %16s\n", "flippers", "state", "shape ns/step", "flipper ns/step",
+    "capsule ns/step");
+
+  for(unsigned n: {2, 20, 200}){
+    const unsigned steps = 1000000/n;
+
+    for(float speed: {4.0f, 0.0f}){
+      CFlipperScene scene0(n);
+      CFlipperScene scene1(n);
+      CFlipperScene scene2(n, true);
+      scene0.SetRotSpeed(speed);
+      scene1.SetRotSpeed(speed);
+      scene2.SetRotSpeed(speed);
+
+      const double t0 = CBench::Time([&](){scene0.StepShapes();}, steps);
+      const double t1 = CBench::Time([&](){scene1.StepCompounds();}, steps);
+      const double t2 = CBench::Time([&](){scene2.StepCompounds();}, steps);
+
+      printf("%8u %10s %16.0f %16.0f %16.0f\n", n, speed == 0.0f? "parked": "rotating", t0, t1, t2);
+    } //for
+  } //for
+
+  printf("\n");
+} //BenchFlippers
+
+/// Time CShapeStore::PreCollide() for a static shape of each type against
+/// dynamic circles scattered around it so that some of them hit it. The
+/// circles are visited in turn so that the branches aren't predictable.
+
+void BenchPreCollide(){
+  printf("PreCollide kernels\n");
+  printf("%8s %12s %12s %8s\n", "shape", "ns/test", "Mtests/s", "hit %");
+
+  const UINT n = 1024; //number of dynamic circles, a power of 2
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> pos(-64.0f, 64.0f);
+
+  CDynamicCircleDesc d;
+  d.m_fRadius = 12.5f;
+  std::vector<CDynamicCircle*> circles;
+
+  for(UINT i=0; i<n; i++){
+    circles.push_back(new CDynamicCircle(d));
+    circles.back()->SetPos(Vector2(pos(rng), pos(rng)));
+  } //for
+
+  CPointDesc ptDesc(Vector2(0.0f));
+  CLineSegDesc lsDesc(Vector2(-48.0f, -16.0f), Vector2(48.0f, 16.0f));
+  CCircleDesc circDesc(Vector2(0.0f), 24.0f);
+  CArcDesc arcDesc(Vector2(0.0f), 40.0f, 0.0f, XM_PI);
+  CPolygonDesc polyDesc(g_vPentagon, 5);
+  CCapsuleDesc capDesc(Vector2(-29.0f, 0.0f), 10.0f, Vector2(29.0f, 0.0f), 6.5f);
+
+  CShape* shapes[] = {
+    new CPoint(ptDesc), new CLineSeg(lsDesc), new CCircle(circDesc), new CArc(arcDesc),
+    new CPolygonShape(polyDesc), new CCapsuleShape(capDesc)
+  }; //one of each type
+
+  const unsigned steps = 10000000;
+
+  for(int j=0; j<6; j++){
+    CShape* p = shapes[j];
+    UINT i = 0; //index of next dynamic circle
+    UINT hits = 0; //number of collisions
+
+    const double t = CBench::Time([&](){
+      CContactDesc cd(p, circles[i++ & (n - 1)]);
+      if(CShapeStore::PreCollide(p, cd))++hits;
+    }, steps);
+
+    printf("%8s %12.2f %12.1f %8.1f\n", CCollisionStats::GetShapeName(p->GetShapeType()), t, 1000.0/t, 100.0*hits/steps);
+    delete p;
+  } //for
+
+  for(auto const& p: circles)
+    delete p;
+
+  printf("\n");
+} //BenchPreCollide
+
+/// Time each of the kernels that no longer divide or use trig against
+/// its old form in Reference.cpp, and check that they agree. The error is
+/// the largest distance between the points that the two forms
+/// find, except for the point in sector test, where it is the number of
+/// points that the two forms put on different sides of a sector boundary.
+
+void BenchKernels(){
+  printf("Division-free and trig-free kernels\n");
+  printf("%16s %12s %12s %10s %12s\n", "kernel", "old ns/op", "new ns/op", "speedup", "max error");
+
+  const UINT n = 1024; //number of points, a power of 2
+  const UINT m = 16; //number of shapes, a power of 2
+  const unsigned steps = 10000000;
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> pos(-64.0f, 64.0f);
+  std::uniform_real_distribution<float> angle(0.0f, XM_2PI);
+
+  std::vector<Vector2> pts(n); //points
+  for(UINT i=0; i<n; i++)
+    pts[i] = Vector2(pos(rng), pos(rng));
+
+  auto print = [](const char* name, double t0, double t1, float err){
+    printf("%16s %12.2f %12.2f %10.2f %12.3g\n", name, t0, t1, t0/t1, err);
+  }; //print
+
+  Vector2 sum; //so that the results are used
+  UINT i = 0; //index of next point
+  float err = 0.0f; //largest error
+
+  //closest point on line, slope-intercept against normal and offset
+
+  std::vector<CLineSeg*> segs;
+  std::vector<CRefLine> lines;
+
+  for(UINT j=0; j<m; j++){
+    const Vector2 v = 48.0f*AngleToVector(angle(rng));
+    CLineSegDesc d(v, -v);
+    segs.push_back(new CLineSeg(d));
+    lines.push_back(CRefLine(d.GetEndPt0(), d.GetEndPt1()));
+  } //for
+
+  for(UINT j=0; j<m; j++)
+    for(UINT k=0; k<n; k++)
+      err = max(err, (lines[j].ClosestPt(pts[k]) - segs[j]->ClosestPt(pts[k])).Length());
+
+  double t0 = CBench::Time([&](){
+    const UINT j = i++;
+    sum += lines[j & (m - 1)].ClosestPt(pts[j & (n - 1)]);
+  }, steps);
+
+  double t1 = CBench::Time([&](){
+    const UINT j = i++;
+    sum += segs[j & (m - 1)]->ClosestPt(pts[j & (n - 1)]);
+  }, steps);
+
+  print("ClosestPt", t0, t1, err);
+
+  for(auto const& p: segs)
+    delete p;
+
+  //point in sector, atan2 against cross products
+
+  std::vector<CArc*> arcs;
+  std::vector<float> a0(m), a1(m);
+  UINT mismatches = 0;
+
+  for(UINT j=0; j<m; j++){
+    a0[j] = angle(rng);
+    a1[j] = angle(rng);
+    CArcDesc d(Vector2(0.0f), 40.0f, a0[j], a1[j]);
+    arcs.push_back(new CArc(d));
+  } //for
+
+  for(UINT j=0; j<m; j++)
+    for(UINT k=0; k<n; k++)
+      if(RefPtInSector(Vector2(0.0f), a0[j], a1[j], pts[k]) != arcs[j]->PtInSector(pts[k]))
+        ++mismatches;
+
+  UINT hits = 0; //so that the results are used
+
+  t0 = CBench::Time([&](){
+    const UINT j = i++;
+    if(RefPtInSector(Vector2(0.0f), a0[j & (m - 1)], a1[j & (m - 1)], pts[j & (n - 1)]))++hits;
+  }, steps);
+
+  t1 = CBench::Time([&](){
+    const UINT j = i++;
+    if(arcs[j & (m - 1)]->PtInSector(pts[j & (n - 1)]))++hits;
+  }, steps);
+
+  print("PtInSector", t0, t1, (float)mismatches);
+
+  for(auto const& p: arcs)
+    delete p;
+
+  //tangents through a point, trig against rotation by sine and cosine
+
+  CCircle circ(CCircleDesc(Vector2(0.0f), 24.0f));
+  std::vector<Vector2> outside; //points outside the circle
+
+  for(auto const& p: pts)
+    if(p.Length() > 25.0f)
+      outside.push_back(p);
+
+  outside.resize(n/2); //a power of 2
+  err = 0.0f;
+
+  for(auto const& p: outside){
+    Vector2 p0, p1, q0, q1;
+    RefTangents(Vector2(0.0f), 24.0f, p, p0, p1);
+    circ.Tangents(p, q0, q1);
+    err = max(err, max((p0 - q0).Length(), (p1 - q1).Length()));
+  } //for
+
+  t0 = CBench::Time([&](){
+    Vector2 p0, p1;
+    RefTangents(Vector2(0.0f), 24.0f, outside[i++ & (n/2 - 1)], p0, p1);
+    sum += p0 + p1;
+  }, steps);
+
+  t1 = CBench::Time([&](){
+    Vector2 p0, p1;
+    circ.Tangents(outside[i++ & (n/2 - 1)], p0, p1);
+    sum += p0 + p1;
+  }, steps);
+
+  print("Tangents", t0, t1, err);
+
+  g_fSink = sum.x + sum.y + hits;
+  printf("\n");
+} //BenchKernels
+
+/// Time CDynamicCircle::PostCollide() for a collision with a shape of each
+/// motion type. Collision response changes the dynamic circle's position and
+/// velocity, so each one is put back before each collision response. The
+/// time taken to do only that is shown first for comparison.
+
+void BenchPostCollide(){
+  printf("PostCollide kernels\n");
+  printf("%10s %12s %12s\n", "motion", "ns/op", "Mops/s");
+
+  CDynamicCircleDesc d;
+  d.m_fRadius = 12.5f;
+  d.m_fElasticity = 0.9f;
+  d.m_vPos = Vector2(0.0f, 10.0f);
+  d.m_vVel = Vector2(50.0f, -100.0f);
+  CDynamicCircle circ0(d);
+
+  d.m_vPos = Vector2(20.0f, 15.0f);
+  d.m_vVel = Vector2(-100.0f, 0.0f);
+  CDynamicCircle circ1(d);
+
+  CLineSegDesc lsDesc(Vector2(-48.0f, 0.0f), Vector2(48.0f, 0.0f));
+  CLineSeg lineseg(lsDesc);
+
+  CCircleDesc circDesc(Vector2(0.0f, -10.0f), 12.0f);
+  circDesc.m_eMotionType = eMotion::Kinematic;
+  CKinematicCircle kcirc(circDesc);
+  kcirc.SetRotCenter(Vector2(-40.0f, -10.0f));
+  kcirc.SetRotSpeed(4.0f);
+
+  CShape* shapes[] = {&lineseg, &kcirc, &circ1};
+  const char* name[] = {"Static", "Kinematic", "Dynamic"};
+  const unsigned steps = 10000000;
+
+  auto restore = [&](){ //put the dynamic circles back where they were
+    circ0.SetPos(Vector2(0.0f, 10.0f));
+    circ0.SetVel(Vector2(50.0f, -100.0f));
+    circ1.SetPos(Vector2(20.0f, 15.0f));
+    circ1.SetVel(Vector2(-100.0f, 0.0f));
+  }; //restore
+
+  const double t0 = CBench::Time(restore, steps);
+  printf("%10s %12.2f %12.1f\n", "(restore)", t0, 1000.0/t0);
+
+  for(int j=0; j<3; j++){
+    restore();
+    CContactDesc cd(shapes[j], &circ0);
+    if(!CShapeStore::PreCollide(shapes[j], cd))continue; //no contact to respond to
+
+    const double t = CBench::Time([&](){
+      restore();
+      circ0.PostCollide(cd);
+    }, steps);
+
+    printf("%10s %12.2f %12.1f\n", name[j], t, 1000.0/t);
+  } //for
+
+  printf("\n");
+} //BenchPostCollide
+
+/// Time RotatePt() with and without the sine and cosine supplied, and the
+/// Rotate() function of a kinematic shape of each type, over a range of angles.
+
+void BenchRotate(){
+  printf("Rotation\n");
+  printf("%16s %12s %12s\n", "function", "ns/op", "Mops/s");
+
+  const UINT n = 1024; //number of angles, a power of 2
+  std::vector<float> a(n), s(n), c(n); //angles and their sines and cosines
+
+  for(UINT i=0; i<n; i++){
+    a[i] = XM_2PI*i/n;
+    s[i] = sinf(a[i]);
+    c[i] = cosf(a[i]);
+  } //for
+
+  const Vector2 p(58.0f, 0.0f); //point to rotate
+  const Vector2 q(0.0f); //center of rotation
+  const unsigned steps = 10000000;
+  Vector2 sum; //so that the results are used
+  UINT i = 0; //index of next angle
+
+  double t = CBench::Time([&](){
+    sum += RotatePt(p, q, a[i++ & (n - 1)]);
+  }, steps);
+
+  printf("%16s %12.2f %12.1f\n", "RotatePt(a)", t, 1000.0/t);
+
+  t = CBench::Time([&](){
+    const UINT j = i++ & (n - 1);
+    sum += RotatePt(p, q, s[j], c[j]);
+  }, steps);
+
+  printf("%16s %12.2f %12.1f\n", "RotatePt(s, c)", t, 1000.0/t);
+
+  CPointDesc ptDesc(p);
+  CLineSegDesc lsDesc(Vector2(10.0f, 10.0f), Vector2(58.0f, 6.5f));
+  CCircleDesc circDesc(p, 6.5f);
+  CArcDesc arcDesc(p, 6.5f, 0.0f, XM_PI);
+  CPolygonDesc polyDesc(g_vPentagon, 5);
+  CCapsuleDesc capDesc(p, 10.0f, p + Vector2(58.0f, 0.0f), 6.5f);
+
+  CShape* shapes[] = {
+    new CKinematicPoint(ptDesc), new CKinematicLineSeg(lsDesc), 
+    new CKinematicCircle(circDesc), new CKinematicArc(arcDesc),
+    new CKinematicPolygonShape(polyDesc), new CKinematicCapsuleShape(capDesc)
+  }; //one of each type
+
+  for(int k=0; k<6; k++){
+    CShape* pShape = shapes[k];
+
+    t = CBench::Time([&](){
+      const UINT j = i++ & (n - 1);
+      pShape->Rotate(q, s[j], c[j]);
+      sum += pShape->GetPos();
+    }, steps);
+
+    printf("%16s %12.2f %12.1f\n", (std::string(CCollisionStats::GetShapeName(pShape->GetShapeType())) + "::Rotate").c_str(), t, 1000.0/t);
+    delete pShape;
+  } //for
+
+  g_fSink = sum.x + sum.y;
+  printf("\n");
+} //BenchRotate
+
+/// Time a substep of a pinball table with increasing numbers of dynamic
+/// circles, after letting them fall for a second so that they are spread
+/// out over the table. Narrow phase tests are counted from the candidate
+/// pairs that each substep tests.
+
+void BenchTable(){
+  printf("Pinball table substep\n");
+  printf("%8s %14s %14s %12s\n", "balls", "ns/substep", "tests/substep", "Mtests/s");
+
+  for(unsigned n: {1, 10, 100, 200}){
+    const unsigned steps = n < 100? 24000: 2400;
+    CTableScene scene(n);
+
+    for(int i=0; i<240; i++) //let them fall for a second
+      scene.Step();
+
+    size_t tests = 0; //narrow phase tests
+    const double t = CBench::Time([&](){tests += scene.Step();}, steps);
+    const double perstep = (double)tests/steps; //tests per substep
+
+    printf("%8u %14.0f %14.1f %12.1f\n", n, t, perstep, 1000.0*perstep/t);
+  } //for
+
+  printf("\n");
+} //BenchTable
+
+/// Settle a pile of dynamic circles in a bin, once responding to each contact
+/// immediately in a number of passes over the candidates, and once solving
+/// the contacts with the contact solver in the same number of iterations.
+/// After four seconds of settling, a further four seconds of substeps are
+/// timed, and then the deepest overlap and the root mean square speed show
+/// how well the pile has settled. Finally one substep is taken in both
+/// orders from the same state, and the largest distance between where a
+/// dynamic circle ends up each time shows how much the result depends on
+/// the order that the contacts are visited in.
+
+void BenchSolver(){
+  const UINT n = 60; //number of dynamic circles
+  const UINT steps = 960; //four seconds of substeps
+
+  printf("Contact solver, pile of %u balls\n", n);
+  printf("%10s %6s %12s %12s %12s %12s\n", "response", "iters", "ns/substep", "overlap px", "rms px/s", "order px");
+
+  for(bool bSolver: {false, true})
+    for(UINT k: {1, 2, 4, 8}){
+      CPileScene scene(n, k, bSolver);
+
+      for(UINT i=0; i<steps; i++)
+        scene.Step();
+
+      const double t = CBench::Time([&](){scene.Step();}, steps);
+      const float overlap = scene.GetOverlap();
+      const float speed = scene.GetSpeed();
+
+      printf("%10s %6u %12.0f %12.3f %12.2f %12.4f\n", bSolver? "solver": "immediate", k, t,
+        overlap, speed, scene.GetOrderDependence());
+    } //for
+
+  printf("\n");
+} //BenchSolver
+
+/// Time making a table's worth of shapes and then throwing them all away,
+/// once by making each with `new` and deleting each with `delete`, and
+/// once by making them in a shape store and clearing it. The shape store
+/// reuses its arena's memory from one reload to the next, so after the
+/// first reload it doesn't go back to the heap at all. That is all it saves,
+/// though, since constructing the shapes takes most of the time either way:
+/// the store is within 10% of constructing them into a preallocated buffer.
+/// On glibc it measures 1.2-1.5x faster than new/delete, but the gain depends
+/// on how fast the heap is, and it has measured as low as 0.95x at 1024
+/// shapes, so don't expect a speedup from it on a fast heap.
+
+void BenchReload(){
+  printf("Table reload\n");
+  printf("%8s %14s %14s %12s\n", "shapes", "new/delete ns", "store ns", "speedup");
+
+  for(unsigned n: {64, 256, 1024}){
+    CLineSegDesc lsDesc(Vector2(0.0f, 0.0f), Vector2(40.0f, 10.0f), 0.8f);
+    CCircleDesc circDesc(Vector2(100.0f, 100.0f), 20.0f, 1.0f);
+    CPointDesc ptDesc(Vector2(50.0f, 50.0f), 0.8f);
+    CShapeDesc* desc[] = {&lsDesc, &lsDesc, &circDesc, &ptDesc}; //mostly line segments, like the game
+    std::vector<CShape*> shapes(n);
+
+    const double t0 = CBench::Time([&](){
+      for(unsigned i=0; i<n; i++)
+        switch(desc[i%4]->m_eShapeType){
+          case eShape::LineSeg: shapes[i] = new CLineSeg(lsDesc); break;
+          case eShape::Circle:  shapes[i] = new CCircle(circDesc); break;
+          default:              shapes[i] = new CPoint(ptDesc); break;
+        } //switch
+
+      for(auto const& p: shapes)
+        delete p;
+    }, 2000);
+
+    CShapeStore store;
+
+    const double t1 = CBench::Time([&](){
+      for(unsigned i=0; i<n; i++)
+        store.Make(desc[i%4]);
+
+      store.Clear();
+    }, 2000);
+
+    printf("%8u %14.0f %14.0f %12.2f\n", n, t0, t1, t0/t1);
+  } //for
+
+  printf("\n");
+} //BenchReload
+
+/// Time removing a random object from a list of n objects and inserting a new
+/// one in its place, the way balls are lost and launched in multiball, once
+/// with a vector of pointers that is searched and erased from the middle, and
+/// once with a slot map. Each churn is followed by a pass over all of the
+/// objects, as the object manager makes every frame. The slot map's removal
+/// and insertion take about the same time whatever the number of objects,
+/// but the pass costs the same for both, and at a few hundred objects it
+/// takes most of the time, so the slot map is then only a little faster.
+
+void BenchSlotMap(){
+  printf("Object churn\n");
+  printf("%8s %14s %14s %12s\n", "objects", "vector ns", "slot map ns", "speedup");
+
+  /// \brief Stand-in for a game object.
+
+  class CThing{
+    public:
+      float m_fValue = 0.0f; ///< Something to update.
+  }; //CThing
+
+  for(unsigned n: {16, 256, 4096}){
+    std::mt19937 rng(1);
+    std::vector<CThing*> vec;
+    CSlotMap<CThing> map;
+    std::vector<CSlotHandle> handles;
+
+    for(unsigned i=0; i<n; i++){
+      vec.push_back(new CThing);
+      handles.push_back(map.Insert());
+    } //for
+
+    const double t0 = CBench::Time([&](){
+      CThing* p = vec[rng()%n]; //the one to remove
+
+      for(auto i=vec.begin(); i!=vec.end(); i++)
+        if(*i == p){
+          delete p;
+          vec.erase(i);
+          break;
+        } //if
+
+      vec.push_back(new CThing);
+
+      for(auto const& q: vec)
+        q->m_fValue += 1.0f;
+    }, 20000);
+
+    const double t1 = CBench::Time([&](){
+      const unsigned i = rng()%n; //the one to remove
+      map.Remove(handles[i]);
+      handles[i] = map.Insert();
+
+      for(auto& q: map)
+        q.m_fValue += 1.0f;
+    }, 20000);
+
+    for(auto const& p: vec)
+      delete p;
+
+    printf("%8u %14.0f %14.0f %12.2f\n", n, t0, t1, t0/t1);
+  } //for
+
+  printf("\n");
+} //BenchSlotMap
+
+/// Time loading the game's table, once from its source form by parsing it,
+/// making its shapes, and bucketing the static shapes into grid cells, and
+/// once from its compiled form by reading it, making its shapes, and building
+/// the grid from the baked index. This must be run from the directory that
+/// the game is run from, which is where the table files are.
+
+void BenchTableFile(){
+  printf("Table file load\n");
+
+  CTableDesc table;
+
+  if(!table.LoadText(TABLE_SOURCE)){
+    printf("%s not found, skipped\n\n", TABLE_SOURCE);
+    return;
+  } //if
+
+  table.Bake(TABLE_CELL_SIZE);
+
+  if(!table.SaveBinary(TABLE_COMPILED)){
+    printf("cannot write %s, skipped\n\n", TABLE_COMPILED);
+    return;
+  } //if
+
+  printf("%8s %14s %14s %12s\n", "shapes", "source ns", "compiled ns", "speedup");
+
+  CShapeStore store;
+  CGrid grid;
+  std::vector<CShape*> shapes;
+
+  const auto make = [&](){ //make the shapes that go in the grid
+    store.Clear();
+    shapes.clear();
+
+    for(UINT i=0; i<(UINT)table.m_stdShapes.size(); i++){
+      CShape* p = store.Get(store.Make(table.GetShapeDesc(i)));
+      if(table.IsGridShape(i))shapes.push_back(p);
+    } //for
+  }; //make
+
+  const double t0 = CBench::Time([&](){
+    table.LoadText(TABLE_SOURCE);
+    make();
+    grid.Build(shapes, TABLE_CELL_SIZE);
+  }, 2000);
+
+  const double t1 = CBench::Time([&](){
+    table.LoadBinary(TABLE_COMPILED);
+    make();
+    grid.Build(shapes, table.m_cGrid);
+  }, 2000);
+
+  printf("%8u %14.0f %14.0f %12.2f\n", (UINT)table.m_stdShapes.size(), t0, t1, t0/t1);
+  printf("\n");
+} //BenchTableFile
+
+/// Stress test the game table with many balls. The table is loaded from
+/// its data file, and each scenario queues a number of balls that are
+/// released onto it a row at a time, then runs a minute of frames of
+/// four substeps each, the way the game does at 60 frames per second.
+/// Balls drain out of the bottom as they would in the game. Each frame is
+/// timed separately, and the percentiles of the frame times are reported
+/// together with the peak number of balls on the table and the number lost.
+
+void BenchMultiball(){
+  printf("Multiball stress\n");
+
+  CTableDesc table;
+
+  if(!table.LoadText(TABLE_SOURCE)){
+    printf("%s not found, skipped\n\n", TABLE_SOURCE);
+    return;
+  } //if
+
+  table.Bake(TABLE_CELL_SIZE);
+
+  printf("%8s %10s %10s %10s %10s %8s %8s\n",
+    "balls", "p50 ms", "p90 ms", "p99 ms", "max ms", "peak", "lost");
+
+  const UINT frames = 3600; //one minute at 60 fps
+  std::vector<double> t(frames);
+
+  for(UINT n: {10, 100, 1000}){
+    CTableScene scene(table);
+    scene.Queue(n);
+    UINT peak = 0; //most balls on the table at once
+
+    for(UINT i=0; i<frames; i++){
+      const auto t0 = std::chrono::steady_clock::now();
+
+      for(int j=0; j<4; j++)
+        scene.Step();
+
+      const auto t1 = std::chrono::steady_clock::now();
+      t[i] = std::chrono::duration<double, std::milli>(t1 - t0).count();
+      peak = max(peak, scene.GetNumCircles());
+    } //for
+
+    std::sort(t.begin(), t.end());
+
+    const auto pct = [&](UINT p){return t[min(frames - 1, p*frames/100)];};
+
+    printf("%8u %10.3f %10.3f %10.3f %10.3f %8u %8u\n",
+      n, pct(50), pct(90), pct(99), t.back(), peak, scene.GetNumLost());
+  } //for
+
+  printf("\n");
+} //BenchMultiball
+
+/// Compare a bumper made of line segments and the points at their ends
+/// with the same bumper as a single polygon, for dynamic circles scattered
+/// around it so that some of them hit it. The line segment bumper takes a
+/// collision test per shape, and a circle near a corner can be hit by the
+/// corner's point and by one or both line segments, each with its own normal.
+/// The polygon takes one test and gives at most one contact. Double hits are
+/// circles that get more than one contact.
+
+void BenchBumper(){
+  printf("Bumper as line segments or polygon\n");
+  printf("%10s %10s %12s %10s %12s\n", "bumper", "tests", "ns/circle", "hit %", "double %");
+
+  const UINT n = 1024; //number of dynamic circles, a power of 2
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> pos(-56.0f, 56.0f);
+
+  CDynamicCircleDesc d;
+  d.m_fRadius = 12.5f;
+  std::vector<CDynamicCircle*> circles;
+
+  for(UINT i=0; i<n; i++){
+    circles.push_back(new CDynamicCircle(d));
+    circles.back()->SetPos(Vector2(pos(rng), pos(rng)));
+  } //for
+
+  CShapeStore store;
+  std::vector<CShape*> segments; //line segments and points
+  std::vector<CShape*> polygon; //just the polygon
+
+  for(UINT i=0; i<5; i++){
+    CLineSegDesc lsDesc(g_vPentagon[i], g_vPentagon[(i + 1)%5]);
+    segments.push_back(store.Get(store.Make(&lsDesc)));
+
+    CPointDesc ptDesc(g_vPentagon[i]);
+    segments.push_back(store.Get(store.Make(&ptDesc)));
+  } //for
+
+  CPolygonDesc polyDesc(g_vPentagon, 5);
+  polygon.push_back(store.Get(store.Make(&polyDesc)));
+
+  const unsigned steps = 2000000;
+
+  for(auto const& shapes: {segments, polygon}){
+    UINT i = 0; //index of next dynamic circle
+    UINT hits = 0; //number of circles hit
+    UINT doubles = 0; //number of circles hit more than once
+
+    const double t = CBench::Time([&](){
+      CDynamicCircle* pCirc = circles[i++ & (n - 1)];
+      UINT k = 0; //number of contacts
+
+      for(auto const& p: shapes){
+        CContactDesc cd(p, pCirc);
+        if(CShapeStore::PreCollide(p, cd))++k;
+      } //for
+
+      if(k > 0)++hits;
+      if(k > 1)++doubles;
+    }, steps);
+
+    printf("%10s %10u %12.2f %10.1f %12.2f\n", shapes.size() > 1? "segments": "polygon",
+      (UINT)shapes.size(), t, 100.0*hits/steps, 100.0*doubles/steps);
+  } //for
+
+  for(auto const& p: circles)
+    delete p;
+
+  printf("\n");
+} //BenchBumper
+
+/// Compare a curved wall made of line segments with a point at each joint
+/// with the same wall as a single chain, for dynamic circles scattered
+/// along the inside of it, touching or nearly touching it. The wall is the
+/// bottom of a bowl, so it bends towards the circles at every joint and no
+/// circle should ever touch a joint. Each line segment and point whose AABB
+/// overlaps a circle's AABB is tested, which is what a broad phase would give
+/// it, whereas the chain is tested once and walks its own AABB hierarchy.
+/// The candidates for each circle are found before timing starts.
+/// Joint hits are circles that get a contact at a joint, whose normal is
+/// tilted from the wall's and makes a sliding circle catch on the seam.
+
+void BenchChain(){
+  printf("Wall as line segments and points or chain\n");
+  printf("%10s %10s %12s %12s %10s\n", "wall", "tests", "ns/circle", "contacts", "joint %");
+
+  const UINT edges = 64; //number of edges in the wall
+  const float R = 400.0f; //radius of the bowl
+  const float r = 12.5f; //radius of the dynamic circles
+
+  std::vector<Vector2> v; //vertices, along the bottom quarter of a circle
+
+  for(UINT i=0; i<=edges; i++){
+    const float a = XM_PI*(1.25f + 0.5f*i/edges);
+    v.push_back(R*Vector2(cosf(a), sinf(a)));
+  } //for
+
+  CShapeStore store;
+  std::vector<CShape*> segments; //line segments and points
+  std::vector<CShape*> chain; //just the chain
+
+  for(UINT i=0; i<=edges; i++){
+    CPointDesc ptDesc(v[i]);
+    segments.push_back(store.Get(store.Make(&ptDesc)));
+
+    if(i < edges){
+      CLineSegDesc lsDesc(v[i], v[i + 1]);
+      segments.push_back(store.Get(store.Make(&lsDesc)));
+    } //if
+  } //for
+
+  CChainDesc chainDesc(v.data(), (UINT)v.size());
+  chain.push_back(store.Get(store.Make(&chainDesc)));
+
+  const UINT n = 1024; //number of dynamic circles, a power of 2
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> angle(XM_PI*1.3f, XM_PI*1.7f);
+  std::uniform_real_distribution<float> gap(-1.0f, 0.5f);
+
+  CDynamicCircleDesc d;
+  d.m_fRadius = r;
+  std::vector<CDynamicCircle*> circles;
+
+  for(UINT i=0; i<n; i++){
+    const float a = angle(rng);
+    circles.push_back(new CDynamicCircle(d));
+    circles.back()->SetPos((R - r - gap(rng))*Vector2(cosf(a), sinf(a)));
+  } //for
+
+  const unsigned steps = 1000000;
+  std::vector<CContactDesc> contacts;
+
+  for(auto const& shapes: {segments, chain}){
+    std::vector<std::vector<CShape*>> candidates(n); //shapes near each circle
+
+    for(UINT j=0; j<n; j++)
+      for(auto const& p: shapes)
+        if(p->GetAABB() && circles[j]->GetAABB())
+          candidates[j].push_back(p);
+
+    UINT i = 0; //index of next dynamic circle
+    UINT tests = 0; //number of shapes tested
+    UINT found = 0; //number of contacts
+    UINT joints = 0; //number of circles with a contact at a joint
+
+    const double t = CBench::Time([&](){
+      const UINT j = i++ & (n - 1);
+      CDynamicCircle* pCirc = circles[j];
+      contacts.clear();
+
+      for(auto const& p: candidates[j]){
+        CContactDesc cd(p, pCirc);
+        CShapeStore::PreCollide(p, cd, contacts);
+        ++tests;
+      } //for
+
+      bool bJoint = false; //whether there was a contact at a joint
+
+      for(auto const& c: contacts)
+        bJoint = bJoint || c.m_pShape->GetShapeType() == eShape::Point ||
+          (c.m_pShape->GetShapeType() == eShape::Chain && c.m_nFeature%2 == 1);
+
+      found += (UINT)contacts.size();
+      if(bJoint)++joints;
+    }, steps);
+
+    printf("%10s %10.2f %12.2f %12.2f %10.2f\n", shapes.size() > 1? "segments": "chain",
+      (double)tests/steps, t, (double)found/steps, 100.0*joints/steps);
+  } //for
+
+  for(auto const& p: circles)
+    delete p;
+
+  printf("\n");
+} //BenchChain
+
+/// Compare a flipper made of two circles and the two line segments tangent
+/// to both, which is how the game used to make its flippers, with the same
+/// flipper as a single capsule, for dynamic circles scattered around it so
+/// that some of them hit it. A circle near where a line segment meets a
+/// circle is hit by both of them, each with its own normal, whereas the
+/// capsule takes one test and gives at most one contact. Double hits are
+/// circles that get more than one contact. The error is the largest
+/// difference between the setback distance of the capsule's contact and
+/// that of the deepest of the four shapes' contacts, which should agree
+/// for any circle whose center is outside the flipper.
+
+void BenchCapsule(){
+  printf("Flipper as circles and line segments or capsule\n");
+  printf("%10s %10s %12s %10s %12s %12s\n", "flipper", "tests", "ns/circle", "hit %",
+    "double %", "max error");
+
+  const UINT n = 1024; //number of dynamic circles, a power of 2
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> x(-30.0f, 90.0f);
+  std::uniform_real_distribution<float> y(-30.0f, 30.0f);
+
+  CDynamicCircleDesc d;
+  d.m_fRadius = 12.5f;
+  std::vector<CDynamicCircle*> circles;
+
+  for(UINT i=0; i<n; i++){
+    circles.push_back(new CDynamicCircle(d));
+    circles.back()->SetPos(Vector2(x(rng), y(rng)));
+  } //for
+
+  CShapeStore store;
+  std::vector<CShape*> parts; //circles and line segments
+  std::vector<CShape*> capsule; //just the capsule
+
+  CCircleDesc circDesc(Vector2(0.0f), 10.0f);
+  CCircle* pCirc0 = (CCircle*)store.Get(store.Make(&circDesc));
+
+  circDesc.m_vPos = Vector2(58.0f, 0.0f);
+  circDesc.m_fRadius = 6.5f;
+  CCircle* pCirc1 = (CCircle*)store.Get(store.Make(&circDesc));
+
+  CLineSegDesc lsDesc0, lsDesc1;
+  pCirc1->Tangents(pCirc0, lsDesc0, lsDesc1);
+
+  for(CShape* q: {(CShape*)pCirc0, (CShape*)pCirc1, 
+    store.Get(store.Make(&lsDesc0)), store.Get(store.Make(&lsDesc1))})
+    parts.push_back(q);
+
+  CCapsuleDesc capDesc(Vector2(0.0f), 10.0f, Vector2(58.0f, 0.0f), 6.5f);
+  capsule.push_back(store.Get(store.Make(&capDesc)));
+
+  float err = 0.0f; //largest difference in setback distance
+
+  for(auto const& pCirc: circles){
+    float s = FLT_MAX; //smallest setback distance of the parts
+
+    for(auto const& p: parts){
+      CContactDesc cd(p, pCirc);
+      if(CShapeStore::PreCollide(p, cd))s = min(s, cd.m_fSetback);
+    } //for
+
+    CContactDesc cd(capsule[0], pCirc);
+    const bool bHit = CShapeStore::PreCollide(capsule[0], cd);
+
+    if(bHit != (s < FLT_MAX))err = FLT_MAX; //one hit and the other didn't
+    else if(bHit && cd.m_fSetback > -pCirc->GetRadius())err = max(err, fabsf(cd.m_fSetback - s));
+  } //for
+
+  const unsigned steps = 2000000;
+
+  for(auto const& shapes: {parts, capsule}){
+    UINT i = 0; //index of next dynamic circle
+    UINT hits = 0; //number of circles hit
+    UINT doubles = 0; //number of circles hit more than once
+
+    const double t = CBench::Time([&](){
+      CDynamicCircle* pCirc = circles[i++ & (n - 1)];
+      UINT k = 0; //number of contacts
+
+      for(auto const& p: shapes){
+        CContactDesc cd(p, pCirc);
+        if(CShapeStore::PreCollide(p, cd))++k;
+      } //for
+
+      if(k > 0)++hits;
+      if(k > 1)++doubles;
+    }, steps);
+
+    printf("%10s %10u %12.2f %10.1f %12.2f %12.2g\n", shapes.size() > 1? "parts": "capsule",
+      (UINT)shapes.size(), t, 100.0*hits/steps, 100.0*doubles/steps, err);
+  } //for
+
+  for(auto const& p: circles)
+    delete p;
+
+  printf("\n");
+} //BenchCapsule
+
+/// Run all of the benchmarks.
+/// \return 0.
+
+int main(){
+  BenchKernels();
+  BenchPreCollide();
+  BenchBumper();
+  BenchChain();
+  BenchCapsule();
+  BenchPostCollide();
+  BenchRotate();
+  BenchTable();
+  BenchSolver();
+  BenchReload();
+  BenchTableFile();
+  BenchMultiball();
+  BenchSlotMap();
+  BenchSweepAndPrune();
+  BenchLineSegBatch();
+  BenchTunnelling();
+  BenchFlipperTunnelling();
+  BenchScheduler();
+  BenchPairCache();
+  BenchFlippers();
+  return 0;
+} //main
@@ -0,0 +1,176 @@
+/// \file Pile.cpp
+/// \brief Code for the ball pile scene class CPileScene.
+
+#include <random>
+
+#include "Pile.h"
+#include "Contact.h"
+
+const float RADIUS = 12.5f; ///< Radius of dynamic circles, same as the ball sprite.
+const float BIN_WIDTH = 150.0f; ///< Width of bin, six dynamic circles across.
+const float BIN_HEIGHT = 600.0f; ///< Height of bin.
+const UINT ROW_SIZE = 5; ///< Number of dynamic circles in each row dropped in.
+
+/// Make the bin and drop n dynamic circles into it in rows, with a little
+/// randomness in their positions. The same seed always gives the same scene.
+/// \param n Number of dynamic circles.
+/// \param k Number of passes or solver iterations per substep.
+/// \param bSolver true to use the contact solver.
+/// \param seed Seed for pseudo-random number generator.
+
+CPileScene::CPileScene(UINT n, UINT k, bool bSolver, UINT seed):
+  m_nIterations(k), m_bSolver(bSolver)
+{
+  m_fGravity = -200.0f; //same as the game
+  m_fTimeStep = 1.0f/240.0f; //same as the game
+  m_cSolver.SetMinIterations(1); //exactly k iterations
+
+  const float w = BIN_WIDTH; //shorthand
+  const float h = BIN_HEIGHT; //shorthand
+
+  const Vector2 p[4] = {
+    Vector2(0.0f, h), Vector2(0.0f, 0.0f), Vector2(w, 0.0f), Vector2(w, h)
+  }; //corners
+
+  for(int i=0; i<3; i++){
+    CLineSegDesc lsDesc(p[i], p[i + 1], 0.8f);
+    Add(m_cStore.Get(m_cStore.Make(&lsDesc)));
+
+    CPointDesc ptDesc(p[i + 1], 0.8f);
+    Add(m_cStore.Get(m_cStore.Make(&ptDesc)));
+  } //for
+
+  m_cGrid.Build(m_stdStatic, 32.0f);
+
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> jitter(-2.0f, 2.0f);
+
+  const float dx = w/ROW_SIZE; //spacing
+
+  CDynamicCircleDesc d;
+  d.m_fRadius = RADIUS;
+  d.m_fElasticity = 0.9f;
+
+  for(UINT i=0; i<n; i++){
+    d.m_vPos = Vector2(dx*(0.5f + i%ROW_SIZE) + jitter(rng), 2.0f*RADIUS + dx*(i/ROW_SIZE));
+
+    CDynamicCircle* q = (CDynamicCircle*)m_cStore.Get(m_cStore.Make(&d));
+    q->SetPos(d.m_vPos);
+    Add(q);
+  } //for
+} //constructor
+
+/// Find the static shapes and the pairs of dynamic circles that are within
+/// a margin of colliding the way that the world does, and then put the
+/// pairs into the candidate cache too so that they can all be visited in
+/// either order.
+
+void CPileScene::FindCandidates(){
+  CWorld::FindCandidates();
+
+  for(auto const& pair: m_stdPairs)
+    m_stdCache.push_back(CShapePair(pair.second, pair.first));
+} //FindCandidates
+
+/// Take one substep: move the dynamic circles, find the candidates, and then
+/// either do the given number of passes over them responding to each contact
+/// immediately, or gather the contacts and solve them.
+
+void CPileScene::Step(){
+  for(auto const& pCirc: m_stdCircles)
+    pCirc->move();
+
+  FindCandidates();
+
+  const size_t n = m_stdCache.size(); //number of candidates
+
+  if(m_bSolver){
+    m_cSolver.Begin();
+
+    for(size_t i=0; i<n; i++){
+      const CShapePair& pair = m_stdCache[m_bReverse? n - 1 - i: i];
+      NarrowPhase(pair.first, pair.second); //near misses too
+    } //for
+
+    m_cSolver.Solve(m_nIterations);
+  } //if
+
+  else for(UINT k=0; k<m_nIterations; k++)
+    for(size_t i=0; i<n; i++){
+      const CShapePair& pair = m_stdCache[m_bReverse? n - 1 - i: i];
+      CContactDesc cd(pair.first, pair.second);
+
+      if(CShapeStore::PreCollide(pair.first, cd))
+        pair.second->PostCollide(cd);
+    } //for
+} //Step
+
+/// Find the deepest overlap between a dynamic circle and anything else,
+/// testing the candidates found by the latest substep.
+/// \return Deepest overlap in pixels.
+
+float CPileScene::GetOverlap(){
+  float d = 0.0f; //deepest overlap so far
+
+  for(auto const& pair: m_stdCache){
+    CContactDesc cd(pair.first, pair.second);
+
+    if(CShapeStore::PreCollide(pair.first, cd))
+      d = max(d, -cd.m_fSetback);
+  } //for
+
+  return d;
+} //GetOverlap
+
+/// Get the root mean square speed of the dynamic circles, which is zero
+/// once the pile has settled completely.
+/// \return Root mean square speed in pixels per second.
+
+float CPileScene::GetSpeed(){
+  float sum = 0.0f; //sum of squared speeds
+
+  for(auto const& pCirc: m_stdCircles)
+    sum += pCirc->GetVel().LengthSquared();
+
+  return sqrtf(sum/m_stdCircles.size());
+} //GetSpeed
+
+/// Take a substep, then put everything back the way it was and take it
+/// again visiting the candidates in reverse order. The scene is left as the
+/// second substep left it.
+/// \return Largest distance between where a dynamic circle ended up the first
+///   time and the second time, in pixels.
+
+float CPileScene::GetOrderDependence(){
+  std::vector<Vector2> pos, vel; //positions and velocities before the substep
+
+  for(auto const& pCirc: m_stdCircles){
+    pos.push_back(pCirc->GetPos());
+    vel.push_back(pCirc->GetVel());
+  } //for
+
+  const CContactSolver solver(m_cSolver); //keeps the warm start impulses
+  Step();
+
+  std::vector<Vector2> first; //positions after the first substep
+
+  for(auto const& pCirc: m_stdCircles)
+    first.push_back(pCirc->GetPos());
+
+  for(size_t i=0; i<m_stdCircles.size(); i++){
+    m_stdCircles[i]->SetPos(pos[i]);
+    m_stdCircles[i]->SetVel(vel[i]);
+  } //for
+
+  m_cSolver = solver;
+  m_bReverse = !m_bReverse;
+  Step();
+  m_bReverse = !m_bReverse;
+
+  float d = 0.0f; //largest squared distance so far
+
+  for(size_t i=0; i<m_stdCircles.size(); i++)
+    d = max(d, (m_stdCircles[i]->GetPos() - first[i]).LengthSquared());
+
+  return sqrtf(d);
+} //GetOrderDependence
@@ -0,0 +1,52 @@
+/// \file Pile.h
+/// \brief Interface for the ball pile scene class CPileScene.
+
+#ifndef __L4RC_BENCHMARK_PILE_H__
+#define __L4RC_BENCHMARK_PILE_H__
+
+#include <vector>
+
+#include "World.h"
+#include "ShapeStore.h"
+
+/// \brief Ball pile scene.
+///
+/// A headless scene for measuring how well a pile of dynamic circles settles,
+/// consisting of a narrow bin made of line segments and points with dynamic
+/// circles dropped into it until they are stacked several deep. Every dynamic
+/// circle in the pile touches several shapes at once, which is the hard case
+/// for collision response. Contacts are either responded to immediately, one
+/// at a time, in a number of passes over the candidates, which is what the
+/// game used to do, or gathered and resolved by the contact solver with a
+/// number of iterations. Either way a substep can be taken twice from the
+/// same state, once visiting the candidates in reverse order, to see how much
+/// the result depends on the order. Dynamic circles never fall asleep, so
+/// that what is measured is collision response alone. The candidates are
+/// found by the world, and in the contact solver case the contacts are found
+/// by its narrow phase too, so that only collision response differs from
+/// the game.
+
+class CPileScene:
+  public CShapeCommon,
+  public CWorld
+{
+  private:
+    CShapeStore m_cStore; ///< Shape store, owns all shapes.
+
+    UINT m_nIterations = 1; ///< Number of passes or solver iterations per substep.
+    bool m_bSolver = false; ///< Whether to use the contact solver.
+    bool m_bReverse = false; ///< Whether to visit the candidates in reverse order.
+
+    void FindCandidates(); ///< Find candidate pairs.
+
+  public:
+    CPileScene(UINT, UINT, bool, UINT =1); ///< Constructor.
+
+    void Step(); ///< Take one substep.
+
+    float GetOverlap(); ///< Get deepest overlap.
+    float GetSpeed(); ///< Get root mean square speed.
+    float GetOrderDependence(); ///< Compare substeps in opposite orders.
+}; //CPileScene
+
+#endif //__L4RC_BENCHMARK_PILE_H__
@@ -0,0 +1,124 @@
+/// \file Reference.cpp
+/// \brief Code for the reference kernels, the old forms of the collision kernels.
+
+#include "Reference.h"
+
+/////////////////////////////////////////////////////////////////////////////
+// CRefLine functions
+
+/// Given a point and a gradient, construct the unique line
+/// through that point with that gradient.
+/// \param p Point.
+/// \param m Gradient.
+
+CRefLine::CRefLine(const Vector2& p, float m): 
+  m_fGradient(m), m_fInverseGradient(1.0f/m), 
+  m_fYIntercept(p.y - m*p.x), m_fXIntercept(p.x - p.y/m){
+} //constructor
+
+/// Construct the line through two points the way that CLineSeg used to,
+/// from the gradient of the line segment between them.
+/// \param p0 Leftmost point.
+/// \param p1 Other point.
+
+CRefLine::CRefLine(const Vector2& p0, const Vector2& p1){
+  const Vector2 dp = p0 - p1;
+  m_fGradient = dp.y/dp.x;
+  m_fInverseGradient = 1.0f/m_fGradient;
+  m_fYIntercept = p0.y - m_fGradient*p0.x;
+  m_fXIntercept = p0.x;
+} //constructor
+
+/// Find the point on both lines, taking care with vertical lines, which
+/// have infinite gradient.
+/// \param Line A line to intersect with.
+/// \return Point of intersection of this line with that one, if there is one.
+
+Vector2 CRefLine::Intersect(const CRefLine& Line) const{
+  const float m0 = m_fGradient;
+  const float c0 = m_fYIntercept;
+  const float d0 = m_fXIntercept;
+
+  const float m1 = Line.m_fGradient;
+  const float c1 = Line.m_fYIntercept;
+  const float d1 = Line.m_fXIntercept;
+
+  if(m0 == m1) //parallel lines meet at infinity
+    return Vector2(INFINITY, INFINITY);
+
+  else if(isfinite(m0) && isfinite(m1)){ //neither line vertical
+    const float px = (c1 - c0)/(m0 - m1);
+    return Vector2(px, m0*px + c0);
+  } //else if
+
+  else if(isinf(m0) && isfinite(m1)) //only this line is vertical
+    return Vector2(d0, m1*d0 + c1);
+
+  else //only the other line is vertical
+    return Vector2(d1, m0*d1 + c0);
+} //Intersect
+
+/// Find the closest point on this line by intersecting it with the
+/// line through p perpendicular to it.
+/// \param p A point.
+/// \return The point on this line that is closest to it.
+
+Vector2 CRefLine::ClosestPt(const Vector2& p) const{
+  return Intersect(CRefLine(p, -m_fInverseGradient));  
+} //ClosestPt
+
+/////////////////////////////////////////////////////////////////////////////
+// Reference functions
+
+/// Normalize an angle to [0, 2PI) by dividing by 2PI.
+/// \param a Angle in radians.
+/// \return Normalized angle.
+
+float RefNormalizeAngle(float a){
+  a -= floorf(a/XM_2PI)*XM_2PI;
+  return (a < 0.0f)? a + XM_2PI: a;
+} //RefNormalizeAngle
+
+/// Test whether a point is in the sector of an arc by finding the angle
+/// from the arc's center to the point.
+/// \param c Center of arc.
+/// \param a0 First angle of arc, normalized.
+/// \param a1 Second angle of arc, normalized.
+/// \param p A point.
+/// \return true if p is inside the sector.
+
+bool RefPtInSector(const Vector2& c, float a0, float a1, const Vector2& p){
+  const Vector2 v = p - c;
+  const float a = RefNormalizeAngle(atan2f(v.y, v.x));
+
+  if(a0 < a1)
+    return a >= a0 && a <= a1;
+  else return a >= a0 || a <= a1;
+} //RefPtInSector
+
+/// Find the points where the tangents to a circle through a point touch
+/// it by finding the angles of the tangents.
+/// \param c Center of circle.
+/// \param r Radius of circle.
+/// \param p Point that must lie on the tangents.
+/// \param p0 [out] Intersection point with counterclockwise tangent.
+/// \param p1 [out] Intersection point with clockwise tangent.
+/// \return true if the tangents exist.
+
+bool RefTangents(const Vector2& c, float r, const Vector2& p, Vector2& p0, Vector2& p1){
+  const Vector2 v = c - p;
+  const float d = v.Length();
+  FailIf(d <= r);
+
+  const float delta = sqrtf(d*d - r*r);
+  const float phi = atan2f(v.y, v.x);
+  const float theta = asinf(r/d);
+
+  const float ccw = phi + theta;
+  const float cw = phi - theta;
+
+  p0 = p + delta*Vector2(cosf(ccw), sinf(ccw));
+  p1 = p + delta*Vector2(cosf(cw), sinf(cw));
+
+  return true;
+} //RefTangents
@@ -0,0 +1,36 @@
+/// \file Reference.h
+/// \brief Interface for the reference kernels, the old forms of the collision kernels.
+
+#ifndef __L4RC_BENCHMARK_REFERENCE_H__
+#define __L4RC_BENCHMARK_REFERENCE_H__
+
+#include "ShapeMath.h"
+
+/// \brief Reference line.
+///
+/// A line in slope-intercept form, the way that CLine used to store it,
+/// with the gradient, its inverse, and both intercepts worked out in
+/// advance. This is only here so that the benchmarks can compare the
+/// old way of finding the closest point on a line with the new one.
+
+class CRefLine{
+  private:
+    float m_fGradient = 0.0f; ///< Gradient.
+    float m_fInverseGradient = 0.0f; ///< Inverse gradient.
+    float m_fYIntercept = 0.0f; ///< Intercept with Y axis.
+    float m_fXIntercept = 0.0f; ///< Intercept with X axis.
+
+    Vector2 Intersect(const CRefLine&) const; ///< Get intersection point with line.
+
+  public:
+    CRefLine(const Vector2&, float); ///< Constructor.
+    CRefLine(const Vector2&, const Vector2&); ///< Constructor.
+
+    Vector2 ClosestPt(const Vector2&) const; ///< Get closest point on line.
+}; //CRefLine
+
+float RefNormalizeAngle(float); ///< Normalize angle using division.
+bool RefPtInSector(const Vector2&, float, float, const Vector2&); ///< Point in sector test using atan2.
+bool RefTangents(const Vector2&, float, const Vector2&, Vector2&, Vector2&); ///< Tangents using trig.
+
+#endif //__L4RC_BENCHMARK_REFERENCE_H__
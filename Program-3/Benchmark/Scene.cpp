@@ -0,0 +1,194 @@
+/// \file Scene.cpp
+/// \brief Code for the benchmark scene class CScene.
+
+#include <random>
+
+#include "Scene.h"
+#include "Contact.h"
+
+const float RADIUS = 12.5f; ///< Radius of dynamic circles, same as the ball sprite.
+const float SPACING = 48.0f; ///< Average distance between dynamic circles.
+
+/// Make a box with n dynamic circles in random positions with random
+/// velocities. The same seed always gives the same scene.
+/// \param n Number of dynamic circles.
+/// \param seed Seed for pseudo-random number generator.
+
+CScene::CScene(unsigned n, unsigned seed){
+  m_fGravity = 0.0f; //keep the density constant
+  m_fTimeStep = 1.0f/240.0f; //same as the game
+
+  const float s = SPACING*ceilf(sqrtf((float)n)) + 4.0f*RADIUS; //side of box
+
+  const Vector2 p0(0.0f, 0.0f);
+  const Vector2 p1(s, 0.0f);
+  const Vector2 p2(s, s);
+  const Vector2 p3(0.0f, s);
+
+  CLineSegDesc lsDesc(p0, p1, 1.0f);
+  m_stdStatic.push_back(m_cStore.Get(m_cStore.Make(&lsDesc)));
+  lsDesc.SetEndPts(p1, p2);
+  m_stdStatic.push_back(m_cStore.Get(m_cStore.Make(&lsDesc)));
+  lsDesc.SetEndPts(p2, p3);
+  m_stdStatic.push_back(m_cStore.Get(m_cStore.Make(&lsDesc)));
+  lsDesc.SetEndPts(p3, p0);
+  m_stdStatic.push_back(m_cStore.Get(m_cStore.Make(&lsDesc)));
+
+  m_cGrid.Build(m_stdStatic, 32.0f);
+
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> pos(2.0f*RADIUS, s - 2.0f*RADIUS);
+  std::uniform_real_distribution<float> vel(-400.0f, 400.0f);
+
+  CDynamicCircleDesc d;
+  d.m_fRadius = RADIUS;
+  d.m_fElasticity = 0.9f;
+
+  for(unsigned i=0; i<n; i++){
+    d.m_vPos = Vector2(pos(rng), pos(rng));
+    d.m_vVel = Vector2(vel(rng), vel(rng));
+
+    CDynamicCircle* p = (CDynamicCircle*)m_cStore.Get(m_cStore.Make(&d));
+    p->SetPos(d.m_vPos);
+    m_stdCircles.push_back(p);
+    m_cSweep.Insert(p);
+  } //for
+} //constructor
+
+/// Check whether a pair of shapes collides and make appropriate response.
+/// \param pShape Pointer to a shape.
+/// \param pCirc Pointer to a dynamic circle.
+/// \return true if there was a collision.
+
+bool CScene::NarrowPhase(CShape* pShape, CDynamicCircle* pCirc){
+  CContactDesc cd(pShape, pCirc);
+  FailIf(!CShapeStore::PreCollide(pShape, cd));
+  pCirc->PostCollide(cd);
+  return true;
+} //NarrowPhase
+
+/// Collide a dynamic circle with the walls of the box.
+/// \param pCirc Pointer to a dynamic circle.
+
+void CScene::CollideStatic(CDynamicCircle* pCirc){
+  m_cGrid.Collide(pCirc, m_stdContacts);
+
+  for(size_t j=0; j<m_stdContacts.size(); j++)
+    if(j == 0) //pCirc hasn't moved, so contact is still good
+      pCirc->PostCollide(m_stdContacts[j]);
+    else NarrowPhase(m_stdContacts[j].m_pShape, pCirc); //test again
+} //CollideStatic
+
+/// Move the dynamic circles and collide them with the walls of the box.
+
+void CScene::MoveAndCollideStatic(){
+  for(auto const& pCirc: m_stdCircles){
+    pCirc->move();
+    CollideStatic(pCirc);
+  } //for
+} //MoveAndCollideStatic
+
+/// Find the walls and pairs of dynamic circles that are within
+/// a margin of colliding, the way that CObjectManager::FindCandidates() does.
+/// \param margin How close they must be.
+
+void CScene::FindCandidates(float margin){
+  m_stdCache.clear();
+
+  for(auto const& pCirc: m_stdCircles){
+    m_stdCandidates.clear();
+    m_cGrid.NearLineSegs(pCirc, margin, m_stdCandidates);
+
+    for(auto const& pShape: m_stdCandidates)
+      m_stdCache.push_back(CShapePair(pShape, pCirc));
+  } //for
+
+  m_cSweep.Update();
+  m_cSweep.GetPairs(m_stdPairs, margin);
+} //FindCandidates
+
+/// Take one step, testing every pair of dynamic circles the way that
+/// CObjectManager::BroadPhase() used to.
+
+void CScene::StepBruteForce(){
+  MoveAndCollideStatic();
+
+  for(auto i=m_stdCircles.begin(); i!=m_stdCircles.end(); i++)
+    for(auto j=next(i); j!=m_stdCircles.end(); j++)
+      NarrowPhase(*j, *i);
+} //StepBruteForce
+
+/// Take one step, testing only the pairs of dynamic circles found
+/// by sweep and prune.
+
+void CScene::StepSweep(){
+  MoveAndCollideStatic();
+
+  m_cSweep.Update();
+  m_cSweep.GetPairs(m_stdPairs);
+
+  for(auto const& pair: m_stdPairs)
+    NarrowPhase(pair.second, pair.first);
+} //StepSweep
+
+/// Step through one 60Hz frame, using sweep and prune, in as many substeps
+/// as the substep scheduler asks for. Since the box has no small features,
+/// each dynamic circle's own radius is the feature size.
+/// \param s A substep scheduler.
+/// \return Number of substeps taken.
+
+UINT CScene::StepFrame(CSubstepScheduler& s){
+  s.Begin();
+
+  for(auto const& pCirc: m_stdCircles)
+    s.Add(pCirc->GetVel().Length(), pCirc->GetRadius());
+
+  s.End();
+  m_fTimeStep = 1.0f/(60.0f*s.GetSubsteps());
+
+  for(UINT i=0; i<s.GetSubsteps(); i++)
+    StepSweep();
+
+  return s.GetSubsteps();
+} //StepFrame
+
+/// Take one step with a number of collision passes after moving. Without the
+/// cache, each pass finds the walls and pairs of dynamic circles that collide
+/// from scratch. With the cache, the first pass finds the ones that are within
+/// a small margin of colliding, and all passes test only those.
+/// \param passes Number of collision passes.
+/// \param bCache true to use the cache.
+
+void CScene::StepPasses(UINT passes, bool bCache){
+  for(auto const& pCirc: m_stdCircles)
+    pCirc->move();
+
+  for(UINT i=0; i<passes; i++){
+    if(!bCache){
+      for(auto const& pCirc: m_stdCircles)
+        CollideStatic(pCirc);
+
+      m_cSweep.Update();
+      m_cSweep.GetPairs(m_stdPairs);
+    } //if
+
+    else{
+      if(i == 0)FindCandidates(2.0f);
+
+      for(auto const& pair: m_stdCache)
+        NarrowPhase(pair.first, pair.second);
+    } //else
+
+    for(auto const& pair: m_stdPairs)
+      NarrowPhase(pair.second, pair.first);
+  } //for
+} //StepPasses
+
+/// Get the number of pairs of dynamic circles whose AABBs overlap.
+/// \return Number of overlapping pairs.
+
+size_t CScene::GetPairCount(){
+  m_cSweep.Update();
+  m_cSweep.GetPairs(m_stdPairs);
+  return m_stdPairs.size();
+} //GetPairCount
@@ -0,0 +1,51 @@
+/// \file Scene.h
+/// \brief Interface for the benchmark scene class CScene.
+
+#ifndef __L4RC_BENCHMARK_SCENE_H__
+#define __L4RC_BENCHMARK_SCENE_H__
+
+#include <vector>
+
+#include "Grid.h"
+#include "SweepAndPrune.h"
+#include "ShapeStore.h"
+#include "SubstepScheduler.h"
+
+/// \brief Benchmark scene.
+///
+/// A headless scene for benchmarking, consisting of a box made of line
+/// segments with some dynamic circles bouncing around inside it. The box
+/// grows with the number of dynamic circles so that the number of
+/// collisions per circle stays roughly the same.
+
+class CScene: public CShapeCommon{
+  private:
+    CShapeStore m_cStore; ///< Shape store, owns all shapes.
+    std::vector<CShape*> m_stdStatic; ///< Static shapes.
+    std::vector<CDynamicCircle*> m_stdCircles; ///< Dynamic circles.
+
+    CGrid m_cGrid; ///< Uniform grid of static shapes.
+    CSweepAndPrune m_cSweep; ///< Sweep and prune for dynamic circles.
+
+    std::vector<CContactDesc> m_stdContacts; ///< Contacts found by the latest grid collision test.
+    std::vector<CCirclePair> m_stdPairs; ///< Pairs found by sweep and prune.
+    std::vector<CShape*> m_stdCandidates; ///< Shapes found by the latest grid query.
+    std::vector<CShapePair> m_stdCache; ///< Candidate pairs found by the first pass.
+
+    bool NarrowPhase(CShape*, CDynamicCircle*); ///< Narrow phase.
+    void CollideStatic(CDynamicCircle*); ///< Collide a circle with box.
+    void MoveAndCollideStatic(); ///< Move circles and collide with box.
+    void FindCandidates(float); ///< Find candidate pairs.
+
+  public:
+    CScene(unsigned, unsigned =1); ///< Constructor.
+
+    void StepBruteForce(); ///< Step with all pairs tested.
+    void StepSweep(); ///< Step with sweep and prune.
+    UINT StepFrame(CSubstepScheduler&); ///< Step through a frame in substeps.
+    void StepPasses(UINT, bool); ///< Step with repeated collision passes.
+    
+    size_t GetPairCount(); ///< Get number of overlapping pairs.
+}; //CScene
+
+#endif //__L4RC_BENCHMARK_SCENE_H__
@@ -0,0 +1,267 @@
+/// \file Table.cpp
+/// \brief Code for the pinball table scene class CTableScene.
+
+#include <random>
+
+#include "Table.h"
+
+const float WIDTH = 430.0f; ///< Width of table, same as the game window.
+const float HEIGHT = 860.0f; ///< Height of table, same as the game window.
+const float RADIUS = 12.5f; ///< Radius of dynamic circles, same as the ball sprite.
+const float FLIPPER_GAP = 90.0f; ///< Half distance between flipper centers of rotation.
+const float FLIPPER_Y = 90.0f; ///< Height of flipper centers of rotation.
+const float ROTSPEED = 4.0f; ///< Flipper rotational speed in revs per second.
+const UINT FLIP_PERIOD = 64; ///< Number of substeps from one flip to the next.
+const UINT FLIP_TIME = 8; ///< Number of substeps that a flip takes each way.
+const float CELL_SIZE = 32.0f; ///< Grid cell size, same as the game.
+const UINT SOLVER_ITERATIONS = 8; ///< Contact solver iterations, the most that the game does.
+const UINT RELEASE_PERIOD = 4; ///< Number of substeps between releases of queued balls.
+const float RELEASE_Y = 740.0f; ///< Height at which queued balls are released, under the game table's rounded top.
+const float RELEASE_X0 = 95.0f; ///< Leftmost release point.
+const float RELEASE_X1 = 335.0f; ///< Rightmost release point.
+const float RELEASE_DX = 30.0f; ///< Distance between release points.
+
+/// Make the table and drop n dynamic circles onto it in rows from near
+/// the top, with a little randomness in their positions and velocities.
+/// The same seed always gives the same scene.
+/// \param n Number of dynamic circles.
+/// \param seed Seed for pseudo-random number generator.
+
+CTableScene::CTableScene(unsigned n, unsigned seed){
+  m_fGravity = -200.0f; //same as the game
+  m_fTimeStep = 1.0f/240.0f; //same as the game
+
+  const float w = WIDTH; //shorthand
+  const float h = HEIGHT; //shorthand
+  const float mid = w/2.0f; //middle of table
+  const float top = h - mid; //center of rounded top
+
+  const Vector2 vLeft(mid - FLIPPER_GAP, FLIPPER_Y); //left flipper
+  const Vector2 vRight(mid + FLIPPER_GAP, FLIPPER_Y); //right flipper
+  const Vector2 vSlant(0.0f, 2.0f*FLIPPER_Y); //height of outer end of slants
+
+  //walls, slants, and floor
+
+  const Vector2 p[][2] = {
+    {Vector2(0.0f, 0.0f), Vector2(0.0f, top)}, {Vector2(w, top), Vector2(w, 0.0f)},
+    {vSlant, vLeft}, {vRight, Vector2(w, vSlant.y)}, 
+    {Vector2(w, 0.0f), Vector2(0.0f, 0.0f)}
+  }; //end points
+
+  for(auto const& q: p){
+    CLineSegDesc lsDesc(q[0], q[1], 0.8f);
+    AddStatic(&lsDesc);
+  } //for
+
+  CPointDesc ptDesc(vSlant, 0.8f);
+  AddStatic(&ptDesc);
+  ptDesc.m_vPos = Vector2(w, vSlant.y);
+  AddStatic(&ptDesc);
+
+  //rounded top
+
+  CArcDesc arcDesc(Vector2(mid, top), mid, 0.0f, XM_PI, 0.8f);
+  AddStatic(&arcDesc);
+
+  //bumpers
+
+  for(int i=-1; i<=1; i++){
+    CCircleDesc circDesc(Vector2(mid + 90.0f*i, 0.55f*h - (i == 0? 0.0f: 40.0f)), 20.0f, 1.0f);
+    AddStatic(&circDesc);
+  } //for
+
+  m_cGrid.Build(m_stdStatic, CELL_SIZE);
+
+  //flippers
+
+  MakeFlipper(m_cFlipper[0], vLeft, 11.0f*XM_PI/6.0f);
+  MakeFlipper(m_cFlipper[1], vRight, 7.0f*XM_PI/6.0f);
+
+  //dynamic circles
+
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> jitter(-2.0f, 2.0f);
+  std::uniform_real_distribution<float> vel(-200.0f, 200.0f);
+
+  const float dx = 2.0f*RADIUS + 4.0f; //spacing
+  const UINT cols = (UINT)((w - 2.0f*RADIUS)/dx); //number per row
+
+  CDynamicCircleDesc d;
+  d.m_fRadius = RADIUS;
+  d.m_fElasticity = 0.9f;
+
+  for(unsigned i=0; i<n; i++){
+    d.m_vPos = Vector2(2.0f*RADIUS + dx*(i%cols) + jitter(rng), top - dx*(i/cols) + jitter(rng));
+    d.m_vVel = Vector2(vel(rng), vel(rng));
+    AddCircle(d);
+  } //for
+} //constructor
+
+/// Make the shapes for a table from a table descriptor, with no dynamic
+/// circles, no floor, and no gates. The static shapes are put into the
+/// grid using the table's grid index, which is baked first if need be.
+/// Balls that leave the table are lost.
+/// \param table Table descriptor.
+
+CTableScene::CTableScene(CTableDesc& table){
+  m_fGravity = -200.0f; //same as the game
+  m_fTimeStep = 1.0f/240.0f; //same as the game
+
+  if(!table.IsBaked())
+    table.Bake(CELL_SIZE);
+
+  for(UINT i=0; i<(UINT)table.m_stdShapes.size(); i++){
+    const CTableShape& s = table.m_stdShapes[i];
+    if(s.m_ePart == eTablePart::Gate)continue; //gates need the game's collision response
+    if(!table.CanMake(i))continue; //skipped by Bake() too
+
+    CShape* p = m_cStore.Get(m_cStore.Make(table.GetShapeDesc(i)));
+    p->SetCanCollide(s.m_bCanCollide);
+
+    if(s.m_eMotionType == eMotion::Static)
+      Add(p);
+
+    else if(s.m_ePart == eTablePart::Flipper && s.m_nPart < (UINT)table.m_stdFlippers.size()){
+      m_cFlipper[table.m_stdFlippers[s.m_nPart].m_bLeft? 0: 1].AddShape(p);
+      Add(p);
+    } //else if
+  } //for
+
+  for(auto const& f: table.m_stdFlippers){
+    CCompoundShape& flipper = m_cFlipper[f.m_bLeft? 0: 1];
+    flipper.SetRotCenter(f.m_vRotCenter);
+    flipper.SetOrientation(f.m_fOrientation);
+  } //for
+
+  for(auto& flipper: m_cFlipper)
+    Add(&flipper);
+
+  m_cGrid.Build(m_stdStatic, table.m_cGrid);
+  SetBounds(CAabb2D(Vector2(0.0f, HEIGHT), Vector2(WIDTH, 0.0f)));
+} //constructor
+
+/// Make a static shape and add it to the static shape list.
+/// \param sd Shape descriptor.
+
+void CTableScene::AddStatic(CShapeDesc* sd){
+  Add(m_cStore.Get(m_cStore.Make(sd)));
+} //AddStatic
+
+/// Make a dynamic circle and add it to the world. Its shape store handle
+/// goes into the handle slot map, and the slot map handle into its user
+/// handle, so that OnLost() can find it.
+/// \param d Dynamic circle descriptor.
+
+void CTableScene::AddCircle(const CDynamicCircleDesc& d){
+  CDynamicCircleDesc desc(d);
+  const CShapeHandle h = m_cStore.Make(&desc);
+  CDynamicCircle* p = (CDynamicCircle*)m_cStore.Get(h);
+
+  p->SetPos(d.m_vPos);
+  p->SetUser(m_cHandles.Insert(h));
+  Add(p);
+} //AddCircle
+
+/// Release queued balls, one at each release point that no ball is too
+/// close to, so that they fall onto the table a row at a time.
+
+void CTableScene::Release(){
+  CDynamicCircleDesc d;
+  d.m_fRadius = RADIUS;
+  d.m_fElasticity = 0.9f;
+
+  for(float x=RELEASE_X0; x<=RELEASE_X1 && m_nQueue > 0; x+=RELEASE_DX){
+    const Vector2 pos(x, RELEASE_Y);
+    bool bClear = true;
+
+    for(auto const& p: m_stdCircles)
+      if((p->GetPos() - pos).LengthSquared() < sqr(2.0f*RADIUS)){
+        bClear = false;
+        break;
+      } //if
+
+    if(bClear){
+      d.m_vPos = pos;
+      AddCircle(d);
+      --m_nQueue;
+    } //if
+  } //for
+} //Release
+
+/// Delete a dynamic circle that has left the table, which the world has
+/// already taken out of its dynamic circle list and sweep and prune, the
+/// way that CObjectManager::OnLost() deletes lost balls.
+/// \param pCirc Pointer to a dynamic circle.
+
+void CTableScene::OnLost(CDynamicCircle* pCirc){
+  m_cStore.Remove(*m_cHandles.Get(pCirc->GetUser())); //free its slot in the shape store
+  m_cHandles.Remove(pCirc->GetUser());
+  ++m_nLost;
+} //OnLost
+
+/// Make a flipper the same size as the flippers in the game's table,
+/// which is a single kinematic capsule.
+/// \param flipper [out] Compound shape for the flipper.
+/// \param p Position of center of rotation.
+/// \param a Initial orientation.
+
+void CTableScene::MakeFlipper(CCompoundShape& flipper, const Vector2& p, float a){
+  CCapsuleDesc capDesc(p, 10.0f, p + Vector2(58.0f, 0.0f), 6.5f, 0.1f);
+  capDesc.m_eMotionType = eMotion::Kinematic;
+  CShape* q = m_cStore.Get(m_cStore.Make(&capDesc));
+
+  flipper.AddShape(q);
+  Add(q);
+
+  flipper.SetRotCenter(p);
+  flipper.SetOrientation(a);
+  Add(&flipper);
+} //MakeFlipper
+
+/// Take one substep: release queued balls if it is time to, flip the
+/// flippers if it is time to, and then let the world take the substep.
+/// \return Number of narrow phase tests.
+
+UINT CTableScene::Step(){
+  if(m_nQueue > 0 && m_nSubstep%RELEASE_PERIOD == 0)
+    Release();
+
+  const UINT t = m_nSubstep++%FLIP_PERIOD; //time since last flip
+
+  if(t == 0 || t == FLIP_TIME || t == 2*FLIP_TIME){ //start or stop flipping
+    const float s = t == 0? ROTSPEED: t == FLIP_TIME? -ROTSPEED: 0.0f;
+    m_cFlipper[0].SetRotSpeed(s);
+    m_cFlipper[1].SetRotSpeed(-s);
+  } //if
+
+  Substep(SOLVER_ITERATIONS);
+  return (UINT)(m_stdCache.size() + m_stdPairs.size());
+} //Step
+
+/// Queue balls to be released onto the table.
+/// \param n Number of balls.
+
+void CTableScene::Queue(UINT n){
+  m_nQueue += n;
+} //Queue
+
+/// Reader function for the number of dynamic circles on the table.
+/// \return Number of dynamic circles.
+
+const UINT CTableScene::GetNumCircles() const{
+  return (UINT)m_stdCircles.size();
+} //GetNumCircles
+
+/// Reader function for the number of balls waiting to be released.
+/// \return Number of queued balls.
+
+const UINT CTableScene::GetNumQueued() const{
+  return m_nQueue;
+} //GetNumQueued
+
+/// Reader function for the number of balls that have left the table.
+/// \return Number of lost balls.
+
+const UINT CTableScene::GetNumLost() const{
+  return m_nLost;
+} //GetNumLost
@@ -0,0 +1,62 @@
+/// \file Table.h
+/// \brief Interface for the pinball table scene class CTableScene.
+
+#ifndef __L4RC_BENCHMARK_TABLE_H__
+#define __L4RC_BENCHMARK_TABLE_H__
+
+#include <vector>
+
+#include "World.h"
+#include "ShapeStore.h"
+#include "SlotMap.h"
+#include "TableDesc.h"
+
+/// \brief Pinball table scene.
+///
+/// A headless scene shaped like a pinball table, with walls, a rounded top,
+/// slanted line segments leading down to a pair of flippers, some bumpers,
+/// and a floor under the flippers so that no balls are lost. It has every
+/// shape type and motion type that the game has, and each substep is taken
+/// by the world's substep pipeline, the same one that CObjectManager::move()
+/// uses. The flippers flip up and down on a fixed schedule so that the scene
+/// never settles completely.
+///
+/// The scene can also be made from a table descriptor, such as the game's own
+/// table, in which case it starts empty. Balls are queued with Queue() and
+/// released a row at a time from near the top as space allows, and balls that
+/// leave the table are removed, so that the physics can be tried with any
+/// number of balls on the table that is actually played. Gates are left out,
+/// since they need the game's one-way collision response.
+
+class CTableScene:
+  public CShapeCommon,
+  public CWorld
+{
+  private:
+    CShapeStore m_cStore; ///< Shape store, owns all shapes.
+    CSlotMap<CShapeHandle> m_cHandles; ///< Shape store handles of dynamic circles, found from their user handles.
+    CCompoundShape m_cFlipper[2]; ///< Left and right flippers.
+
+    UINT m_nSubstep = 0; ///< Number of substeps taken.
+    UINT m_nQueue = 0; ///< Number of balls waiting to be released.
+    UINT m_nLost = 0; ///< Number of balls that have left the table.
+
+    void AddStatic(CShapeDesc*); ///< Add a static shape.
+    void AddCircle(const CDynamicCircleDesc&); ///< Add a dynamic circle.
+    void Release(); ///< Release queued balls.
+    void OnLost(CDynamicCircle*); ///< Delete a lost ball.
+    void MakeFlipper(CCompoundShape&, const Vector2&, float); ///< Make a flipper.
+
+  public:
+    CTableScene(unsigned, unsigned =1); ///< Constructor.
+    CTableScene(CTableDesc&); ///< Constructor.
+
+    UINT Step(); ///< Take one substep.
+    void Queue(UINT); ///< Queue balls for release.
+
+    const UINT GetNumCircles() const; ///< Get number of balls on the table.
+    const UINT GetNumQueued() const; ///< Get number of balls waiting.
+    const UINT GetNumLost() const; ///< Get number of balls lost.
+}; //CTableScene
+
+#endif //__L4RC_BENCHMARK_TABLE_H__
@@ -0,0 +1,112 @@
+/// \file Tunnel.cpp
+/// \brief Code for the tunnelling scene class CTunnelScene.
+
+#include <random>
+
+#include "Tunnel.h"
+#include "Contact.h"
+
+const float RADIUS = 12.5f; ///< Radius of dynamic circles, same as the ball sprite.
+const float BOX_SIZE = 256.0f; ///< Width and height of box.
+const float MIN_SPEED = 500.0f; ///< Minimum speed of dynamic circles.
+const float MAX_SPEED = 4000.0f; ///< Maximum speed, twice the launch speed in the game.
+
+/// Make a box with n dynamic circles in random positions moving in random
+/// directions at random speeds. The same seed always gives the same scene.
+/// \param n Number of dynamic circles.
+/// \param substeps Number of substeps per frame.
+/// \param bSwept true to sweep fast dynamic circles using time of impact.
+/// \param seed Seed for pseudo-random number generator.
+
+CTunnelScene::CTunnelScene(unsigned n, unsigned substeps, bool bSwept, unsigned seed):
+  m_fSize(BOX_SIZE), m_nSubsteps(substeps), m_bSwept(bSwept)
+{
+  const float s = m_fSize; //shorthand
+
+  const Vector2 p[4] = {
+    Vector2(0.0f, 0.0f), Vector2(s, 0.0f), Vector2(s, s), Vector2(0.0f, s)
+  }; //corners
+
+  for(int i=0; i<4; i++){
+    CLineSegDesc lsDesc(p[i], p[(i + 1)%4], 1.0f);
+    Add(m_cStore.Get(m_cStore.Make(&lsDesc)));
+
+    CPointDesc ptDesc(p[i], 1.0f);
+    Add(m_cStore.Get(m_cStore.Make(&ptDesc)));
+  } //for
+
+  m_cGrid.Build(m_stdStatic, 32.0f);
+
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> pos(2.0f*RADIUS, s - 2.0f*RADIUS);
+  std::uniform_real_distribution<float> speed(MIN_SPEED, MAX_SPEED);
+  std::uniform_real_distribution<float> angle(0.0f, XM_2PI);
+
+  CDynamicCircleDesc d;
+  d.m_fRadius = RADIUS;
+  d.m_fElasticity = 1.0f;
+
+  for(unsigned i=0; i<n; i++){
+    d.m_vPos = Vector2(pos(rng), pos(rng));
+    d.m_vVel = speed(rng)*AngleToVector(angle(rng));
+
+    CDynamicCircle* p = (CDynamicCircle*)m_cStore.Get(m_cStore.Make(&d));
+    p->SetPos(d.m_vPos);
+    Add(p);
+  } //for
+} //constructor
+
+/// Collide a dynamic circle with the walls of the box, responding to each
+/// contact at once.
+/// \param pCirc Pointer to a dynamic circle.
+
+void CTunnelScene::CollideWalls(CDynamicCircle* pCirc){
+  m_cGrid.Collide(pCirc, m_stdContacts);
+
+  for(size_t j=0; j<m_stdContacts.size(); j++){
+    CContactDesc& cd = m_stdContacts[j];
+
+    if(j == 0 || CShapeStore::PreCollide(cd.m_pShape, cd)) //test again after the first
+      pCirc->PostCollide(cd);
+  } //for
+
+  m_cGrid.Query(pCirc->GetAABB(), m_stdCandidates);
+
+  for(auto const& pShape: m_stdCandidates){
+    CContactDesc cd(pShape, pCirc);
+
+    if(CShapeStore::PreCollide(pShape, cd))
+      pCirc->PostCollide(cd);
+  } //for
+} //CollideWalls
+
+/// Step through one 60Hz frame, dividing it into substeps. There are no
+/// kinematic shapes, so the world's swept move sweeps only the fast
+/// dynamic circles through the walls.
+
+void CTunnelScene::StepFrame(){
+  m_fGravity = 0.0f; //keep the speeds constant
+  m_fTimeStep = 1.0f/(60.0f*m_nSubsteps);
+
+  for(unsigned j=0; j<m_nSubsteps; j++)
+    for(auto const& pCirc: m_stdCircles){
+      if(m_bSwept)SweptMove(pCirc);
+      else pCirc->move();
+
+      CollideWalls(pCirc);
+    } //for
+} //StepFrame
+
+/// Get the number of dynamic circles that have tunnelled out of the box.
+/// \return Number of dynamic circles whose centers are outside the box.
+
+unsigned CTunnelScene::GetEscapeCount(){
+  unsigned n = 0;
+
+  for(auto const& pCirc: m_stdCircles){
+    const Vector2& p = pCirc->GetPos();
+    if(p.x < 0.0f || p.y < 0.0f || p.x > m_fSize || p.y > m_fSize)++n;
+  } //for
+
+  return n;
+} //GetEscapeCount
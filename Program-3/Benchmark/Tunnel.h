@@ -0,0 +1,42 @@
+/// \file Tunnel.h
+/// \brief Interface for the tunnelling scene class CTunnelScene.
+
+#ifndef __L4RC_BENCHMARK_TUNNEL_H__
+#define __L4RC_BENCHMARK_TUNNEL_H__
+
+#include <vector>
+
+#include "World.h"
+#include "ShapeStore.h"
+
+/// \brief Tunnelling scene.
+///
+/// A headless scene for measuring tunnelling, consisting of a small box made
+/// of line segments and points with some very fast dynamic circles bouncing
+/// around inside it. Any dynamic circle that ends up outside the box has
+/// tunnelled through one of its walls. Each frame is divided into a number of
+/// substeps, and the dynamic circles are either moved discretely and then
+/// collided with the walls, or swept through the walls using the world's
+/// swept move. The dynamic circles are never tested against each other.
+
+class CTunnelScene:
+  public CShapeCommon,
+  public CWorld
+{
+  private:
+    CShapeStore m_cStore; ///< Shape store, owns all shapes.
+
+    float m_fSize = 0.0f; ///< Width and height of box.
+    unsigned m_nSubsteps = 1; ///< Number of substeps per frame.
+    bool m_bSwept = false; ///< Whether to sweep fast dynamic circles.
+
+    void CollideWalls(CDynamicCircle*); ///< Collide with walls.
+
+  public:
+    CTunnelScene(unsigned, unsigned, bool, unsigned =1); ///< Constructor.
+
+    void StepFrame(); ///< Step through one frame.
+    unsigned GetEscapeCount(); ///< Get number of dynamic circles outside box.
+}; //CTunnelScene
+
+#endif //__L4RC_BENCHMARK_TUNNEL_H__
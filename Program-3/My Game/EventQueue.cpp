@@ -0,0 +1,48 @@
+/// \file EventQueue.cpp
+/// \brief Code for the collision event queue class CEventQueue.
+
+#include "EventQueue.h"
+
+/// Reserve room for the events of a typical frame up front.
+
+CEventQueue::CEventQueue(){
+  m_stdEvents.reserve(256);
+} //constructor
+
+/// Add a collision event to the end of the queue.
+/// \param h Handle of the object that was hit.
+/// \param poi Point of impact.
+/// \param speed Speed of the dynamic circle that hit it.
+/// \return Position of the new event in the queue.
+
+UINT CEventQueue::Push(const CSlotHandle& h, const Vector2& poi, float speed){
+  m_stdEvents.push_back(CCollisionEvent());
+
+  CCollisionEvent& e = m_stdEvents.back();
+  e.m_cObject = h;
+  e.m_vPOI = poi;
+  e.m_fSpeed = speed;
+
+  return (UINT)m_stdEvents.size() - 1;
+} //Push
+
+/// Remove all collision events, keeping the memory for the next frame.
+
+void CEventQueue::Clear(){
+  m_stdEvents.clear();
+} //Clear
+
+/// Get a collision event by its position in the queue.
+/// \param i Position, 0 for the first event pushed.
+/// \return Reference to the event.
+
+CCollisionEvent& CEventQueue::operator[](UINT i){
+  return m_stdEvents[i];
+} //operator[]
+
+/// Reader function for the number of collision events.
+/// \return Number of events in the queue.
+
+const UINT CEventQueue::GetSize() const{
+  return (UINT)m_stdEvents.size();
+} //GetSize
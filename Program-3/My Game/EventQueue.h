@@ -0,0 +1,47 @@
+/// \file EventQueue.h
+/// \brief Interface for the collision event queue class CEventQueue.
+
+#ifndef __L4RC_GAME_EVENTQUEUE_H__
+#define __L4RC_GAME_EVENTQUEUE_H__
+
+#include <vector>
+
+#include "GameDefines.h"
+#include "SlotMap.h"
+
+/// \brief Collision event.
+///
+/// One collision that the physics found, recorded so that its sound, score,
+/// and lighting up can be taken care of after the physics is done.
+
+class CCollisionEvent{
+  public:
+    CSlotHandle m_cObject; ///< Handle of the object that was hit.
+    Vector2 m_vPOI; ///< Point of impact.
+    float m_fSpeed = 0.0f; ///< Speed of the dynamic circle that hit it.
+}; //CCollisionEvent
+
+/// \brief Collision event queue.
+///
+/// A queue of collision events that is filled during a frame and emptied
+/// once at the end of it. The object manager pushes at most one event per
+/// object per frame, so the queue never holds more events than there are
+/// objects, and since emptying it keeps its memory, pushing an event in the
+/// innermost collision loop allocates only until the queue has grown to
+/// the size of the busiest frame so far.
+
+class CEventQueue{
+  private:
+    std::vector<CCollisionEvent> m_stdEvents; ///< Events in the order pushed.
+
+  public:
+    CEventQueue(); ///< Constructor.
+
+    UINT Push(const CSlotHandle&, const Vector2&, float); ///< Add an event.
+    void Clear(); ///< Remove all events.
+
+    CCollisionEvent& operator[](UINT); ///< Get event.
+    const UINT GetSize() const; ///< Get number of events.
+}; //CEventQueue
+
+#endif //__L4RC_GAME_EVENTQUEUE_H__
@@ -1,213 +1,364 @@
-/// \file Game.cpp
-/// \brief Code for the game class CGame.
-
-#include "Game.h"
-
-#include "GameDefines.h"
-#include "Renderer.h"
-#include "ComponentIncludes.h"
-
-#include "shellapi.h"
-
-CGame::~CGame(){
-  delete m_pCurBallShape;
-  delete m_pRenderer;
-  delete m_pObjectManager;
-} //destructor
-
-/// Initialize the renderer, load the images for the background,
-/// and start the game.
-
-void CGame::Initialize(){
-  m_fGravity = -200.0f;
-  m_fFrequency = 60.0f*m_nMIterations;
-  m_fTimeStep = 1.0f/m_fFrequency;
-  m_eDrawMode = eDrawMode::Background; //default draw mode
-
-  m_pRenderer = new CRenderer;
-  m_pRenderer->SetBgColor(Colors::White);
-  m_pRenderer->Initialize(eSprite::Size); 
-  m_pRenderer->LoadImages(); //load images from xml file list
-  m_pRenderer->SetBgColor(Colors::White);
-  
-  m_pObjectManager = new CObjectManager; //set up object manager 
-  LoadSounds(); //load the sounds for this game
-  
-  m_cClipDesc0.m_nSpriteIndex = (UINT)eSprite::Clip;
-  m_cClipDesc0.m_vPos = Vector2(42.0f, 860.0f - 170.0f);
-  m_cClipDesc0.m_fRoll = -XM_PI/6.0f;
-
-  m_cClipDesc1.m_nSpriteIndex = (UINT)eSprite::Clip;
-  m_cClipDesc1.m_vPos = Vector2(388.0f, 860.0f - 170.0f);
-  m_cClipDesc1.m_fRoll = -5.0f*XM_PI/6.0f;
-  
-  const Vector2 dw(m_pRenderer->GetWidth(eSprite::LED) + 2.0f, 0.0f);
-  Vector2 pos(31.0f, 826.0f);
-
-  for(UINT i=0; i<NUMSCOREDIGITS; i++){
-    m_cScoreDesc[i].m_nSpriteIndex = (UINT)eSprite::LED;
-    m_cScoreDesc[i].m_vPos = pos;
-    pos += dw;
-  } //for
-
-  m_pTimer->SetFixedTimeStep();
-  m_pTimer->SetFrameTime(1/60.0f);
-
-  //now start the game
-  BeginGame();
-} //Initialize
-
-/// Initialize the audio player and load game sounds.
-
-void CGame::LoadSounds(){
-  m_pAudio->Initialize(eSound::Size);
-
-  m_pAudio->Load(eSound::Beep, "beep");
-  m_pAudio->Load(eSound::Blaster, "blaster");
-  m_pAudio->Load(eSound::Ballclick, "ballclick");
-  m_pAudio->Load(eSound::Launch, "launch");
-  m_pAudio->Load(eSound::Click, "click");
-  m_pAudio->Load(eSound::Tink, "tink");
-  m_pAudio->Load(eSound::Whiffle, "whiffle");
-  m_pAudio->Load(eSound::FlipUp, "flipup");
-  m_pAudio->Load(eSound::FlipDown, "flipdown");
-  m_pAudio->Load(eSound::LostBall, "lostball");
-  m_pAudio->Load(eSound::Load, "load"); 
-} //LoadSounds
-
-/// Release all of the DirectX12 objects by deleting the renderer.
-
-void CGame::Release(){
-  delete m_pRenderer;
-  m_pRenderer = nullptr; //for safety
-} //Release
-
-/// Create the edges of the world and some shapes.
-
-void CGame::BeginGame(){   
-  m_pObjectManager->MakeWorldEdges(); //make world edges
-  m_pObjectManager->MakeShapes(); //make shapes
-
-  m_nScore = 0;
-} //BeginGame
-
-/// If there is no ball, create one and place it in the chute ready for launch.
-/// Otherwise, assuming that this has been done and the ball is ready to launch,
-/// then apply a vertical impulse to it. Add a little bit of randomness to that
-/// impulse so that it behaves slightly differently each time.
-
-void CGame::Launch(){
-  static bool bReadyForLaunch = false;
-
-  const float r = m_pRenderer->GetWidth(eSprite::Ball)/2.0f;
-
-  if(m_bBallInPlay){ //ball in play, ready to be launched
-    const Vector2 pos = m_pCurBallShape->GetPos();
-
-    if(pos.x > m_nWinWidth - 2.0f*r && pos.y <= r + 1.0f){
-      const float speed = 1000.0f + 1000.0f*m_pRandom->randf(); 
-      m_pCurBallShape->SetVel(Vector2(0.0f, speed));
-      bReadyForLaunch = false;
-      const float volume = std::max(0.1f, speed/4500.0f);
-      m_pAudio->play(eSound::Launch, pos, volume); 
-    } //if
-  } //if
-
-  else{ //ball is not in play
-    const Vector2 pos = Vector2(m_nWinWidth - 1.5f*r, 48.0f);
-    CDynamicCircleDesc d; 
-
-    d.m_fElasticity = 0.9f;
-    d.m_vPos = pos;
-    d.m_fRadius = r;
-
-    const CObjDesc od(eSprite::Ball, eSprite::Ball, eSound::Ballclick);
-    delete m_pCurBallShape; //delete old ball
-    m_pCurBallShape = (CDynamicCircle*)m_pObjectManager->AddShape(&d, od);
-
-    bReadyForLaunch = true;
-    m_bBallInPlay = true;
-    m_pAudio->play(eSound::Load, pos); 
-  } //else
-} //Launch
-
-/// Poll the keyboard state and respond to the
-/// key presses that happened since the last frame.
-
-void CGame::KeyboardHandler(){
-  m_pKeyboard->GetState(); //get current keyboard state 
-  
-  if(m_pKeyboard->TriggerDown(VK_F1)) //help
-    ShellExecute(0, 0, "https://larc.unt.edu/code/physics/pinball/", 0, 0, SW_SHOW);
-
-  if(m_pKeyboard->TriggerDown(VK_F2)){ //change draw mode
-    m_eDrawMode = eDrawMode((UINT)m_eDrawMode + 1);
-    if(m_eDrawMode == eDrawMode::Size)m_eDrawMode = eDrawMode(0);
-  } //if
-  
-  if(m_pKeyboard->TriggerDown(VK_SPACE)) //load and launch a ball
-    Launch();
-  
-  if(m_pKeyboard->TriggerDown(VK_LSHIFT)) //left flipper up
-    m_pObjectManager->LeftFlip(true);
-
-  if(m_pKeyboard->TriggerUp(VK_LSHIFT)) //left flipper down
-    m_pObjectManager->LeftFlip(false);
-   
-  if(m_pKeyboard->TriggerDown(VK_RSHIFT)) //right flipper up
-    m_pObjectManager->RightFlip(true);
-  
-  if(m_pKeyboard->TriggerUp(VK_RSHIFT)) //right flipper down
-    m_pObjectManager->RightFlip(false);
-} //KeyboardHandler
-
-/// Ask object manager to draw the game objects. RenderWorld
-/// is notified of the start and end of the frame so
-/// that it can let Direct3D do its pipelining jiggery-pokery.
-/// In addition, draw score and the CLIP_SPRITEs for the gates on top of
-/// everything else.
-
-void CGame::RenderFrame(){ 
-  m_pRenderer->BeginFrame();
-    if(m_eDrawMode == eDrawMode::Background || m_eDrawMode == eDrawMode::Both){ //draw sprites
-      m_pRenderer->Draw(eSprite::Background, m_vWinCenter); //draw background
-
-      //draw score
-      int n = m_nScore; //current score
-
-      for(int i=NUMSCOREDIGITS-1; i>=0; i--){
-        m_cScoreDesc[i].m_nCurrentFrame = n%10; //get least significant digit
-        m_pRenderer->Draw(&m_cScoreDesc[i]); //draw it
-        n /= 10; //right shift one digit
-      } //for
-
-      m_pObjectManager->draw(); //draw objects
-    } //if
-
-    if(m_eDrawMode == eDrawMode::Background){ //draw clips over everything    
-      m_pRenderer->Draw(&m_cClipDesc0);
-      m_pRenderer->Draw(&m_cClipDesc1);
-    } //if
-  
-    if(m_eDrawMode == eDrawMode::Both || m_eDrawMode == eDrawMode::Lines) //draw shape outlines
-      m_pObjectManager->DrawOutlines();
-  m_pRenderer->EndFrame();
-} //RenderFrame
-
-/// Handle keyboard input, move the game objects and render 
-/// them in their new positions and orientations. Notify the 
-/// audio player at the start of each frame so that it can 
-/// prevent multiple copies of a sound from starting on the
-/// same frame. Notify the timer of the start and end of the
-/// frame so that it can calculate frame time. 
-
-void CGame::ProcessFrame(){
-  KeyboardHandler(); //handle keyboard input
-  m_pAudio->BeginFrame(); //notify audio player that frame has begun
-
-  m_pTimer->Tick([&](){ 
-    m_pObjectManager->move(); //move all objects
-  });
-
-  RenderFrame(); //render a frame of animation
-} //ProcessFrame
+/// \file Game.cpp
+/// \brief Code for the game class CGame.
+
+#include <chrono>
+
+#include "Game.h"
+
+#include "GameDefines.h"
+#include "Renderer.h"
+#include "ComponentIncludes.h"
+
+#include "CollisionStats.h"
+
+#include "shellapi.h"
+
+const float FRAME_TIME = 1.0f/60.0f; ///< Fixed frame time in seconds.
+const UINT MULTIBALL = 3; ///< Number of balls queued by a multiball.
+
+CGame::~CGame(){
+  CCollisionStats::CloseCSV();
+  delete m_pRenderer;
+  delete m_pObjectManager;
+} //destructor
+
+/// Initialize the renderer, load the images for the background,
+/// and start the game. If there is a recording to replay then the game
+/// is run headless, that is, without sound and without rendering anything,
+/// and it quits as soon as the replay is done. The renderer is still needed
+/// for the size of the ball sprite, which balls are made to fit.
+
+void CGame::Initialize(){
+  m_fGravity = -200.0f;
+  m_fFrequency = 60.0f*m_nMIterations;
+  m_fTimeStep = 1.0f/m_fFrequency;
+  m_eDrawMode = eDrawMode::Background; //default draw mode
+
+  m_pRenderer = new CRenderer;
+  m_pRenderer->SetBgColor(Colors::White);
+  m_pRenderer->Initialize(eSprite::Size); 
+  m_pRenderer->LoadImages(); //load images from xml file list
+  m_pRenderer->SetBgColor(Colors::White);
+  
+  m_bHeadless = !m_strReplayFile.empty();
+  m_pObjectManager = new CObjectManager; //set up object manager 
+  if(!m_bHeadless)LoadSounds(); //load the sounds for this game
+  
+  m_cClipDesc0.m_nSpriteIndex = (UINT)eSprite::Clip;
+  m_cClipDesc0.m_vPos = Vector2(42.0f, 860.0f - 170.0f);
+  m_cClipDesc0.m_fRoll = -XM_PI/6.0f;
+
+  m_cClipDesc1.m_nSpriteIndex = (UINT)eSprite::Clip;
+  m_cClipDesc1.m_vPos = Vector2(388.0f, 860.0f - 170.0f);
+  m_cClipDesc1.m_fRoll = -5.0f*XM_PI/6.0f;
+  
+  const Vector2 dw(m_pRenderer->GetWidth(eSprite::LED) + 2.0f, 0.0f);
+  Vector2 pos(31.0f, 826.0f);
+
+  for(UINT i=0; i<NUMSCOREDIGITS; i++){
+    m_cScoreDesc[i].m_nSpriteIndex = (UINT)eSprite::LED;
+    m_cScoreDesc[i].m_vPos = pos;
+    pos += dw;
+  } //for
+
+  m_pTimer->SetFixedTimeStep();
+  m_pTimer->SetFrameTime(FRAME_TIME);
+
+  //now start the game
+  BeginGame();
+
+  if(m_bHeadless){ //replay and quit
+    Replay();
+    PostQuitMessage(0);
+  } //if
+} //Initialize
+
+/// Initialize the audio player and load game sounds.
+
+void CGame::LoadSounds(){
+  m_pAudio->Initialize(eSound::Size);
+
+  m_pAudio->Load(eSound::Beep, "beep");
+  m_pAudio->Load(eSound::Blaster, "blaster");
+  m_pAudio->Load(eSound::Ballclick, "ballclick");
+  m_pAudio->Load(eSound::Launch, "launch");
+  m_pAudio->Load(eSound::Click, "click");
+  m_pAudio->Load(eSound::Tink, "tink");
+  m_pAudio->Load(eSound::Whiffle, "whiffle");
+  m_pAudio->Load(eSound::FlipUp, "flipup");
+  m_pAudio->Load(eSound::FlipDown, "flipdown");
+  m_pAudio->Load(eSound::LostBall, "lostball");
+  m_pAudio->Load(eSound::Load, "load"); 
+} //LoadSounds
+
+/// Release all of the DirectX12 objects by deleting the renderer.
+
+void CGame::Release(){
+  delete m_pRenderer;
+  m_pRenderer = nullptr; //for safety
+} //Release
+
+/// Set the name of a recording to be replayed by Initialize() instead of
+/// playing the game. Surrounding quotes, as in a command line, are removed.
+/// \param fname File name, empty for none.
+
+void CGame::SetReplayFile(const wchar_t* fname){
+  m_strReplayFile = fname;
+
+  if(m_strReplayFile.size() >= 2 && m_strReplayFile.front() == L'"' && m_strReplayFile.back() == L'"')
+    m_strReplayFile = m_strReplayFile.substr(1, m_strReplayFile.size() - 2);
+} //SetReplayFile
+
+/// Remove whatever was left over from the last game, if anything, then
+/// load the table named by the table tag in gamesettings.xml.
+
+void CGame::BeginGame(){   
+  m_pObjectManager->Clear(); //remove the old table
+
+  const tinyxml2::XMLElement* pTag = m_pXmlSettings->FirstChildElement("table");
+  const char* source = pTag? pTag->Attribute("source"): nullptr;
+  const char* compiled = pTag? pTag->Attribute("compiled"): nullptr;
+
+  if(source == nullptr || compiled == nullptr)
+    ABORT("Table tag missing from gamesettings.xml.");
+
+  if(!m_pObjectManager->LoadTable(source, compiled))
+    ABORT("Cannot load table %s.", source);
+
+  m_nScore = 0;
+} //BeginGame
+
+/// If there is a ball resting at the bottom of the chute, launch it. Otherwise,
+/// if there are no balls at all, load one into the chute ready for launch. The
+/// random number for the launch speed is a parameter so that it can be
+/// recorded and replayed.
+/// \param rand A random number in [0, 1] for the launch speed.
+
+void CGame::Launch(float rand){
+  if(!m_pObjectManager->LaunchBall(rand) && m_pObjectManager->GetNumBalls() == 0)
+    m_pObjectManager->QueueBalls(1);
+} //Launch
+
+/// Apply an input to the game and record it, stamped with the index of
+/// the substep that it precedes. Inputs applied during a replay are not
+/// recorded again.
+/// \param e Which input.
+/// \param f Nonzero for flipper up, the random number for a launch.
+
+void CGame::Input(eInput e, float f){
+  if(!m_bHeadless)
+    m_cRecorder.Record(m_pObjectManager->GetSubstep(), e, f);
+
+  switch(e){
+    case eInput::LeftFlip:  m_pObjectManager->LeftFlip(f != 0.0f); break;
+    case eInput::RightFlip: m_pObjectManager->RightFlip(f != 0.0f); break;
+    case eInput::Launch:    Launch(f); break;
+    case eInput::Multiball: m_pObjectManager->QueueBalls((UINT)f); break;
+  } //switch
+} //Input
+
+/// Replay the recording as fast as possible, applying each recorded input
+/// before the substep that it is stamped with, and compare the hash of the
+/// dynamic circles at the end of each frame with the recorded one. The 
+/// results are written to replay.txt, including the wall time per simulated
+/// second and the slowest frame, so that a recording of a game that had a 
+/// performance spike or a physics glitch doubles as a macro benchmark.
+
+void CGame::Replay(){
+  using clock = std::chrono::high_resolution_clock;
+  FILE* pFile = nullptr; //report file
+  if(fopen_s(&pFile, "replay.txt", "wt") != 0)return;
+
+  if(!m_cRecorder.Load(m_strReplayFile.c_str())){
+    fprintf(pFile, "Cannot read %ls\n", m_strReplayFile.c_str());
+    fclose(pFile);
+    return;
+  } //if
+
+  const size_t n = m_cRecorder.GetNumFrames(); //number of frames
+  size_t mismatches = 0; //number of frames whose hashes don't match
+  size_t first = 0; //first frame whose hash doesn't match
+  double slowest = 0.0; //wall time of slowest frame in milliseconds
+  size_t slowframe = 0; //index of slowest frame
+  CInputEvent e; //next input event
+
+  const auto t0 = clock::now();
+
+  for(size_t i=0; i<n; i++){
+    const auto t1 = clock::now();
+
+    while(m_cRecorder.GetEvent(m_pObjectManager->GetSubstep(), e))
+      Input(e.m_eInput, e.m_fValue);
+
+    m_pObjectManager->move(); 
+    CCollisionStats::EndFrame();
+
+    const double t = std::chrono::duration<double, std::milli>(clock::now() - t1).count();
+
+    if(t > slowest){
+      slowest = t;
+      slowframe = i;
+    } //if
+
+    if(m_pObjectManager->GetHash() != m_cRecorder.GetHash(i) && mismatches++ == 0)
+      first = i;
+  } //for
+
+  const double wall = std::chrono::duration<double>(clock::now() - t0).count(); //in seconds
+  const double sim = n*FRAME_TIME; //simulated seconds
+
+  fprintf(pFile, "Replay of %ls\n", m_strReplayFile.c_str());
+  fprintf(pFile, "Frames: %zu (%.2f simulated seconds)\n", n, sim);
+  fprintf(pFile, "Wall time: %.3f seconds\n", wall);
+  fprintf(pFile, "Wall time per simulated second: %.3f ms\n", sim > 0.0? 1000.0*wall/sim: 0.0);
+  fprintf(pFile, "Slowest frame: %zu (%.3f ms)\n", slowframe, slowest);
+
+  if(mismatches == 0)
+    fprintf(pFile, "Hashes: all frames match\n");
+  else fprintf(pFile, "Hashes: %zu frames differ, first at frame %zu\n", mismatches, first);
+
+  fclose(pFile);
+} //Replay
+
+/// Poll the keyboard state and respond to the
+/// key presses that happened since the last frame.
+
+void CGame::KeyboardHandler(){
+  m_pKeyboard->GetState(); //get current keyboard state 
+  
+  if(m_pKeyboard->TriggerDown(VK_F1)) //help
+    ShellExecute(0, 0, "https://larc.unt.edu/code/physics/pinball/", 0, 0, SW_SHOW);
+
+  if(m_pKeyboard->TriggerDown(VK_F2)){ //change draw mode
+    m_eDrawMode = eDrawMode((UINT)m_eDrawMode + 1);
+    if(m_eDrawMode == eDrawMode::Size)m_eDrawMode = eDrawMode(0);
+  } //if
+
+  if(m_pKeyboard->TriggerDown(VK_F3)) //toggle collision statistics
+    m_bShowStats = !m_bShowStats;
+
+  if(m_pKeyboard->TriggerDown(VK_F4)){ //toggle collision statistics CSV file
+    if(CCollisionStats::IsCSVOpen())
+      CCollisionStats::CloseCSV();
+    else CCollisionStats::OpenCSV("collisionstats.csv");
+  } //if
+  
+  if(m_pKeyboard->TriggerDown(VK_F5)) //save recording of this game
+    m_cRecorder.Save(L"recording.txt");
+  
+  if(m_pKeyboard->TriggerDown(VK_SPACE)) //load and launch a ball
+    Input(eInput::Launch, m_pRandom->randf());
+
+  if(m_pKeyboard->TriggerDown(VK_F6)) //queue more balls for the chute
+    Input(eInput::Multiball, (float)MULTIBALL);
+  
+  if(m_pKeyboard->TriggerDown(VK_LSHIFT)) //left flipper up
+    Input(eInput::LeftFlip, 1.0f);
+
+  if(m_pKeyboard->TriggerUp(VK_LSHIFT)) //left flipper down
+    Input(eInput::LeftFlip, 0.0f);
+   
+  if(m_pKeyboard->TriggerDown(VK_RSHIFT)) //right flipper up
+    Input(eInput::RightFlip, 1.0f);
+  
+  if(m_pKeyboard->TriggerUp(VK_RSHIFT)) //right flipper down
+    Input(eInput::RightFlip, 0.0f);
+} //KeyboardHandler
+
+/// Ask object manager to draw the game objects. RenderWorld
+/// is notified of the start and end of the frame so
+/// that it can let Direct3D do its pipelining jiggery-pokery.
+/// In addition, draw score and the CLIP_SPRITEs for the gates on top of
+/// everything else.
+
+void CGame::RenderFrame(){ 
+  m_pRenderer->BeginFrame();
+    if(m_eDrawMode == eDrawMode::Background || m_eDrawMode == eDrawMode::Both){ //draw sprites
+      m_pRenderer->Draw(eSprite::Background, m_vWinCenter); //draw background
+
+      //draw score
+      int n = m_nScore; //current score
+
+      for(int i=NUMSCOREDIGITS-1; i>=0; i--){
+        m_cScoreDesc[i].m_nCurrentFrame = n%10; //get least significant digit
+        m_pRenderer->Draw(&m_cScoreDesc[i]); //draw it
+        n /= 10; //right shift one digit
+      } //for
+
+      m_pObjectManager->draw(); //draw objects
+    } //if
+
+    if(m_eDrawMode == eDrawMode::Background){ //draw clips over everything    
+      m_pRenderer->Draw(&m_cClipDesc0);
+      m_pRenderer->Draw(&m_cClipDesc1);
+    } //if
+  
+    if(m_eDrawMode == eDrawMode::Both || m_eDrawMode == eDrawMode::Lines) //draw shape outlines
+      m_pObjectManager->DrawOutlines();
+
+    if(m_bShowStats) //draw collision statistics
+      DrawStats();
+  m_pRenderer->EndFrame();
+} //RenderFrame
+
+/// Draw the collision statistics for the last frame, one line for each
+/// shape type that had any AABB tests or narrow phase tests, followed by
+/// the collision responses and the number of substeps and contact solver iterations.
+
+void CGame::DrawStats(){
+  const CCollisionCounts& c = CCollisionStats::GetFrame();
+  const XMVECTORF32 color = m_eDrawMode == eDrawMode::Lines? Colors::Black: Colors::White;
+  const float dy = 24.0f; //line spacing
+  Vector2 pos(16.0f, 80.0f); //text position
+
+  std::string s = "aabb/pre/hit " + std::to_string(c.GetAabbTests()) + "/" + 
+    std::to_string(c.GetPreCollides()) + "/" + std::to_string(c.GetHits());
+  m_pRenderer->DrawScreenText(s.c_str(), pos, color);
+  pos.y += dy;
+
+  for(UINT i=0; i<(UINT)eShape::Size; i++)
+    if(c.m_nAabbTests[i] > 0 || c.m_nPreCollides[i] > 0){
+      s = std::string(CCollisionStats::GetShapeName((eShape)i)) + " " + std::to_string(c.m_nAabbTests[i]) + "/" + 
+        std::to_string(c.m_nPreCollides[i]) + "/" + std::to_string(c.m_nHits[i]);
+      m_pRenderer->DrawScreenText(s.c_str(), pos, color);
+      pos.y += dy;
+    } //if
+
+  s = "post s/k/d " + 
+    std::to_string(c.m_nPostCollides[(UINT)eMotion::Static]) + "/" + 
+    std::to_string(c.m_nPostCollides[(UINT)eMotion::Kinematic]) + "/" + 
+    std::to_string(c.m_nPostCollides[(UINT)eMotion::Dynamic]);
+  m_pRenderer->DrawScreenText(s.c_str(), pos, color);
+  pos.y += dy;
+
+  s = "substeps " + std::to_string(c.m_nSubsteps) + " passes " + std::to_string(c.m_nPasses);
+  if(CCollisionStats::IsCSVOpen())s += " (csv)";
+  m_pRenderer->DrawScreenText(s.c_str(), pos, color);
+} //DrawStats
+
+/// Handle keyboard input, move the game objects and render 
+/// them in their new positions and orientations. Notify the 
+/// audio player at the start of each frame so that it can 
+/// prevent multiple copies of a sound from starting on the
+/// same frame. Notify the timer of the start and end of the
+/// frame so that it can calculate frame time. Gather the
+/// collision statistics for the frame, and record a hash of the
+/// dynamic circles so that the game can be replayed and checked.
+/// Nothing is done when running headless, since the replay is
+/// over before the first frame.
+
+void CGame::ProcessFrame(){
+  if(m_bHeadless)return; //replay is done
+
+  KeyboardHandler(); //handle keyboard input
+  m_pAudio->BeginFrame(); //notify audio player that frame has begun
+
+  m_pTimer->Tick([&](){ 
+    m_pObjectManager->move(); //move all objects
+    m_cRecorder.RecordFrame(m_pObjectManager->GetHash()); //for replays
+  });
+
+  CCollisionStats::EndFrame(); //gather collision statistics for this frame
+
+  RenderFrame(); //render a frame of animation
+} //ProcessFrame
@@ -1,128 +1,213 @@
-/// \file Object.cpp
-/// \brief Code for the game object class CObject.
-
-#include "Object.h"
-#include "LineSeg.h"
-#include "DynamicCircle.h"
-#include "Renderer.h"
-#include "ComponentIncludes.h"
-
-////////////////////////////////////////////////////////////////////////////////////
-// CObjDesc functions.
-
-/// \param s0 Unlit sprite index.
-/// \param s1 Lit sprite index.
-/// \param snd Collision sound index.
-
-CObjDesc::CObjDesc(eSprite s0, eSprite s1, eSound snd): 
-  m_eUnlitSprite(s0), 
-  m_eLitSprite(s1), 
-  m_vSpriteOffset(Vector2(0.0f)),
-  m_eSound(snd),
-  m_nScore(0){
-} //constructor
-
-////////////////////////////////////////////////////////////////////////////////////
-// CObject functions.
-
-CObject::CObject(CShape* p, const CObjDesc& d):
-  m_eUnlitSprite(d.m_eUnlitSprite), 
-  m_eLitSprite(d.m_eLitSprite), 
-  m_vSpriteOffset(d.m_vSpriteOffset),
-  m_eSound(d.m_eSound),
-  m_pShape(p),
-  m_nScore(d.m_nScore){
-} //constructor
-
-/// Update object.
-
-void CObject::Update(){
-  if(m_pShape->GetMotionType() == eMotion::Dynamic){
-    m_nSpriteIndex = (UINT)m_eUnlitSprite;
-    m_vPos = m_pShape->GetPos();
-  } //else if
-
-  else{
-    const float a = m_pShape->GetOrientation();
-    const Vector2& v0 = m_vSpriteOffset; //shorthand
-    const float x = v0.x*cosf(a) - v0.y*sinf(a);
-    const float y = v0.x*sinf(a) + v0.y*cosf(a);
-    
-    m_nSpriteIndex = (UINT)(m_bRecentHit?m_eLitSprite: m_eUnlitSprite);
-    m_vPos = m_pShape->GetPos() + Vector2(x, y);
-    m_fRoll = a;
-  } //else 
-
-  if(m_pTimer->GetTime() - m_fLastHitTime > 0.1f)
-    m_bRecentHit = false;
-} //Update
-
-/// Draw only the outline of the object's shape.
-/// This is reasonably cheap for line segments
-/// but hideously expensive for circles and arcs
-/// because it laboriously constructs the curve
-/// by drawing very short lines. Ideally
-/// I should put it into the pixel shader but I can't
-/// be bothered. This is good enough for now.
-
-void CObject::DrawOutline(){
-  const eSprite s = eSprite::BlackLine;
-
-  switch(m_pShape->GetShapeType()){
-    case eShape::LineSeg: {
-      Vector2 p0, p1;
-      ((CLineSeg*)m_pShape)->GetEndPts(p0, p1);
-      m_pRenderer->DrawLine(s, p0, p1);
-    } //case
-    break;
-      
-    case eShape::Circle: {
-      const float r = ((CCircle*)m_pShape)->GetRadius();
-      const float w = m_pRenderer->GetWidth(s);
-      const UINT count = (UINT)ceil(XM_2PI*r/w) + 1;
-
-      for(UINT i=0; i<count; i++){
-        const float a = XM_2PI*i/(float)count;
-        const Vector2 v2 = m_pShape->GetPos() + r*Vector2(cosf(a), sinf(a));
-        m_pRenderer->Draw(s, v2, XM_PI/2.0f + a);
-      } //for
-    } //case
-    break;
-      
-    case eShape::Arc: {
-      CArc* pArc = (CArc*)m_pShape;
-      float r = pArc->GetRadius();
-      UINT count = (UINT)ceil(XM_2PI*r) + 1;
-
-      for(UINT i=0; i<count; i++){
-        const float a = XM_2PI*i/(float)count;
-        const Vector2 v2 = m_pShape->GetPos() + r*Vector2(cosf(a), sinf(a));
-        if(pArc->PtInSector(v2))
-          m_pRenderer->Draw(s, v2, XM_PI/2.0f + a);
-      } //for
-    } //case
-  } //switch
-} //DrawOutline
-
-/// Reader function for the object's AABB.
-/// It gets this by querying the oblect's shape's AABB.
-/// \return The object's AABB.
-
-const CAabb2D& CObject::GetAABB() const{
-  return m_pShape->GetAABB();
-} //GetAABB
-
-/// Reader function for the object's shape.
-/// \return A pointer to the object's shape.
-
-CShape* CObject::GetShape() const{
-  return m_pShape;
-} //GetShape
-
-/// Reader function for the object's motion type.
-/// It gets this by querying the object's shape's motion type.
-/// \return The object's motion type.
-
-const eMotion CObject::GetMotionType() const{
-  return m_pShape->GetMotionType();
-} //GetMotionType
+/// \file Object.cpp
+/// \brief Code for the game object class CObject.
+
+#include "Object.h"
+#include "LineSeg.h"
+#include "DynamicCircle.h"
+#include "Renderer.h"
+#include "ComponentIncludes.h"
+
+const float OUTLINE_TOLERANCE = 0.25f; ///< Furthest that an outline chord may stray from a curve, in pixels.
+const UINT MIN_OUTLINE_CHORDS = 4; ///< Fewest chords in the outline of a circle or arc.
+
+////////////////////////////////////////////////////////////////////////////////////
+// CObjDesc functions.
+
+/// \param s0 Unlit sprite index.
+/// \param s1 Lit sprite index.
+/// \param snd Collision sound index.
+
+CObjDesc::CObjDesc(eSprite s0, eSprite s1, eSound snd): 
+  m_eUnlitSprite(s0), 
+  m_eLitSprite(s1), 
+  m_vSpriteOffset(Vector2(0.0f)),
+  m_eSound(snd),
+  m_nScore(0){
+} //constructor
+
+////////////////////////////////////////////////////////////////////////////////////
+// CObject functions.
+
+/// Construct an object from its shape's handle and an object descriptor.
+/// \param h Handle of the object's shape in the shape store.
+/// \param d Object descriptor.
+
+CObject::CObject(const CShapeHandle& h, const CObjDesc& d):
+  m_eUnlitSprite(d.m_eUnlitSprite), 
+  m_eLitSprite(d.m_eLitSprite), 
+  m_vSpriteOffset(d.m_vSpriteOffset),
+  m_eSound(d.m_eSound),
+  m_cShape(h),
+  m_nScore(d.m_nScore){
+} //constructor
+
+/// Update object.
+
+void CObject::Update(){
+  const CShape* pShape = GetShape();
+
+  if(pShape->GetMotionType() == eMotion::Dynamic){
+    m_nSpriteIndex = (UINT)m_eUnlitSprite;
+    m_vPos = pShape->GetPos();
+  } //else if
+
+  else{
+    const float a = pShape->GetOrientation();
+    const Vector2& v0 = m_vSpriteOffset; //shorthand
+    const float x = v0.x*cosf(a) - v0.y*sinf(a);
+    const float y = v0.x*sinf(a) + v0.y*cosf(a);
+    
+    m_nSpriteIndex = (UINT)(m_bRecentHit?m_eLitSprite: m_eUnlitSprite);
+    m_vPos = pShape->GetPos() + Vector2(x, y);
+    m_fRoll = a;
+  } //else 
+
+  if(m_pTimer->GetTime() - m_fLastHitTime > 0.1f)
+    m_bRecentHit = false;
+} //Update
+
+/// Add the vertices of a circular arc to a polyline, with just enough of them
+/// that no chord strays further than OUTLINE_TOLERANCE from the arc.
+/// \param v [in, out] Polyline in local coordinates, that is, relative to the center.
+/// \param r Radius.
+/// \param a0 Start angle.
+/// \param sweep Angle swept out counterclockwise from the start angle.
+
+static void MakeArc(std::vector<Vector2>& v, float r, float a0, float sweep){
+  const float step = 2.0f*acosf(max(0.0f, 1.0f - OUTLINE_TOLERANCE/r)); //angle per chord
+  const UINT n = max(MIN_OUTLINE_CHORDS, (UINT)ceilf(sweep/step)); //number of chords
+
+  for(UINT i=0; i<=n; i++){
+    const float a = a0 + sweep*i/(float)n;
+    v.push_back(r*Vector2(cosf(a), sinf(a)));
+  } //for
+} //MakeArc
+
+/// Make the outline of the object's shape as a polyline in local coordinates,
+/// that is, relative to the shape's position. This is only done once, except
+/// for kinematic shapes, whose outlines must be made again whenever their
+/// orientation changes. An outline made while the shape is waiting to be
+/// rotated to a new orientation is used once and then thrown away.
+
+void CObject::MakeOutline(){
+  CShape* pShape = GetShape();
+  const Vector2& c = pShape->GetPos(); //shorthand
+
+  m_stdOutline.clear();
+  m_fOutlineOrientation = pShape->GetOrientation();
+  m_bOutline = !pShape->GetDirty();
+
+  switch(pShape->GetShapeType()){
+    case eShape::LineSeg: {
+      Vector2 p0, p1;
+      ((CLineSeg*)pShape)->GetEndPts(p0, p1);
+      m_stdOutline.push_back(p0 - c);
+      m_stdOutline.push_back(p1 - c);
+    } //case
+    break;
+      
+    case eShape::Circle:
+      MakeArc(m_stdOutline, ((CCircle*)pShape)->GetRadius(), 0.0f, XM_2PI);
+    break;
+      
+    case eShape::Arc: {
+      CArc* pArc = (CArc*)pShape;
+      Vector2 p0, p1;
+      pArc->GetEndPts(p0, p1);
+
+      const float a0 = atan2f(p0.y - c.y, p0.x - c.x); //start angle
+      float sweep = atan2f(p1.y - c.y, p1.x - c.x) - a0; //counterclockwise to end angle
+      if(sweep <= 0.0f)sweep += XM_2PI;
+
+      MakeArc(m_stdOutline, pArc->GetRadius(), a0, sweep);
+    } //case
+    break;
+
+    case eShape::Polygon: {
+      CPolygonShape* pPoly = (CPolygonShape*)pShape;
+
+      for(UINT i=0; i<pPoly->GetNumVertices(); i++)
+        m_stdOutline.push_back(pPoly->GetVertex(i) - c);
+
+      m_stdOutline.push_back(pPoly->GetVertex(0) - c); //close the loop
+    } //case
+    break;
+
+    case eShape::Chain: {
+      CChainShape* pChain = (CChainShape*)pShape;
+
+      for(UINT i=0; i<pChain->GetNumVertices(); i++)
+        m_stdOutline.push_back(pChain->GetVertex(i) - c);
+
+      if(pChain->IsLoop())
+        m_stdOutline.push_back(pChain->GetVertex(0) - c); //close the loop
+    } //case
+    break;
+
+    case eShape::Capsule: {
+      CCapsuleShape* pCapsule = (CCapsuleShape*)pShape;
+      const Vector2& d = pCapsule->GetAxis(); //shorthand
+      const float a = atan2f(d.y, d.x); //angle of axis
+      const float b = acosf(pCapsule->GetSin()); //angle from axis to where the tangents touch
+
+      MakeArc(m_stdOutline, pCapsule->GetRadius1(), a - b, 2.0f*b); //end 1
+
+      for(auto& p: m_stdOutline)
+        p += pCapsule->GetPt1() - c;
+
+      MakeArc(m_stdOutline, pCapsule->GetRadius0(), a + b, XM_2PI - 2.0f*b); //end 0
+      m_stdOutline.push_back(m_stdOutline[0]); //close the loop
+    } //case
+    break;
+  } //switch
+} //MakeOutline
+
+/// Add the outline of the object's shape to a line list in world coordinates,
+/// two points per line, making the outline first if it hasn't been made yet
+/// or if the shape has been rotated since it was made.
+/// \param lines [in, out] Line list.
+
+void CObject::GetOutline(std::vector<Vector2>& lines){
+  CShape* pShape = GetShape();
+
+  if(!m_bOutline || pShape->GetOrientation() != m_fOutlineOrientation)
+    MakeOutline();
+
+  const Vector2& c = pShape->GetPos(); //shorthand
+
+  for(size_t i=1; i<m_stdOutline.size(); i++){
+    lines.push_back(c + m_stdOutline[i - 1]);
+    lines.push_back(c + m_stdOutline[i]);
+  } //for
+} //GetOutline
+
+/// Reader function for the object's AABB.
+/// It gets this by querying the oblect's shape's AABB.
+/// \return The object's AABB.
+
+const CAabb2D& CObject::GetAABB() const{
+  return GetShape()->GetAABB();
+} //GetAABB
+
+/// Reader function for the object's shape, which is looked up
+/// in the shape store using the object's shape handle.
+/// \return A pointer to the object's shape.
+
+CShape* CObject::GetShape() const{
+  return m_pShapeStore->Get(m_cShape);
+} //GetShape
+
+/// Reader function for the object's shape handle.
+/// \return The object's shape handle.
+
+const CShapeHandle& CObject::GetShapeHandle() const{
+  return m_cShape;
+} //GetShapeHandle
+
+/// Reader function for the object's motion type.
+/// It gets this from the object's shape handle.
+/// \return The object's motion type.
+
+const eMotion CObject::GetMotionType() const{
+  return m_cShape.m_eMotionType;
+} //GetMotionType
@@ -1,838 +1,566 @@
-/// \file ObjectManager.cpp
-/// \brief Code for the object manager class CObjectManager.
-
-#include "ObjectManager.h"
-#include "Parts.h"
-#include "Renderer.h"
-#include "Compound.h"
-#include "ComponentIncludes.h"
-
-const float TOP_MARGIN = 60.0f; ///< Height of top margin.
-
-/// The destructor clears the shape lists, which destructs
-/// all of the shapes in them.
-
-CObjectManager::~CObjectManager(){
-  for(eMotion m: {eMotion::Static, eMotion::Kinematic})
-    for(auto const& p: m_stdShapes[(UINT)m])
-      delete p; 
-
-  for(auto const &p: m_stdObjects)
-    delete p; 
-
-  for(auto const &p: m_vBumperList)
-    delete p; 
-
-  //delete parts
-
-  delete m_pLeftFlipper;
-  delete m_pRightFlipper;
-
-  delete m_pLeftGate;
-  delete m_pRightGate;
-} //destructor
-
-/// Make the static shapes for the world boundaries. As with most physics code, this
-/// function is long and tedious, but it's important to get the details right.
-
-void CObjectManager::MakeWorldEdges(){ 
-  const float w = (float)m_nWinWidth;
-  const float h = (float)m_nWinHeight;
-  
-  m_cAABB = CAabb2D(Vector2(0.0f, h), Vector2(w, 0.0f));
-
-  const Vector2 p0 = Vector2(0.0f, 0.0f);
-  const Vector2 p1 = Vector2(w, 0.0f);
-  
-  const Vector2 p2 = Vector2(w, h - w/2.0f - TOP_MARGIN);
-  const Vector2 p3 = Vector2(0.0f, h - w/2.0f - TOP_MARGIN);
-
-  //right side vertical 
-  
-  CLineSegDesc lsDesc(p1, p2, 0.9f);
-  CObjDesc nullObjDesc(eSprite::None, eSprite::None, eSound::Size);
-  AddShape(&lsDesc, nullObjDesc);
-
-  //left side vertical
-
-  lsDesc.SetEndPts(p3, p0);
-  AddShape(&lsDesc, nullObjDesc);
-
-  //arc at top 
-  
-  const Vector2 p4 = Vector2(w/2.0f, h - w/2.0f - TOP_MARGIN);
-  
-  CArcDesc arcDesc(p4, w/2.0f, 0.0f, 1.15f*XM_PI, 0.8f); 
-  CArc* pArc = (CArc*)AddShape(&arcDesc, nullObjDesc);
-  
-  Vector2 u0, u1, u3;
-  arcDesc.GetEndPts(u0, u1);
-  Vector2 vTangent0, vTangent1;
-  pArc->GetTangents(vTangent0, vTangent1);
-  vTangent1.Normalize();
-  u3 = u1 + 64.0f*vTangent1;
-
-  lsDesc.SetEndPts(u1, u3);
-  AddShape(&lsDesc, nullObjDesc);
-
-  CPointDesc ptDesc;
-
-  ptDesc.m_vPos = u3;
-  AddShape(&ptDesc, nullObjDesc);
-  
-  vTangent1 = Vector2(vTangent1.y, -vTangent1.x);
-  Vector2 u4 = u3 + 64.0f*vTangent1;
-  lsDesc.SetEndPts(u3, u4);
-  lsDesc.m_fElasticity = 1000.0f; 
-  CObjDesc lsObjDesc(eSprite::UnlitSpecial, eSprite::LitSpecial, eSound::Beep);
-  lsObjDesc.m_nScore = 1;
-  const float sr = m_pRenderer->GetWidth(eSprite::UnlitSpecial);
-  Vector2 v0, v1;
-  lsDesc.GetEndPts(v0, v1);
-  Vector2 n = v0 - v1;
-  n.Normalize();
-  n = Vector2(-n.y, n.x);
-  lsObjDesc.m_vSpriteOffset = sr*n;
-  AddShape(&lsDesc, lsObjDesc);
-
-  //gates at top of table
-
-  //the actual top arc was created above... this is an imaginary arc inside it
-  const float r = w/2.0f - 1.5f*m_pRenderer->GetWidth(eSprite::Ball);
-  arcDesc.m_fRadius = r;
-  arcDesc.SetAngles(0.0f, XM_PI/6.0f);
-  Vector2 q0, q1;
-  arcDesc.GetEndPts(q0, q1);
-  q1 += Vector2(-2.5f, 2.5f);
-  lsDesc.SetEndPts(q1, pArc->ClosestPt(q1));
-  lsDesc.m_fElasticity = 0.6f;
-  CObjDesc lsObjDesc2(eSprite::None, eSprite::None, eSound::Click);
-  
-  CLineSeg* pShape = (CLineSeg*)MakeShape(&lsDesc, lsObjDesc2);
-  m_pRightGate = new CGate(pShape);
-  
-  arcDesc.SetAngles(5.0f*XM_PI/6.0f, XM_PI);  
-  arcDesc.GetEndPts(q0, q1);
-  q0 += Vector2(2.5f, 2.5f);
-  lsDesc.SetEndPts(pArc->ClosestPt(q0), q0);
-  
-  pShape = (CLineSeg*)MakeShape(&lsDesc, lsObjDesc2);
-  m_pLeftGate = new CGate(pShape);
-
-  //line segment to protect new ball
-
-  const float lx = w - 1.5f*m_pRenderer->GetWidth(eSprite::Ball);
-  const float ly = p4.y;
-  
-  const Vector2 p5 = Vector2(lx, 0.0f);
-  const Vector2 p6 = Vector2(lx, ly);
-
-  lsDesc.SetEndPts(p5, p6);
-  AddShape(&lsDesc, nullObjDesc);
-  
-  //bottom of chute
-  lsDesc.SetEndPts(p1, p5);
-  lsDesc.m_fElasticity = 0.1f;
-  AddShape(&lsDesc, lsObjDesc2);
-  
-  //LHS flipper base and associated shapes
-  
-  const float mid = 196.0f;
-  
-  const float r2 = 10.0f;
-  const float dx = 1.2f*m_pRenderer->GetWidth(eSprite::Ball);
-
-  const Vector2 p7 = Vector2(dx + r2, h - 754.0f);
-  const Vector2 p8 = Vector2(112.0f, 67.0f);
-
-  const Vector2 p9 = Vector2(0.0f, 80.0f);
-  const Vector2 p10 = Vector2(mid - 75.0f, 16.0f);
-
-  CCircleDesc circDesc(p7, r2, 0.4f);
-  CCircle* pCirc0 = (CCircle*)AddShape(&circDesc, nullObjDesc);
-  
-  CCircleDesc circDesc2(p8, r2, 0.4f);
-  CCircle* pCirc1 = (CCircle*)AddShape(&circDesc2, nullObjDesc);
-
-  CLineSegDesc lsDesc0, lsDesc1;
-  pCirc1->Tangents(pCirc0, lsDesc0, lsDesc1);
-  lsDesc0.m_fElasticity = 1000.0f;
-  lsDesc1.m_fElasticity = 0.4f;
-  CObjDesc lsObjDesc3(eSprite::UnlitSpecial, eSprite::LitSpecial, eSound::Beep);
-  lsObjDesc3.m_nScore = 1;
-  lsDesc0.GetEndPts(v0, v1);
-  n = v1 - v0;
-  n.Normalize();
-  n = Vector2(-n.y, n.x);
-  lsObjDesc3.m_vSpriteOffset = sr*n;
-  AddShape(&lsDesc0, lsObjDesc3);
-  AddShape(&lsDesc1, nullObjDesc);
-
-  const Vector2 p7a = p7 + Vector2(-r2, 0.0f);
-  const Vector2 p7b = p7 + Vector2(-r2, 150.0f);
-
-  //vertical line
-  lsDesc0.SetEndPts(p7a, p7b);
-  lsDesc0.m_fElasticity = 0.2f;
-  AddShape(&lsDesc0, nullObjDesc);
-
-  ptDesc.m_vPos = p7b;
-  ptDesc.m_fElasticity = 0.2f;
-  AddShape(&ptDesc, nullObjDesc);
-  
-  //lower diagonal
-  lsDesc.SetEndPts(p9, p10);
-  lsDesc.m_fElasticity = 0.1f;
-  AddShape(&lsDesc, nullObjDesc);
-
-  ptDesc.m_vPos = p10;
-  AddShape(&ptDesc, nullObjDesc);
-  
-  lsDesc.SetEndPts(p10, Vector2(p10.x, 0.0f));
-  AddShape(&lsDesc, nullObjDesc);
-  
-  //RHS flipper base and associated shapes
-
-  const Vector2 p11 = Vector2(2.0f*mid - p7.x, p7.y);
-  const Vector2 p12 = Vector2(2.0f*mid - p8.x, p8.y);
-  const Vector2 p13 = Vector2(2.0f*mid - p9.x, p9.y);
-  const Vector2 p14 = Vector2(2.0f*mid - p10.x, p10.y);
-  
-  CCircleDesc circDesc3(p11, r2, 0.4f);
-  pCirc0 = (CCircle*)AddShape(&circDesc3, nullObjDesc);
-
-  const Vector2 p11a = p11 + Vector2(r2, 0.0f);
-  const Vector2 p11b = p11 + Vector2(r2, 150.0f);
-
-  //vertical line
-  lsDesc0.SetEndPts(p11a, p11b);
-  lsDesc0.m_fElasticity = 0.2f;
-  AddShape(&lsDesc0, nullObjDesc);
-
-  ptDesc.m_vPos = p11b;
-  ptDesc.m_fElasticity = 0.2f;
-  AddShape(&ptDesc, nullObjDesc);
-  
-  CCircleDesc circDesc4(p12, r2, 0.4f);
-  pCirc1 = (CCircle*)(AddShape(&circDesc4, nullObjDesc));
-
-  pCirc1->Tangents(pCirc0, lsDesc0, lsDesc1);
-  lsDesc0.m_fElasticity = 0.4f;
-  lsDesc1.m_fElasticity = 2000.0f;
-  lsDesc1.GetEndPts(v0, v1);
-  n = perp(Normalize(v1 - v0));
-  lsObjDesc3.m_vSpriteOffset = sr*n;
-  AddShape(&lsDesc0, nullObjDesc);
-  AddShape(&lsDesc1, lsObjDesc3);
-
-  //lower diagonal
-  lsDesc.SetEndPts(p13, p14);
-  AddShape(&lsDesc, nullObjDesc);
-  
-  ptDesc.m_vPos = p14;
-  AddShape(&ptDesc, nullObjDesc);
-  
-  lsDesc.SetEndPts(p14, Vector2(p14.x, 0.0f));
-  AddShape(&lsDesc, nullObjDesc);
-} //MakeWorldEdges
-
-/// A bollard is one of the long skinny things at the top.
-/// \param p Position.
-
-/// Make a polygonal bumper out of lines and points.
-/// \param n Number of sides.
-/// \param p Position of polygon center.
-/// \param e Elasticity.
-/// \param unlit Unlit sprite index.
-/// \param lit Lit sprite index.
-/// \param snd Collision sound index.
-/// \param nScore Score for hitting bumper.
-
-
-
-/// Flippers are compound shapes made up of 2 circles and 2 line segments.
-/// \param p Position of center of rotation.
-/// \param d Offset from position to center of sprite.
-/// \param a Initial orientation.
-
-CCompoundShape* CObjectManager::MakeFlipper(const Vector2& p, const Vector2& d, float a){
-  CCompoundShape* pFlipper = new CCompoundShape(); //result
-
-  //multimedia descriptors
-  CObjDesc nullObjDesc(eSprite::None, eSprite::None, eSound::Size),
-    flipObjDesc(eSprite::Flipper, eSprite::Flipper, eSound::Size);
-  flipObjDesc.m_vSpriteOffset = -d; 
-
-  //add large circle centered at p
-  const float rp = 10.0f;
-  CCircleDesc circDesc(p, rp, 0.2f);
-  circDesc.m_eMotionType = eMotion::Kinematic;
-  CCircle* pCirc0 = (CCircle*)AddShape(&circDesc, flipObjDesc);
-  pFlipper->AddShape(pCirc0);
-
-  //add small circle
-  const Vector2 q = p + Vector2(58.0f, 0.0f);
-  const float rq = 6.5f;
-  circDesc.m_vPos = q;
-  circDesc.m_fRadius = rq;
-  CCircle* pCirc1 = (CCircle*)AddShape(&circDesc, nullObjDesc);
-  pFlipper->AddShape(pCirc1);
-
-  //line segment descriptor for tangents
-  CLineSegDesc lsDesc0;
-  lsDesc0.m_fElasticity = 0.1f;
-  lsDesc0.m_eMotionType = eMotion::Kinematic;
-  CLineSegDesc lsDesc1(lsDesc0);
-
-  //add tangent line segments
-  pCirc1->Tangents(pCirc0, lsDesc0, lsDesc1);
-  CShape* pLineSeg0 = AddShape(&lsDesc0, nullObjDesc);
-  pFlipper->AddShape(pLineSeg0);
-  CShape* pLineSeg1 = AddShape(&lsDesc1, nullObjDesc);
-  pFlipper->AddShape(pLineSeg1);
-
-  //do these last to make sure thay get applied to all the shapes
-  pFlipper->SetRotCenter(p);
-  pFlipper->SetOrientation(a);
-
-  return pFlipper;
-} //MakeFlipper
-
-/// I don't know what to call it. One of the things on the left and right
-/// of the bollards at the top of the play area. This is the left one.
-
-void CObjectManager::MakeThingL(){ 
-  const float w = (float)m_nWinWidth;
-  const float h = (float)m_nWinHeight;
-  const float e = 0.4f; //elasticity
-  
-  CObjDesc nullObjDesc(eSprite::None, eSprite::None, eSound::Size);
-  CObjDesc thingObjDesc(eSprite::None, eSprite::None, eSound::Size);
-  thingObjDesc.m_vSpriteOffset = Vector2(-12.0f, -46.0f);
-  
-  const Vector2 p0 = Vector2(w/2.0f, h - w/2.0f - TOP_MARGIN - 4.0f);
-  const float r = w/2.0f - 1.5f*m_pRenderer->GetWidth(eSprite::Ball);
-  CArcDesc arcDesc(p0, r, 5.0f*XM_PI/6.0f, XM_PI, e); 
-
-  AddShape(&arcDesc, nullObjDesc);
-  
-  Vector2 p1, p2;
-  arcDesc.GetEndPts(p1, p2);
-
-  const float w0 = 10.0f;
-  const float w1 = 16.0f;
-
-  CCircleDesc circleDesc(p2 + Vector2(w1/2.0f, 0.0f), w1/2.0f, e);
-  CCircle* pCirc0 = (CCircle*)AddShape(&circleDesc, nullObjDesc);
-
-  const Vector2 p3 = p2 + Vector2(w1, 0.0f);
-  const Vector2 p4 = p2 + Vector2(25.0f, 31.0f);
-
-  circleDesc.m_vPos = p4;
-  CCircle* pCirc1 = (CCircle*)AddShape(&circleDesc, nullObjDesc);
-  
-  circleDesc.m_fRadius = w0/2.0f;
-  circleDesc.m_vPos = p1 + Vector2(w0/2.0f, 0.0f);
-  CCircle* pCirc2 = (CCircle*)AddShape(&circleDesc, thingObjDesc);
-  
-  CLineSegDesc lsDesc;
-  lsDesc.m_fElasticity = e;
-
-  pCirc1->Tangent(pCirc0, lsDesc);
-  AddShape(&lsDesc, nullObjDesc);
-  
-  pCirc2->Tangent(pCirc1, lsDesc);
-  AddShape(&lsDesc, nullObjDesc);
-} //MakeThingL
-
-/// I don't know what to call it. One of the things on the left and right
-/// of the bollards at the top of the play area. This is the right one.
-
-void CObjectManager::MakeThingR(){ 
-  const float w = (float)m_nWinWidth;
-  const float h = (float)m_nWinHeight;
-  const float e = 0.4f; //elasticity
-  
-  CObjDesc nullObjDesc(eSprite::None, eSprite::None, eSound::Size);
-  CObjDesc thingObjDesc(eSprite::None, eSprite::None, eSound::Size);
-  thingObjDesc.m_vSpriteOffset = Vector2(12.0f, -46.0f);
-  
-  const Vector2 p0 = Vector2(w/2.0f, h - w/2.0f - TOP_MARGIN - 4.0f);
-  const float r = w/2.0f - 1.5f*m_pRenderer->GetWidth(eSprite::Ball);
-  CArcDesc arcDesc(p0, r, 0.0f, XM_PI/6.0f, e); 
-
-  AddShape(&arcDesc, nullObjDesc);
-  
-  Vector2 p1, p2;
-  arcDesc.GetEndPts(p2, p1);
-
-  const float w0 = 10.0f;
-  const float w1 = 16.0f;
-
-  CCircleDesc circleDesc(p2 - Vector2(w1/2.0f, 0.0f), w1/2.0f, e);
-  CCircle* pCirc0 = (CCircle*)AddShape(&circleDesc, nullObjDesc);
-
-  const Vector2 p3 = p2 + Vector2(-w1, 0.0f);
-  const Vector2 p4 = p2 + Vector2(-25.0f, 31.0f);
-
-  circleDesc.m_vPos = p4;
-  CCircle* pCirc1 = (CCircle*)AddShape(&circleDesc, nullObjDesc);
-  
-  circleDesc.m_fRadius = w0/2.0f;
-  circleDesc.m_vPos = p1 - Vector2(w0/2.0f, 0.0f);
-  CCircle* pCirc2 = (CCircle*)AddShape(&circleDesc, thingObjDesc);
-  
-  CLineSegDesc lsDesc;
-  lsDesc.m_fElasticity = e;
-
-  pCirc0->Tangent(pCirc1, lsDesc);
-  AddShape(&lsDesc, nullObjDesc);
-  
-  pCirc1->Tangent(pCirc2, lsDesc);
-  AddShape(&lsDesc, nullObjDesc);
-} //MakeThingR
-
-/// Make the static shapes for the things in the world. As with most physics code, this
-/// function is long and tedious, but it's important to get the details right.
-
-void CObjectManager::MakeShapes(){ 
-  const float w = (float)m_nWinWidth;
-  const float h = (float)m_nWinHeight;
-
-  const float mid = 196.0f; //center x-coordinate of play area
-  const float e = 500.0f; //elasticity of bumpers
-
-  const eSound snd = eSound::Blaster;
-  const float y = 580.0f - TOP_MARGIN; //y coordinate of bumpers
-  const float dx = 100.0f; //distance between bumpers
-  
-  MakeBumper(3, Vector2(mid + 14.0f - dx, y), e, 
-    eSprite::UnlitTriangle, eSprite::LitTriangle, snd, 10);
-  MakeBumper(4, Vector2(mid + 14.0f,      y), e, 
-    eSprite::UnlitDiamond, eSprite::LitDiamond, snd, 100);
-  MakeBumper(5, Vector2(mid + 14.0f + dx, y), e, 
-    eSprite::UnlitPentagon, eSprite::LitPentagon, snd, 100);
-  
-  const float dx2 = 84.0f; //half distance between flippers
-  const float y2 = 67.0f; //y coordinate of flippers
-
-  const Vector2 vLeft = Vector2(mid - dx2, y2);
-  const float aLeft = 11.0f*XM_PI/6.0f;
-  const Vector2 d = Vector2(-28.0f, 0.0f);
-  CCompoundShape* pFlipper = MakeFlipper(vLeft, d, aLeft);
-  m_pLeftFlipper = new CFlipper(pFlipper, true);
-  
-  const Vector2 vRight = Vector2(mid + dx2, y2);
-  const float aRight = 7.0f*XM_PI/6.0f;
-  pFlipper = MakeFlipper(vRight, d, aRight);
-  m_pRightFlipper = new CFlipper(pFlipper, false);
-
-  //make bollards
-
-  CPointDesc ptDesc(Vector2(0.0f), 0.0f);
-  ptDesc.m_bIsSensor = true;
-  CObjDesc ptObjDesc(eSprite::UnlitSlot, eSprite::LitSlot, eSound::Whiffle);
-  ptObjDesc.m_nScore = 5;
-
-  const float dx3 = 1.2f*m_pRenderer->GetWidth(eSprite::Ball) + 12.5f;
-  float y3 = h - 156.0f - TOP_MARGIN;
-  const UINT numbollards = 6;
-
-  for(UINT i=0; i<numbollards; i++){
-    float x3 = w/2.0f + (i - numbollards/2.0f)*dx3 + dx3/2.0f;
-    MakeBollard(Vector2(x3, y3));
-    if(i < numbollards - 1){
-      ptDesc.m_vPos = Vector2(x3 + dx3/2.0f, y3);
-      AddShape(&ptDesc, ptObjDesc);
-    } //if
-  } //for
-
-  //thing at top left
-  MakeThingL(); //left thing
-  MakeThingR(); //right thing
-} //MakeShapes
-
-/// Create a new shape and a contact descriptor for that shape.
-/// \param sd Pointer to a shape descriptor.
-/// \param od An object descriptor.
-/// \return Pointer to a new contact descriptor.
-
-CShape* CObjectManager::MakeShape(CShapeDesc* sd, const CObjDesc& od){
-  CShape* p = nullptr;
-
-  switch(sd->m_eMotionType){
-    case eMotion::Kinematic:
-      switch(sd->m_eShapeType){
-        case eShape::Point:   p = new CKinematicPoint(  *(CPointDesc*)  sd); break;
-        case eShape::LineSeg: p = new CKinematicLineSeg(*(CLineSegDesc*)sd); break;
-        case eShape::Circle:  p = new CKinematicCircle( *(CCircleDesc*) sd); break;
-        case eShape::Arc:     p = new CKinematicArc(    *(CArcDesc*)    sd); break;
-      } //switch 
-      break;
-      
-    case eMotion::Static:
-      switch(sd->m_eShapeType){
-        case eShape::Point:   p = new CPoint(  *(CPointDesc*)  sd); break;
-        case eShape::LineSeg: p = new CLineSeg(*(CLineSegDesc*)sd); break;
-        case eShape::Circle:  p = new CCircle( *(CCircleDesc*) sd); break;
-        case eShape::Arc:     p = new CArc(    *(CArcDesc*)    sd); break;
-      } //switch
-      break;
-    
-    case eMotion::Dynamic:
-      p = new CDynamicCircle(*(CDynamicCircleDesc*)sd);
-      break;
-  } //switch
-
-  CObject* pObject = new CObject(p, od);
-  m_stdObjects.push_back(pObject);
-  p->SetUserPtr(pObject);
-
-  return p;
-} //MakeShape
-
-/// Creates a new shape and pushes a contact descriptor for that
-/// shape into the shape list.
-/// \param sd Pointer to a shape descriptor.
-/// \param od Object descriptor.
-/// \return Pointer to created shape.
-
-CShape* CObjectManager::AddShape(CShapeDesc* sd, const CObjDesc& od){
-  CShape* p = MakeShape(sd, od); 
-  m_stdShapes[(UINT)p->GetMotionType()].push_back(p);
-  return p;
-} //AddShape
-
-/// Draw the sprites for all objects.
-
-void CObjectManager::draw(){
-  for(auto const& p: m_stdObjects) //for each object
-    if(p->m_nSpriteIndex != (UINT)eSprite::None) //if it has a sprite
-      m_pRenderer->Draw((LSpriteDesc2D*)p); //draw it
-} //draw
-
-/// Draw the outlines of the shapes in all objects.
-
-void CObjectManager::DrawOutlines(){ 
-  for(auto const& p: m_stdObjects) //for each object
-    p->DrawOutline(); //ask it to draw its outline
-} //draw
-
-/// Move all of the shapes in the dynamic and kinematic shape lists and perform collision response.
-
-void CObjectManager::move(){ 
-  for(UINT j=0; j<m_nMIterations; j++){
-    for(auto const &p: m_stdShapes[(UINT)eMotion::Kinematic])
-      p->move();
-
-    auto i=m_stdShapes[(UINT)eMotion::Dynamic].begin();
-    while(i!=m_stdShapes[(UINT)eMotion::Dynamic].end()){
-      (*i)->move(); //move it
-
-      //delete lost ball
-
-      if(!(m_cAABB && (*i)->GetAABB())){
-        CObject* pObj = (CObject*)((*i)->GetUserPtr()); //get object pointer from shape
-
-        for(auto j=m_stdObjects.begin(); j!=m_stdObjects.end(); j++)
-          if(*j == pObj){ //if it's the object corr. to the shape
-            delete *j; //delete the object
-            m_stdObjects.erase(j); //remove object pointer from object list
-            break;
-          } //if
-
-        i = m_stdShapes[(UINT)eMotion::Dynamic].erase(i); //remove shape pointer from shape list
-        m_pAudio->play(eSound::LostBall);
-        m_bBallInPlay = false;
-      } //if
-
-      else ++i;
-    } //while
-
-    for(UINT i=0; i<m_nCIterations; i++)
-      BroadPhase(); //broadphase collision detection and response
-  } //for
-  
-  m_pLeftFlipper->EnforceBounds();
-  m_pRightFlipper->EnforceBounds();
-
-  m_pLeftGate->CloseGate();
-  m_pRightGate->CloseGate();
-
-  for(auto const& p: m_stdObjects)
-    p->Update();
-} //move
-
-/// Do collision detection for all dynamic shapes against all
-/// static and kinematic shapes, and against all dynamic shapes
-/// that appear after it in the dynamic shape list. 
-
-void CObjectManager::BroadPhase(){
-  const auto begin = m_stdShapes[(UINT)eMotion::Dynamic].begin();
-  const auto end = m_stdShapes[(UINT)eMotion::Dynamic].end();
-
-  for(UINT k=0; k<4; k++)
-    for(auto i=begin; i!=end; i++){
-      const auto pCirc = (CDynamicCircle*)*i; //pointer to current dynamic shape
-
-      m_pLeftGate->NarrowPhase(pCirc); //left gate   
-      m_pRightGate->NarrowPhase(pCirc);  //right gate
-
-      for(auto const& pShape: m_stdShapes[(UINT)eMotion::Static]) //static shapes
-        NarrowPhase(pShape, pCirc);
-    
-      for(auto const& pShape: m_stdShapes[(UINT)eMotion::Kinematic]) //kinematic shapes
-        NarrowPhase(pShape, pCirc);
-     
-      for(auto j=next(i); j!=end; j++) //dynamic shapes, later numbered to avoid doubling up
-        NarrowPhase(*j, pCirc);
-    } //for
-} //BroadPhase
-
-/// Check whether a pair of shapes collides and make appropriate response.
-/// \param pShape Pointer to a static or kinematic shape.
-/// \param pCirc Pointer to moving circle.
-/// \return true if there was a collision.
-
-
-////////////////////////////////////////////////////////////////////////////////////////
-// Code for flippers
-
-/// If left flipper isn't moving up, set its rotational
-/// velocity to ROTSPEED (with the correct sign indicating direction),
-/// and play a sound.
-/// \param bUp true for up flip, false for down flip.
-
-void CObjectManager::LeftFlip(bool bUp){  
-  m_pLeftFlipper->Flip(bUp);
-} //LeftFlip
-
-/// If right flipper isn't moving up, set its rotational
-/// velocity to ROTSPEED (with the correct sign indicating direction),
-/// and play a sound.
-/// \param bUp true for up flip, false for down flip.
-
-void CObjectManager::RightFlip(bool bUp){  
-  m_pRightFlipper->Flip(bUp);
-} //RightFlip
-
-
-void CObjectManager::MakeBollard(const Vector2& p) {
-    const float e = 0.4f;
-    const float h = 54.0f;
-    const float w = 10.0f;
-
-    Vector2 p0 = p + Vector2(-w / 2.0f, h / 2.0f);
-    Vector2 p1 = p + Vector2(-w / 2.0f, -h / 2.0f);
-    Vector2 p2 = p + Vector2(w / 2.0f, h / 2.0f);
-    Vector2 p3 = p + Vector2(w / 2.0f, -h / 2.0f);
-
-    CCircleDesc circleDesc(p - Vector2(0.0f, h / 2.0f), w / 2.0f, e);
-    CObjDesc nullObjDesc(eSprite::None, eSprite::None, eSound::Size);
-    CCircle* pCirc0 = (CCircle*)AddShape(&circleDesc, nullObjDesc);
-
-    circleDesc.m_vPos = p + Vector2(0.0f, h / 2.0f);
-    CObjDesc bollardObjDesc(eSprite::None, eSprite::None, eSound::Size);
-    bollardObjDesc.m_vSpriteOffset = Vector2(0.0f, -25.0f);
-    CCircle* pCirc1 = (CCircle*)AddShape(&circleDesc, bollardObjDesc);
-
-    CLineSegDesc lsDesc0, lsDesc1;
-    pCirc0->Tangents(pCirc1, lsDesc0, lsDesc1);
-    AddShape(&lsDesc0, nullObjDesc);
-    AddShape(&lsDesc1, nullObjDesc);
-} //MakeBollard
-
-
-
-
-
-
-std::vector<CShape*> triangleColliders;
-std::vector<CShape*> rectangleColliders;
-std::vector<CShape*> pentagonColliders;
-
-CShape* CObjectManager::AddLine(Vector2 point1, Vector2 point2, CObjDesc particles)
-{
-    return AddShape(&CLineSegDesc(point1, point2), particles);
-}
-
-
-bool CObjectManager::NarrowPhase(CShape* pShape, CDynamicCircle* pCirc) {
-    bool bHit = false;
-
-    CContactDesc cd(pShape, pCirc);
-
-    if (pShape->PreCollide(cd)) { //there's a collision
-        if (!pShape->GetSensor())
-            pCirc->PostCollide(cd);
-
-        bHit = true;
-        CObject* pObj0 = (CObject*)(pCirc->GetUserPtr());
-
-        if (pShape->GetMotionType() == eMotion::Dynamic) { //dynamic shape
-            if (pObj0 != nullptr)
-                m_pAudio->play(pObj0->m_eSound, cd.m_vPOI, cd.m_fSpeed / 1000.0f);
-        } //if
-
-        else { //static or kinematic shape
-            CObject* pObj1 = (CObject*)(pShape->GetUserPtr());
-
-            if (cd.m_fSpeed > 10.0f) {
-                m_pAudio->play(pObj1->m_eSound, cd.m_vPOI);
-
-                if (!pObj1->m_bRecentHit)
-                    m_nScore += pObj1->m_nScore;
-            } //if
-
-            pObj1->m_bRecentHit = true;
-            pObj1->m_fLastHitTime = m_pTimer->GetTime();
-        } //else
-    } //if
-
-    //****CSCE 5255 STUDENTS: YOUR CODE STARTS HERE
-    Vector2 center = pShape->GetPos();
-    if (bHit == true) {
-        for (int a = 0; a < triangleColliders.size(); a++) {
-            if (triangleColliders[a] == pShape) {
-                TriangleIsHit();
-            }
-        }
-        for (int a = 0; a < rectangleColliders.size(); a++) {
-            if (rectangleColliders[a] == pShape) {
-                RectangleIsHit();
-            }
-        }
-        for (int a = 0; a < pentagonColliders.size(); a++) {
-            if (pentagonColliders[a] == pShape) {
-                PentagonIsHit();
-            }
-        }
-    }
-    //****CSCE 5255 STUDENTS: YOUR CODE ENDS HERE
-
-    return bHit;
-} //NarrowPhase
-
-void CObjectManager::TriangleIsHit()
-{
-    CObject* bumper = (CObject*)(bumpers[0]->GetUserPtr());
-    bumper->m_bRecentHit = true;
-    bumper->m_fLastHitTime = m_pTimer->GetTime();
-    m_nScore += 10;
-}
-void CObjectManager::RectangleIsHit()
-{
-    CObject* bumper = (CObject*)(bumpers[1]->GetUserPtr());
-    bumper->m_bRecentHit = true;
-    bumper->m_fLastHitTime = m_pTimer->GetTime();
-    m_nScore += 100;
-}
-void CObjectManager::PentagonIsHit()
-{
-    CObject* bumper = (CObject*)(bumpers[2]->GetUserPtr());
-    bumper->m_bRecentHit = true;
-    bumper->m_fLastHitTime = m_pTimer->GetTime();
-    m_nScore += 100;
-}
-
-
-
-void CObjectManager::MakeBumper(UINT n, const Vector2& p, float e,
-    eSprite unlit, eSprite lit, eSound snd, UINT nScore)
-{
-    if (n < 3)ABORT("Too few edges in polygon");
-
-    //multimedia descriptors
-    CObjDesc nullObjDesc(eSprite::None, eSprite::None, snd);
-    CObjDesc lineDesc(eSprite::BlackLine, eSprite::BlackLine, snd);
-
-
-    CObjDesc bumperObjDesc(unlit, lit, snd);
-    bumperObjDesc.m_nScore = nScore;
-    CPointDesc pointDesc(p);
-
-    CShape* pCenterPoint = AddShape(&pointDesc, bumperObjDesc);
-    CPolygon* pBumper = new CPolygon(pCenterPoint);
-    
-    //****ALL STUDENTS: YOUR CODE STARTS HERE
-    Vector2 center = pCenterPoint->GetPos();
-    int numberOfSides = n;
-    float radius = 35;
-    switch (numberOfSides) {
-        case 3:
-            bumpers.push_back(pCenterPoint);
-            //triangleBumper = bumperObjDesc;
-            MakeBumperTriangle(center, radius, lineDesc);
-            break;
-        case 4:
-            bumpers.push_back(pCenterPoint);
-            //rectangleBumper = CObject(pCenterPoint, bumperObjDesc);
-            MakeBumperRectangle(center, radius, lineDesc);
-            break;
-        case 5:
-            bumpers.push_back(pCenterPoint);
-          //  pentagonBumper = CObject(pCenterPoint, bumperObjDesc);
-            MakeBumperPentagon(center, radius, lineDesc);
-            break;
-    
-    }
-
-    //****ALL STUDENTS: YOUR CODE ENDS HERE
-
-    //REMINDER: CSCE 5255 students must also
-    //add code to CObjectManager::NarrowPhase().
-
-    m_vBumperList.push_back(pBumper);
-} //MakeBumper
-
-
-
-void CObjectManager::MakeBumperTriangle(Vector2 center, float radius, CObjDesc particles)
-{
-    float x = center.x;
-    float y = center.y;
-    Vector2 left = Vector2(x - radius, y - radius / sqrt(3));
-    Vector2 right = Vector2(x + radius, y - radius / sqrt(3));
-    Vector2 top = Vector2(x , y + radius);
-
-    triangleColliders.push_back(AddLine(left, top, particles));
-    triangleColliders.push_back(AddLine(top, right, particles));
-    triangleColliders.push_back(AddLine(right, left, particles));
-}
-void CObjectManager::MakeBumperRectangle(Vector2 center, float radius, CObjDesc particles)
-{
-    float x = center.x;
-    float y = center.y;
-    Vector2 left = Vector2(x - radius, y);
-    Vector2 right = Vector2(x + radius, y);
-    Vector2 top = Vector2(x, y + radius);
-    Vector2 bottom = Vector2(x, y - radius);
-
-    rectangleColliders.push_back(AddLine(left, top, particles));
-    rectangleColliders.push_back(AddLine(top, right, particles));
-    rectangleColliders.push_back(AddLine(right, bottom, particles));
-    rectangleColliders.push_back(AddLine(bottom, left, particles));
-}
-void CObjectManager::MakeBumperPentagon(Vector2 center, float radius, CObjDesc particles)
-{
-    float x = center.x;
-    float y = center.y;
-    float pi = 3.14f;
-    float c1 = cos(2 * pi / 5);
-    float c2 = cos(pi / 5);
-    float s1 = sin(2 * pi / 5);
-    float s2 = sin(4 * pi / 5);
-
-
-    Vector2 top = Vector2(x, y + radius);
-    Vector2 side1 = Vector2(x +  radius * s1, y + radius * c1);
-    Vector2 side2 = Vector2(x + radius * s2, y - radius * c2);
-    Vector2 side3 = Vector2(x - radius * s2, y - radius * c2);
-    Vector2 side4 = Vector2(x - radius * s1, y + radius * c1);
-
-    pentagonColliders.push_back(AddLine(top, side1, particles));
-    pentagonColliders.push_back(AddLine(side1, side2, particles));
-    pentagonColliders.push_back(AddLine(side2, side3, particles));
-    pentagonColliders.push_back(AddLine(side3, side4, particles));
-    pentagonColliders.push_back(AddLine(side4, top, particles));
-}
\ No newline at end of file
+/// \file ObjectManager.cpp
+/// \brief Code for the object manager class CObjectManager.
+
+#include "ObjectManager.h"
+#include "Parts.h"
+#include "Renderer.h"
+#include "Compound.h"
+#include "ComponentIncludes.h"
+
+#include <cstring>
+
+const float GRID_CELL_SIZE = 32.0f; ///< Width and height of a grid cell.
+const UINT MIN_SUBSTEPS = 1; ///< Minimum number of substeps per frame.
+const UINT MAX_SUBSTEPS = 4; ///< Maximum number of substeps per frame.
+const UINT MAX_CITERATIONS = 8; ///< Maximum number of collision iterations per substep.
+const float CHUTE_Y = 48.0f; ///< Height at which balls are loaded into the chute.
+const UINT FNV_OFFSET = 2166136261U; ///< FNV-1a offset basis for 32-bit hashes.
+const UINT FNV_PRIME = 16777619U; ///< FNV-1a prime for 32-bit hashes.
+
+/// Names of the sprite tags in gamesettings.xml, indexed by eSprite.
+
+const char* const SPRITE_NAME[(UINT)eSprite::Size] = {
+  "", "background", "blackline", "special0", "special1",
+  "triangle0", "triangle1", "diamond0", "diamond1",
+  "pentagon0", "pentagon1",
+  "slot0", "slot1", "flipper", "clip", "ball", "LED"
+}; //SPRITE_NAME
+
+/// Names of the sound tags in gamesettings.xml, indexed by eSound.
+
+const char* const SOUND_NAME[(UINT)eSound::Size] = {
+  "beep", "blaster", "ballclick", "launch", "whiffle", "flipup", "flipdown",
+  "lostball", "load", "click", "tink"
+}; //SOUND_NAME
+
+/// Find the sprite that a table refers to by name.
+/// \param name Name of a sprite tag, or nullptr for none.
+/// \return The sprite, or eSprite::None if there isn't one by that name.
+
+static eSprite FindSprite(const char* name){
+  if(name != nullptr)
+    for(UINT i=0; i<(UINT)eSprite::Size; i++)
+      if(strcmp(name, SPRITE_NAME[i]) == 0)
+        return (eSprite)i;
+
+  return eSprite::None;
+} //FindSprite
+
+/// Find the sound that a table refers to by name.
+/// \param name Name of a sound tag, or nullptr for none.
+/// \return The sound, or eSound::Size if there isn't one by that name.
+
+static eSound FindSound(const char* name){
+  if(name != nullptr)
+    for(UINT i=0; i<(UINT)eSound::Size; i++)
+      if(strcmp(name, SOUND_NAME[i]) == 0)
+        return (eSound)i;
+
+  return eSound::Size;
+} //FindSound
+
+/// The constructor creates the shape store.
+
+CObjectManager::CObjectManager(){
+  m_pShapeStore = new CShapeStore;
+  m_cScheduler.SetBounds(MIN_SUBSTEPS, MAX_SUBSTEPS, MAX_CITERATIONS);
+} //constructor
+
+/// The destructor deletes the shape store, which releases all of the shapes
+/// in it. The objects and parts are released by the arena's destructor.
+
+CObjectManager::~CObjectManager(){
+  delete m_pShapeStore;
+  m_pShapeStore = nullptr;
+} //destructor
+
+/// Make the objects and shapes for a table, and put its static shapes into the
+/// uniform grid using the table's grid index, baking the index first if it
+/// hasn't been already. This must be called on an empty object manager, that
+/// is, after construction or Clear(). The shapes are made in the order in which
+/// they appear in the table, so the static shapes end up in the order that
+/// the grid index expects. The shapes of a flipper are given at orientation
+/// zero, so its center of rotation and orientation are set after all of them
+/// have been added. Each shape of a bumper after the first gets a handle to
+/// the first shape's object, which lights up and scores when it is hit.
+/// \param table Table descriptor.
+
+void CObjectManager::LoadTable(CTableDesc& table){
+  const float w = (float)m_nWinWidth;
+  const float h = (float)m_nWinHeight;
+  
+  SetBounds(CAabb2D(Vector2(0.0f, h), Vector2(w, 0.0f))); //balls that leave the window are lost
+
+  if(!table.IsBaked())
+    table.Bake(GRID_CELL_SIZE);
+
+  std::vector<CCompoundShape*> compounds; //one per flipper
+  
+  for(UINT i=0; i<(UINT)table.m_stdFlippers.size(); i++)
+    compounds.push_back(m_cArena.Make<CCompoundShape>());
+
+  std::vector<CSlotHandle> bodies; //handle of first object of each bumper
+
+  //shapes
+
+  for(UINT i=0; i<(UINT)table.m_stdShapes.size(); i++){
+    if(!table.CanMake(i))continue; //skipped by Bake() too
+
+    const CTableShape& s = table.m_stdShapes[i];
+    CShapeDesc* sd = table.GetShapeDesc(i);
+
+    CObjDesc od(FindSprite(table.GetName(s.m_nUnlitSprite)),
+      FindSprite(table.GetName(s.m_nLitSprite)), FindSound(table.GetName(s.m_nSound)));
+    od.m_vSpriteOffset = s.m_vSpriteOffset;
+    od.m_nScore = s.m_nScore;
+
+    CShape* p = nullptr;
+
+    if(s.m_ePart == eTablePart::Gate && s.m_eShapeType == eShape::LineSeg){
+      p = MakeShape(sd, od); //gates aren't in the shape lists
+      if(p != nullptr)m_stdGates.push_back(m_cArena.Make<CGate>((CLineSeg*)p));
+    } //if
+
+    else p = AddShape(sd, od);
+
+    if(p == nullptr)continue; //the shape store can't make it, so skip it
+    p->SetCanCollide(s.m_bCanCollide);
+
+    if(s.m_ePart == eTablePart::Flipper && s.m_nPart < (UINT)compounds.size())
+      compounds[s.m_nPart]->AddShape(p);
+
+    else if(s.m_ePart == eTablePart::Bumper){
+      if(s.m_nPart >= (UINT)bodies.size())
+        bodies.resize(s.m_nPart + 1);
+
+      if(!bodies[s.m_nPart].IsValid()) //first shape of bumper
+        bodies[s.m_nPart] = p->GetUser();
+      else FindObject(p)->m_cBody = bodies[s.m_nPart];
+    } //else if
+  } //for
+
+  //flippers
+
+  for(UINT i=0; i<(UINT)compounds.size(); i++){
+    const CTableFlipper& f = table.m_stdFlippers[i];
+    CCompoundShape* pCompound = compounds[i];
+
+    pCompound->SetRotCenter(f.m_vRotCenter);
+    pCompound->SetOrientation(f.m_fOrientation);
+    Add(pCompound);
+
+    CFlipper* pFlipper = m_cArena.Make<CFlipper>(pCompound, f.m_bLeft);
+    (f.m_bLeft? m_stdLeftFlippers: m_stdRightFlippers).push_back(pFlipper);
+  } //for
+
+  //grid, whose index was worked out from the same static shapes in the same order
+
+  m_cGrid.Build(m_stdStatic, table.m_cGrid);
+} //LoadTable
+
+/// Load a table from file and make its objects and shapes. The compiled form
+/// is used if it was compiled from the source form as it is now, otherwise
+/// the source form is compiled and the compiled form saved for next time.
+/// \param source Source form file name.
+/// \param compiled Compiled form file name.
+/// \return true if the table was loaded.
+
+bool CObjectManager::LoadTable(const char* source, const char* compiled){
+  CTableDesc table;
+  if(!table.Load(source, compiled, GRID_CELL_SIZE))return false;
+
+  LoadTable(table);
+  return true;
+} //LoadTable
+
+/// Remove all of the objects, parts, and shapes so that a table can be made
+/// from scratch by calling LoadTable() again. The parts are destructed by resetting the arena and
+/// the shapes by clearing the shape store, neither of which gives any memory
+/// back to the heap, so the next table is made in the memory that this one
+/// used. Handles for the old objects become stale.
+
+void CObjectManager::Clear(){
+  CWorld::Clear();
+
+  m_cObjects.Clear();
+  m_stdGates.clear();
+  m_stdLeftFlippers.clear();
+  m_stdRightFlippers.clear();
+
+  m_cEvents.Clear();
+  m_nSubstep = 0;
+  m_nBallQueue = 0;
+
+  m_cArena.Reset();
+  m_pShapeStore->Clear();
+} //Clear
+
+/// Create a new shape and an object for that shape. The object goes into the
+/// object slot map and its handle goes into the shape's user handle.
+/// \param sd Pointer to a shape descriptor.
+/// \param od An object descriptor.
+/// \return Pointer to the new shape, nullptr if the shape store can't make it.
+
+CShape* CObjectManager::MakeShape(CShapeDesc* sd, const CObjDesc& od){
+  const CShapeHandle h = m_pShapeStore->Make(sd);
+  CShape* p = m_pShapeStore->Get(h);
+  if(p == nullptr)return nullptr; //no container for this type
+
+  p->SetUser(m_cObjects.Insert(h, od));
+
+  return p;
+} //MakeShape
+
+/// Get the object for a shape from the shape's user handle. The pointer
+/// is only good until the next object is made or removed, so don't keep it.
+/// \param p Pointer to a shape.
+/// \return Pointer to the shape's object, nullptr if it doesn't have one.
+
+CObject* CObjectManager::FindObject(const CShape* p){
+  return m_cObjects.Get(p->GetUser());
+} //FindObject
+
+/// Creates a new shape and an object for it, and adds the shape to the
+/// world. Static shapes go into the static shape list, kinematic shapes
+/// into the AABB tree, and dynamic shapes into sweep and prune.
+/// \param sd Pointer to a shape descriptor.
+/// \param od Object descriptor.
+/// \return Pointer to created shape, nullptr if it can't be made.
+
+CShape* CObjectManager::AddShape(CShapeDesc* sd, const CObjDesc& od){
+  CShape* p = MakeShape(sd, od); 
+  if(p == nullptr)return nullptr; //couldn't make it
+
+  Add(p);
+  return p;
+} //AddShape
+
+/// Draw the sprites for all objects.
+
+void CObjectManager::draw(){
+  for(auto& obj: m_cObjects) //for each object
+    if(obj.m_nSpriteIndex != (UINT)eSprite::None) //if it has a sprite
+      m_pRenderer->Draw((LSpriteDesc2D*)&obj); //draw it
+} //draw
+
+/// Draw the outlines of the shapes in all objects. The outlines are gathered
+/// into a single line list first and then drawn in one go.
+
+void CObjectManager::DrawOutlines(){ 
+  m_stdOutlines.clear();
+
+  for(auto& obj: m_cObjects) //for each object
+    obj.GetOutline(m_stdOutlines); //add its outline to the line list
+
+  for(size_t i=0; i+1<m_stdOutlines.size(); i+=2)
+    m_pRenderer->DrawLine(eSprite::BlackLine, m_stdOutlines[i], m_stdOutlines[i + 1]);
+} //DrawOutlines
+
+/// Move all of the shapes and perform collision response, one substep at a
+/// time, using the world's substep pipeline. The collisions found along the
+/// way are queued, and their sounds, scores, and lighting up are handled once
+/// after the last substep, so that the physics makes no audio or timer calls.
+
+void CObjectManager::move(){ 
+  LoadBall(); //load the next queued ball if the chute is clear
+  Schedule(); //choose substeps and collision iterations for this frame
+  m_nLost = 0;
+
+  for(UINT j=0; j<m_nMIterations; j++){
+    CCollisionStats::Substep();
+    ++m_nSubstep;
+    Substep(m_nCIterations);
+  } //for
+
+  if(m_nLost > 0 && !m_bHeadless)
+    m_pAudio->play(eSound::LostBall);
+
+  HandleEvents(); //sound, score, and lighting up for this frame's collisions
+  
+  for(auto const& p: m_stdLeftFlippers)
+    p->EnforceBounds();
+
+  for(auto const& p: m_stdRightFlippers)
+    p->EnforceBounds();
+
+  for(auto const& p: m_stdGates)
+    p->CloseGate();
+
+  for(auto& obj: m_cObjects)
+    obj.Update();
+} //move
+
+/// Choose the number of substeps and collision iterations for this frame
+/// using the substep scheduler. Each dynamic circle asks for enough substeps
+/// that it won't move further than the smallest feature near it in a single
+/// substep. The features near it are those of the static and kinematic shapes
+/// in the AABB that it swept out during the last frame, and its own radius.
+/// Rotating flippers don't ask for more substeps, since SweptMove() finds
+/// where they hit a dynamic circle however far they turn in a substep.
+/// Frames in which dynamic circles are touching each other get more
+/// collision iterations, and the others get the contact solver's minimum.
+
+void CObjectManager::Schedule(){
+  m_cScheduler.Begin();
+
+  for(auto const& pCirc: m_stdCircles){
+    const CAabb2D aabb = pCirc->GetSweptAABB((float)m_nMIterations); //one frame's worth
+
+    float size = pCirc->GetRadius(); //size of smallest feature nearby
+
+    m_cGrid.Query(aabb, m_stdCandidates); //static shapes
+
+    for(auto const& pShape: m_stdCandidates)
+      size = min(size, CSubstepScheduler::GetFeatureSize(pShape));
+
+    m_cTree.Query(aabb, m_stdCandidates); //kinematic shapes
+
+    for(auto const& pShape: m_stdCandidates)
+      size = min(size, CSubstepScheduler::GetFeatureSize(pShape));
+
+    m_cScheduler.Add(pCirc->GetVel().Length(), size);
+  } //for
+
+  if(!m_stdPairs.empty()) //balls were touching at the end of the last frame
+    m_cScheduler.AddContact();
+
+  m_cScheduler.End();
+
+  m_nMIterations = m_cScheduler.GetSubsteps();
+  m_nCIterations = m_cScheduler.GetCIterations();
+  m_fFrequency = 60.0f*m_nMIterations;
+  m_fTimeStep = 1.0f/m_fFrequency;
+} //Schedule
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Code for balls
+
+/// Load the next queued ball into the chute, unless there is already a ball
+/// in the way. This is called at the start of every frame so that queued
+/// balls follow each other into the chute as each one is launched.
+/// \return true if a ball was loaded.
+
+bool CObjectManager::LoadBall(){
+  if(m_nBallQueue == 0)return false; //no balls waiting
+
+  const float r = m_pRenderer->GetWidth(eSprite::Ball)/2.0f;
+  const Vector2 pos = Vector2(m_nWinWidth - 1.5f*r, CHUTE_Y);
+
+  for(auto const& p: m_stdCircles)
+    if((p->GetPos() - pos).LengthSquared() < sqr(2.0f*r))
+      return false; //chute is occupied
+
+  CDynamicCircleDesc d; 
+  d.m_fElasticity = 0.9f;
+  d.m_vPos = pos;
+  d.m_fRadius = r;
+
+  const CObjDesc od(eSprite::Ball, eSprite::Ball, eSound::Ballclick);
+  AddShape(&d, od);
+  --m_nBallQueue;
+
+  if(!m_bHeadless)m_pAudio->play(eSound::Load, pos); 
+  return true;
+} //LoadBall
+
+/// Add balls to the queue for the chute. The first one is loaded straight
+/// away if the chute is clear, and the rest follow one at a time.
+/// \param n Number of balls.
+
+void CObjectManager::QueueBalls(UINT n){
+  m_nBallQueue += n;
+  LoadBall();
+} //QueueBalls
+
+/// Launch the ball resting at the bottom of the chute, if there is one, by
+/// giving it a vertical velocity. The random number adds a little bit of
+/// variety to the speed so that each launch behaves slightly differently.
+/// \param rand A random number in [0, 1] for the launch speed.
+/// \return true if a ball was launched.
+
+bool CObjectManager::LaunchBall(float rand){
+  const float r = m_pRenderer->GetWidth(eSprite::Ball)/2.0f;
+  bool bLaunched = false; //return result
+
+  for(auto const& p: m_stdCircles){
+    const Vector2 pos = p->GetPos();
+
+    if(pos.x > m_nWinWidth - 2.0f*r && pos.y <= r + 1.0f){ //resting in chute
+      const float speed = 1000.0f + 1000.0f*rand; 
+      p->SetVel(Vector2(0.0f, speed));
+      bLaunched = true;
+
+      const float volume = std::max(0.1f, speed/4500.0f);
+      if(!m_bHeadless)m_pAudio->play(eSound::Launch, pos, volume); 
+    } //if
+  } //for
+
+  return bLaunched;
+} //LaunchBall
+
+/// Reader function for the number of balls, counting both those in play
+/// and those waiting in the queue for the chute.
+/// \return Number of balls.
+
+const UINT CObjectManager::GetNumBalls() const{
+  return (UINT)m_stdCircles.size() + m_nBallQueue;
+} //GetNumBalls
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Code for flippers
+
+/// If the left flippers aren't moving up, set their rotational
+/// velocity to ROTSPEED (with the correct sign indicating direction),
+/// and play a sound.
+/// \param bUp true for up flip, false for down flip.
+
+void CObjectManager::LeftFlip(bool bUp){  
+  for(auto const& p: m_stdLeftFlippers)
+    p->Flip(bUp);
+} //LeftFlip
+
+/// If the right flippers aren't moving up, set their rotational
+/// velocity to ROTSPEED (with the correct sign indicating direction),
+/// and play a sound.
+/// \param bUp true for up flip, false for down flip.
+
+void CObjectManager::RightFlip(bool bUp){  
+  for(auto const& p: m_stdRightFlippers)
+    p->Flip(bUp);
+} //RightFlip
+
+/// Reader function for the substep index, which is the number of substeps
+/// taken since the start of the game. Inputs are stamped with this so that
+/// they can be replayed before the same substep.
+/// \return Index of the next substep.
+
+const UINT CObjectManager::GetSubstep() const{
+  return m_nSubstep;
+} //GetSubstep
+
+/// Compute a 32-bit FNV-1a hash of the positions and velocities of all of the
+/// dynamic circles. Two runs whose hashes agree at the end of every frame have,
+/// to all intents and purposes, the same ball trajectories.
+/// \return Hash of the dynamic circles.
+
+const UINT CObjectManager::GetHash() const{
+  UINT h = FNV_OFFSET; //hash so far
+
+  for(auto const& p: m_stdCircles){
+    const Vector2 pos = p->GetPos();
+    const Vector2 vel = p->GetVel();
+    const float f[4] = {pos.x, pos.y, vel.x, vel.y};
+    const unsigned char* b = (const unsigned char*)f;
+
+    for(size_t i=0; i<sizeof(f); i++)
+      h = (h^b[i])*FNV_PRIME;
+  } //for
+
+  return h;
+} //GetHash
+
+/// Collision detection for the gates, which the world calls for each awake
+/// dynamic circle before it tests the candidates. Gates respond at once,
+/// since they only ever let a dynamic circle through them one way.
+/// \param pCirc Pointer to a dynamic circle.
+
+void CObjectManager::Collide(CDynamicCircle* pCirc){
+  for(auto const& p: m_stdGates)
+    p->NarrowPhase(pCirc);
+} //Collide
+
+/// Queue a collision event for a contact. This is called from inside the
+/// physics loop, so it takes constant time. The object that was hit is found
+/// from the shape's user handle. If the shape is dynamic then the event is
+/// for the dynamic circle that hit it, which makes the sound, otherwise it is
+/// for the shape's object, if it has one. Each object gets at most one event
+/// per frame, its fastest hit, so that a ball resting on a bumper across
+/// several substeps makes one sound instead of one per substep. The object's
+/// frame stamp says whether it already has an event in the queue.
+/// \param cd Contact descriptor which has been filled in by collision detection.
+
+void CObjectManager::OnCollision(const CContactDesc& cd){
+  const CShape* pShape = cd.m_pShape;
+
+  const CSlotHandle h = pShape->GetMotionType() == eMotion::Dynamic?
+    cd.m_pCircle->GetUser(): pShape->GetUser();
+
+  CObject* pObj = m_cObjects.Get(h);
+  if(pObj == nullptr)return; //no object
+
+  if(pObj->m_nFrame != m_nFrame){ //first event for this object in this frame
+    pObj->m_nFrame = m_nFrame;
+    pObj->m_nEvent = m_cEvents.Push(h, cd.m_vPOI, cd.m_fSpeed);
+  } //if
+
+  else{ //keep the faster of the two
+    CCollisionEvent& e = m_cEvents[pObj->m_nEvent];
+
+    if(cd.m_fSpeed > e.m_fSpeed){
+      e.m_vPOI = cd.m_vPOI;
+      e.m_fSpeed = cd.m_fSpeed;
+    } //if
+  } //else
+} //OnCollision
+
+/// Delete a ball that has left the window, which the world has already
+/// taken out of its dynamic circle list and sweep and prune. Its slot in
+/// the shape store is freed and its object removed, so the handles for
+/// them become stale.
+/// \param pCirc Pointer to a dynamic circle.
+
+void CObjectManager::OnLost(CDynamicCircle* pCirc){
+  CObject* pObj = FindObject(pCirc); //get object pointer from shape
+  m_pShapeStore->Remove(pObj->GetShapeHandle()); //free its slot in the shape store
+  m_cObjects.Remove(pCirc->GetUser()); //remove object, pObj is now invalid
+  ++m_nLost;
+} //OnLost
+
+/// The sound, score, and lighting up for the collision events queued during
+/// this frame, at most one per object. The time is read once for all of them.
+/// The queue is empty afterwards, and the frame stamp moves on so that
+/// objects no longer look like they have events in it.
+
+void CObjectManager::HandleEvents(){
+  const float time = m_pTimer->GetTime();
+
+  for(UINT i=0; i<m_cEvents.GetSize(); i++){
+    const CCollisionEvent& e = m_cEvents[i];
+    CObject* pObj = m_cObjects.Get(e.m_cObject);
+    if(pObj == nullptr)continue; //gone, such as a lost ball
+
+    if(pObj->GetMotionType() == eMotion::Dynamic){ //dynamic circle hit another
+      if(!m_bHeadless)
+        m_pAudio->play(pObj->m_eSound, e.m_vPOI, e.m_fSpeed/1000.0f);
+      continue;
+    } //if
+
+    if(e.m_fSpeed > 10.0f){
+      if(!m_bHeadless)
+        m_pAudio->play(pObj->m_eSound, e.m_vPOI);
+
+      if(!pObj->m_bRecentHit)
+        m_nScore += pObj->m_nScore;
+    } //if
+
+    pObj->m_bRecentHit = true;
+    pObj->m_fLastHitTime = time;
+
+    if(CObject* pBody = m_cObjects.Get(pObj->m_cBody)){ //part of a bumper
+      if(!pBody->m_bRecentHit)
+        m_nScore += pBody->m_nScore;
+
+      pBody->m_bRecentHit = true;
+      pBody->m_fLastHitTime = time;
+    } //if
+  } //for
+
+  m_cEvents.Clear();
+
+  if(++m_nFrame == 0){ //frame stamps have wrapped around, so start again
+    for(auto& obj: m_cObjects)
+      obj.m_nFrame = 0;
+
+    m_nFrame = 1;
+  } //if
+} //HandleEvents
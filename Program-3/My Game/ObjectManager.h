@@ -1,90 +1,90 @@
-/// \file ObjectManager.h
-/// \brief Interface for the object manager class CObjectManager.
-
-#ifndef __L4RC_GAME_OBJECTMANAGER_H__
-#define __L4RC_GAME_OBJECTMANAGER_H__
-
-#include <vector>
-
-#include "DynamicCircle.h"
-#include "Parts.h"
-
-#include "Object.h"
-
-#include "Component.h"
-#include "Common.h"
-#include "Settings.h"
-#include "SpriteDesc.h"
-#include "Polygon.h"
-
-/// \brief The object manager.
-///
-/// A collection of all of the game objects.
-
-class CObjectManager: 
-  public CCommon, 
-  public LComponent,
-  public LSettings{
-
-  private:
-
-      //CObject* triangleBumper;
-     // CObject* rectangleBumper;
-      //CObject* pentagonBumper;
-    std::vector<CShape*> bumpers;
-    std::vector<CShape*> m_stdShapes[(UINT)eMotion::Size]; ///< Array of lists of shapes.
-    std::vector<CObject*> m_stdObjects; ///< Object list.
-    
-    CGate* m_pLeftGate = nullptr; ///< Pointer to left gate.
-    CGate* m_pRightGate = nullptr; ///< Pointer to right gate.
-    
-    std::vector<CPolygon*> m_vBumperList; ///< Bumper list.
-
-    CAabb2D m_cAABB; ///< AABB for the whole window.
-
-    CFlipper* m_pLeftFlipper = nullptr; ///< Pointer to left flipper.
-    CFlipper* m_pRightFlipper = nullptr; ///< Pointer to right flipper.
-    
-    CShape* MakeShape(CShapeDesc*, const CObjDesc&); ///< Make a shape.
-
-    void BroadPhase(); ///< Broad phase collision detection and response.
-    bool NarrowPhase(CShape*, CDynamicCircle*); ///< Narrow phase collision detection and response. 
-
-    void TriangleIsHit();
-
-    void RectangleIsHit();
-
-    void PentagonIsHit();
-     
-    void MakeBumper(UINT, const Vector2&, float, eSprite, eSprite, eSound , UINT); ///< Make a polygonal bumper.
-
-    void MakeBumperTriangle(Vector2 center, float radius, CObjDesc particles);
-
-    void MakeBumperRectangle(Vector2 center, float radius, CObjDesc particles);
-
-    void MakeBumperPentagon(Vector2 center, float radius, CObjDesc particles);
-
-    CShape* AddLine(Vector2 point1, Vector2 point2, CObjDesc particles);
-
-    void MakeBollard(const Vector2&); ///< Make a bollard.
-    CCompoundShape* MakeFlipper(const Vector2&, const Vector2&, float); ///< Make a flipper.
-    void MakeThingL(); ///< Make a thing (left).
-    void MakeThingR(); ///< Make a thing (right).
-
-  public:
-    ~CObjectManager(); ///< Destructor.
-    
-    CShape* AddShape(CShapeDesc*, const CObjDesc&); ///< Add shape.
-
-    void move(); ///< Move all objects.  
-    void draw(); ///< Draw all objects.
-    void DrawOutlines(); ///< Draw outlines of all objects.
-
-    void MakeWorldEdges(); ///< Create shapes for world edges.
-    void MakeShapes(); ///< Create shapes.
-    
-    void LeftFlip(bool); ///< Flip left flipper.
-    void RightFlip(bool); ///< Flip right flipper.
-}; //CObjectManager
-
-#endif //__L4RC_GAME_OBJECTMANAGER_H__
+/// \file ObjectManager.h
+/// \brief Interface for the object manager class CObjectManager.
+
+#ifndef __L4RC_GAME_OBJECTMANAGER_H__
+#define __L4RC_GAME_OBJECTMANAGER_H__
+
+#include <vector>
+
+#include "World.h"
+#include "SubstepScheduler.h"
+#include "Arena.h"
+#include "SlotMap.h"
+#include "TableDesc.h"
+#include "CollisionStats.h"
+#include "Parts.h"
+#include "EventQueue.h"
+
+#include "Object.h"
+
+#include "Component.h"
+#include "Common.h"
+#include "Settings.h"
+#include "SpriteDesc.h"
+
+/// \brief The object manager.
+///
+/// A collection of all of the game objects, made from a table descriptor.
+/// The physics is done by the world that it is derived from. The object
+/// manager adds the gates' collision detection to each substep, queues
+/// an event for each collision, and deletes the objects of lost balls.
+
+class CObjectManager: 
+  public CCommon, 
+  public LComponent,
+  public LSettings,
+  public CWorld{
+
+  private:
+    CArena m_cArena; ///< Arena for parts.
+
+    CSlotMap<CObject> m_cObjects; ///< Objects, found from their shapes' user handles.
+    std::vector<CGate*> m_stdGates; ///< Gates.
+
+    std::vector<Vector2> m_stdOutlines; ///< Line list for drawing outlines, two points per line.
+    CEventQueue m_cEvents; ///< Collisions found during this frame.
+    UINT m_nFrame = 1; ///< Frame stamp, so objects know whether they have an event in the queue.
+    CSubstepScheduler m_cScheduler; ///< Chooses substeps and collision iterations.
+    UINT m_nSubstep = 0; ///< Number of substeps since the start of the game.
+    UINT m_nBallQueue = 0; ///< Number of balls waiting to be loaded into the chute.
+    UINT m_nLost = 0; ///< Number of balls lost this frame.
+
+    std::vector<CFlipper*> m_stdLeftFlippers; ///< Left flippers.
+    std::vector<CFlipper*> m_stdRightFlippers; ///< Right flippers.
+    
+    CShape* MakeShape(CShapeDesc*, const CObjDesc&); ///< Make a shape.
+    CObject* FindObject(const CShape*); ///< Get a shape's object.
+    bool LoadBall(); ///< Load a queued ball into the chute.
+
+    void Schedule(); ///< Choose substeps and collision iterations.
+    void Collide(CDynamicCircle*); ///< Collision detection for gates.
+    void OnCollision(const CContactDesc&); ///< Queue a collision event.
+    void OnLost(CDynamicCircle*); ///< Delete a lost ball.
+    void HandleEvents(); ///< Sound, score, and lighting up.
+
+  public:
+    CObjectManager(); ///< Constructor.
+    ~CObjectManager(); ///< Destructor.
+    
+    CShape* AddShape(CShapeDesc*, const CObjDesc&); ///< Add shape.
+
+    void move(); ///< Move all objects.  
+    void draw(); ///< Draw all objects.
+    void DrawOutlines(); ///< Draw outlines of all objects.
+
+    void LoadTable(CTableDesc&); ///< Make objects and shapes for a table.
+    bool LoadTable(const char*, const char*); ///< Load a table from file.
+    void Clear(); ///< Remove everything.
+    
+    void QueueBalls(UINT); ///< Queue balls to be loaded into the chute.
+    bool LaunchBall(float); ///< Launch the ball in the chute.
+    const UINT GetNumBalls() const; ///< Get number of balls in play or queued.
+
+    void LeftFlip(bool); ///< Flip left flipper.
+    void RightFlip(bool); ///< Flip right flipper.
+
+    const UINT GetSubstep() const; ///< Get substep index.
+    const UINT GetHash() const; ///< Get hash of dynamic circles.
+}; //CObjectManager
+
+#endif //__L4RC_GAME_OBJECTMANAGER_H__
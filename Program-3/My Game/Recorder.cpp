@@ -0,0 +1,122 @@
+/// \file Recorder.cpp
+/// \brief Code for the input recorder class CRecorder.
+
+#include <cstdio>
+
+#include "Recorder.h"
+
+/// Remove all input events and frame hashes, ready to start a new recording.
+
+void CRecorder::Clear(){
+  m_stdEvents.clear();
+  m_stdHashes.clear();
+  m_nNext = 0;
+} //Clear
+
+/// Append an input event to the recording.
+/// \param n Index of the substep that the input precedes.
+/// \param e Which input.
+/// \param f Value of the input.
+
+void CRecorder::Record(UINT n, eInput e, float f){
+  CInputEvent event;
+  event.m_nSubstep = n;
+  event.m_eInput = e;
+  event.m_fValue = f;
+  m_stdEvents.push_back(event);
+} //Record
+
+/// Append a frame hash to the recording. Call this at the end of every frame.
+/// \param h Hash of the dynamic circles at the end of the frame.
+
+void CRecorder::RecordFrame(UINT h){
+  m_stdHashes.push_back(h);
+} //RecordFrame
+
+/// Save the recording to a text file, one line per input event followed
+/// by one line per frame hash. Input values are written with enough digits
+/// to be read back exactly.
+/// \param fname File name.
+/// \return true if the file was written.
+
+bool CRecorder::Save(const wchar_t* fname) const{
+  FILE* pFile = nullptr;
+  if(_wfopen_s(&pFile, fname, L"wt") != 0)return false;
+
+  fprintf(pFile, "pinball %zu %zu\n", m_stdEvents.size(), m_stdHashes.size());
+
+  for(auto const& e: m_stdEvents)
+    fprintf(pFile, "%u %u %.9g\n", e.m_nSubstep, (UINT)e.m_eInput, e.m_fValue);
+
+  for(auto const& h: m_stdHashes)
+    fprintf(pFile, "%08x\n", h);
+
+  fclose(pFile);
+  return true;
+} //Save
+
+/// Load a recording from a text file written by Save() and get ready
+/// to replay it from the start. 
+/// \param fname File name.
+/// \return true if the file was read.
+
+bool CRecorder::Load(const wchar_t* fname){
+  Clear();
+
+  FILE* pFile = nullptr;
+  if(_wfopen_s(&pFile, fname, L"rt") != 0)return false;
+
+  size_t events = 0, frames = 0; //numbers of events and frames
+  bool bOK = fscanf_s(pFile, "pinball %zu %zu", &events, &frames) == 2;
+
+  for(size_t i=0; i<events && bOK; i++){
+    CInputEvent e;
+    UINT n = 0; //input as an integer
+
+    bOK = fscanf_s(pFile, "%u %u %g", &e.m_nSubstep, &n, &e.m_fValue) == 3 && 
+      n < (UINT)eInput::Size;
+
+    e.m_eInput = (eInput)n;
+    m_stdEvents.push_back(e);
+  } //for
+
+  for(size_t i=0; i<frames && bOK; i++){
+    UINT h = 0; //hash
+    bOK = fscanf_s(pFile, "%x", &h) == 1;
+    m_stdHashes.push_back(h);
+  } //for
+
+  fclose(pFile);
+  if(!bOK)Clear();
+  return bOK;
+} //Load
+
+/// Get the next input event to be replayed if it precedes a given substep.
+/// Call this repeatedly before each substep until it returns false, since
+/// several inputs may precede the same substep.
+/// \param n Index of the substep about to be taken.
+/// \param e [out] The next input event, if there is one for this substep.
+/// \return true if there was an input event for this substep.
+
+bool CRecorder::GetEvent(UINT n, CInputEvent& e){
+  if(m_nNext >= m_stdEvents.size() || m_stdEvents[m_nNext].m_nSubstep > n)
+    return false;
+
+  e = m_stdEvents[m_nNext++];
+  return true;
+} //GetEvent
+
+/// Reader function for the number of frames recorded.
+/// \return Number of frame hashes.
+
+const size_t CRecorder::GetNumFrames() const{
+  return m_stdHashes.size();
+} //GetNumFrames
+
+/// Reader function for a frame hash.
+/// \param i Frame index.
+/// \return Hash at the end of frame i.
+
+const UINT CRecorder::GetHash(size_t i) const{
+  return m_stdHashes[i];
+} //GetHash
@@ -0,0 +1,53 @@
+/// \file Recorder.h
+/// \brief Interface for the input recorder class CRecorder.
+
+#ifndef __L4RC_GAME_RECORDER_H__
+#define __L4RC_GAME_RECORDER_H__
+
+#include <vector>
+
+#include "GameDefines.h"
+
+/// \brief Input event.
+///
+/// One input to the game, stamped with the substep index at
+/// which it took effect.
+
+class CInputEvent{
+  public:
+    UINT m_nSubstep = 0; ///< Index of the substep that this input precedes.
+    eInput m_eInput = eInput::Size; ///< Which input.
+    float m_fValue = 0.0f; ///< Nonzero for flipper up, the random number for a launch, the number of balls for a multiball.
+}; //CInputEvent
+
+/// \brief Input recorder.
+///
+/// The input recorder keeps a list of all of the inputs that drive the
+/// game, that is, flipper key presses and releases and launches together
+/// with the random number that sets the launch speed, each stamped with
+/// the index of the substep that it precedes. It also keeps a hash of the
+/// positions and velocities of the dynamic circles at the end of every
+/// frame. Since the physics is otherwise deterministic, feeding the same
+/// inputs to a new table at the same substeps reproduces the same ball
+/// trajectories, which can be verified by comparing the frame hashes.
+
+class CRecorder{
+  private:
+    std::vector<CInputEvent> m_stdEvents; ///< Input events in the order they happened.
+    std::vector<UINT> m_stdHashes; ///< Hash at the end of each frame.
+    size_t m_nNext = 0; ///< Index of the next event to be replayed.
+
+  public:
+    void Clear(); ///< Clear recording.
+    void Record(UINT, eInput, float); ///< Record an input event.
+    void RecordFrame(UINT); ///< Record a frame hash.
+
+    bool Save(const wchar_t*) const; ///< Save to file.
+    bool Load(const wchar_t*); ///< Load from file.
+
+    bool GetEvent(UINT, CInputEvent&); ///< Get next event for a substep.
+    const size_t GetNumFrames() const; ///< Get number of frames.
+    const UINT GetHash(size_t) const; ///< Get frame hash.
+}; //CRecorder
+
+#endif //__L4RC_GAME_RECORDER_H__
@@ -0,0 +1,338 @@
+/// \file AabbTree.cpp
+/// \brief Code for the dynamic AABB tree class CAabbTree.
+
+#include "AabbTree.h"
+
+/////////////////////////////////////////////////////////////////////////////
+// CAabbTreeNode functions
+
+/// A leaf has no children. Internal nodes always have two.
+/// \return true if this node is a leaf.
+
+bool CAabbTreeNode::IsLeaf() const{
+  return m_nChild0 == -1;
+} //IsLeaf
+
+/////////////////////////////////////////////////////////////////////////////
+// CAabbTree functions
+
+/// Construct an empty AABB tree.
+/// \param d Margin by which shape AABBs are fattened.
+
+CAabbTree::CAabbTree(float d):
+  m_fMargin(d){
+} //constructor
+
+/// Get an unused node, either from the free list or by growing the node
+/// array. Note that growing the array invalidates references to nodes.
+/// \return Index of new node.
+
+int CAabbTree::AllocateNode(){
+  int n = m_nFreeList;
+
+  if(n == -1){ //free list is empty
+    n = (int)m_stdNodes.size();
+    m_stdNodes.push_back(CAabbTreeNode());
+  } //if
+
+  else m_nFreeList = m_stdNodes[n].m_nParent;
+
+  CAabbTreeNode& node = m_stdNodes[n];
+  node.m_pShape = nullptr;
+  node.m_nParent = node.m_nChild0 = node.m_nChild1 = -1;
+  node.m_nHeight = 0;
+
+  return n;
+} //AllocateNode
+
+/// Put a node back on the free list.
+/// \param n Node index.
+
+void CAabbTree::FreeNode(int n){
+  m_stdNodes[n].m_nParent = m_nFreeList;
+  m_stdNodes[n].m_nHeight = -1;
+  m_stdNodes[n].m_pShape = nullptr;
+  m_nFreeList = n;
+} //FreeNode
+
+/// Insert a shape into the tree, storing its proxy id in the shape.
+/// Shapes that are already in a tree are ignored.
+/// \param p Pointer to a shape.
+
+void CAabbTree::Insert(CShape* p){
+  if(p->GetProxyId() != -1)return; //already in
+
+  const int n = AllocateNode();
+  m_stdNodes[n].m_cAABB = p->GetAABB();
+  m_stdNodes[n].m_cAABB.Expand(m_fMargin);
+  m_stdNodes[n].m_pShape = p;
+
+  InsertLeaf(n);
+  p->SetProxyId(n);
+  ++m_nLeafCount;
+} //Insert
+
+/// Remove a shape from the tree. The shape itself is not deleted.
+/// \param p Pointer to a shape.
+
+void CAabbTree::Remove(CShape* p){
+  const int n = p->GetProxyId();
+  if(n == -1)return; //not in
+
+  RemoveLeaf(n);
+  FreeNode(n);
+  p->SetProxyId(-1);
+  --m_nLeafCount;
+} //Remove
+
+/// Update a shape that may have moved. If its AABB is still inside its
+/// fat AABB then nothing happens, otherwise it is removed and reinserted
+/// with a new fat AABB.
+/// \param p Pointer to a shape.
+/// \return true if the shape had to be reinserted.
+
+bool CAabbTree::Update(CShape* p){
+  const int n = p->GetProxyId();
+  FailIf(n == -1); //not in
+  FailIf(m_stdNodes[n].m_cAABB.Contains(p->GetAABB())); //still inside fat AABB
+
+  RemoveLeaf(n);
+  m_stdNodes[n].m_cAABB = p->GetAABB();
+  m_stdNodes[n].m_cAABB.Expand(m_fMargin);
+  InsertLeaf(n);
+
+  return true;
+} //Update
+
+/// Remove all shapes from the tree and reset their proxy ids.
+
+void CAabbTree::Clear(){
+  for(auto& node: m_stdNodes)
+    if(node.m_nHeight == 0 && node.m_pShape)
+      node.m_pShape->SetProxyId(-1);
+
+  m_stdNodes.clear();
+  m_nRoot = m_nFreeList = -1;
+  m_nLeafCount = 0;
+} //Clear
+
+/// Insert a leaf into the tree. The sibling is found by walking down from the
+/// root, at each level choosing the child that would increase the total
+/// perimeter of the tree the least. The sibling is replaced by a new internal
+/// node whose children are the sibling and the new leaf.
+/// \param leaf Index of leaf node.
+
+void CAabbTree::InsertLeaf(int leaf){
+  if(m_nRoot == -1){ //empty tree
+    m_nRoot = leaf;
+    m_stdNodes[leaf].m_nParent = -1;
+    return;
+  } //if
+
+  //find the best sibling
+
+  const CAabb2D leafAABB = m_stdNodes[leaf].m_cAABB;
+  int n = m_nRoot;
+
+  while(!m_stdNodes[n].IsLeaf()){
+    const CAabbTreeNode& node = m_stdNodes[n];
+
+    CAabb2D combined = node.m_cAABB;
+    combined += leafAABB;
+    const float cost = 2.0f*combined.GetPerimeter(); //cost of new parent here
+    const float inherited = 2.0f*(combined.GetPerimeter() - node.m_cAABB.GetPerimeter()); //cost of pushing leaf down
+
+    float childcost[2]; //cost of descending into each child
+
+    for(int i=0; i<2; i++){
+      const CAabbTreeNode& child = m_stdNodes[i == 0? node.m_nChild0: node.m_nChild1];
+      CAabb2D aabb = child.m_cAABB;
+      aabb += leafAABB;
+
+      if(child.IsLeaf())
+        childcost[i] = aabb.GetPerimeter() + inherited;
+      else childcost[i] = aabb.GetPerimeter() - child.m_cAABB.GetPerimeter() + inherited;
+    } //for
+
+    if(cost < childcost[0] && cost < childcost[1])break; //stop here
+
+    n = childcost[0] < childcost[1]? node.m_nChild0: node.m_nChild1;
+  } //while
+
+  //make a new parent for the sibling and the leaf
+
+  const int sibling = n;
+  const int oldparent = m_stdNodes[sibling].m_nParent;
+  const int newparent = AllocateNode(); //may invalidate node references
+
+  CAabbTreeNode& parent = m_stdNodes[newparent];
+  parent.m_nParent = oldparent;
+  parent.m_cAABB = leafAABB;
+  parent.m_cAABB += m_stdNodes[sibling].m_cAABB;
+  parent.m_nHeight = m_stdNodes[sibling].m_nHeight + 1;
+  parent.m_nChild0 = sibling;
+  parent.m_nChild1 = leaf;
+
+  m_stdNodes[sibling].m_nParent = newparent;
+  m_stdNodes[leaf].m_nParent = newparent;
+
+  if(oldparent == -1) //sibling was the root
+    m_nRoot = newparent;
+
+  else if(m_stdNodes[oldparent].m_nChild0 == sibling)
+    m_stdNodes[oldparent].m_nChild0 = newparent;
+  else m_stdNodes[oldparent].m_nChild1 = newparent;
+
+  Refit(oldparent);
+} //InsertLeaf
+
+/// Remove a leaf from the tree. Its parent is removed too, and the leaf's
+/// sibling takes the parent's place. The leaf node is not freed.
+/// \param leaf Index of leaf node.
+
+void CAabbTree::RemoveLeaf(int leaf){
+  if(leaf == m_nRoot){ //only node
+    m_nRoot = -1;
+    return;
+  } //if
+
+  const int parent = m_stdNodes[leaf].m_nParent;
+  const int grandparent = m_stdNodes[parent].m_nParent;
+  const int sibling = m_stdNodes[parent].m_nChild0 == leaf?
+    m_stdNodes[parent].m_nChild1: m_stdNodes[parent].m_nChild0;
+
+  if(grandparent == -1){ //parent was the root
+    m_nRoot = sibling;
+    m_stdNodes[sibling].m_nParent = -1;
+  } //if
+
+  else{
+    if(m_stdNodes[grandparent].m_nChild0 == parent)
+      m_stdNodes[grandparent].m_nChild0 = sibling;
+    else m_stdNodes[grandparent].m_nChild1 = sibling;
+
+    m_stdNodes[sibling].m_nParent = grandparent;
+  } //else
+
+  FreeNode(parent);
+  Refit(grandparent);
+} //RemoveLeaf
+
+/// Walk from a node up to the root, balancing each subtree
+/// on the way and recomputing AABBs and heights.
+/// \param n Index of first node, may be -1.
+
+void CAabbTree::Refit(int n){
+  while(n != -1){
+    n = Balance(n);
+
+    CAabbTreeNode& node = m_stdNodes[n];
+    const CAabbTreeNode& child0 = m_stdNodes[node.m_nChild0];
+    const CAabbTreeNode& child1 = m_stdNodes[node.m_nChild1];
+
+    node.m_nHeight = 1 + max(child0.m_nHeight, child1.m_nHeight);
+    node.m_cAABB = child0.m_cAABB;
+    node.m_cAABB += child1.m_cAABB;
+
+    n = node.m_nParent;
+  } //while
+} //Refit
+
+/// If one child of an internal node is more than one level taller than
+/// the other, then rotate the taller child up into the node's place.
+/// The taller child's shorter grandchild is given to the node.
+/// \param a Index of an internal node.
+/// \return Index of the node now at the root of this subtree.
+
+int CAabbTree::Balance(int a){
+  CAabbTreeNode& A = m_stdNodes[a];
+  if(A.IsLeaf() || A.m_nHeight < 2)return a;
+
+  const int b = A.m_nChild0;
+  const int c = A.m_nChild1;
+  const int diff = m_stdNodes[c].m_nHeight - m_stdNodes[b].m_nHeight;
+
+  if(diff >= -1 && diff <= 1)return a; //balanced
+
+  const int up = diff > 0? c: b; //taller child, moves up
+  const int other = diff > 0? b: c; //shorter child, stays put
+  CAabbTreeNode& U = m_stdNodes[up];
+
+  const int f = U.m_nChild0;
+  const int g = U.m_nChild1;
+  const bool bKeepF = m_stdNodes[f].m_nHeight > m_stdNodes[g].m_nHeight;
+  const int keep = bKeepF? f: g; //taller grandchild stays with up
+  const int give = bKeepF? g: f; //shorter grandchild goes to a
+
+  //up replaces a
+
+  U.m_nChild0 = a;
+  U.m_nChild1 = keep;
+  U.m_nParent = A.m_nParent;
+  A.m_nParent = up;
+
+  if(U.m_nParent == -1)
+    m_nRoot = up;
+  else if(m_stdNodes[U.m_nParent].m_nChild0 == a)
+    m_stdNodes[U.m_nParent].m_nChild0 = up;
+  else m_stdNodes[U.m_nParent].m_nChild1 = up;
+
+  //a keeps its shorter child and adopts the shorter grandchild
+
+  A.m_nChild0 = other;
+  A.m_nChild1 = give;
+  m_stdNodes[give].m_nParent = a;
+
+  A.m_cAABB = m_stdNodes[other].m_cAABB;
+  A.m_cAABB += m_stdNodes[give].m_cAABB;
+  A.m_nHeight = 1 + max(m_stdNodes[other].m_nHeight, m_stdNodes[give].m_nHeight);
+
+  U.m_cAABB = A.m_cAABB;
+  U.m_cAABB += m_stdNodes[keep].m_cAABB;
+  U.m_nHeight = 1 + max(A.m_nHeight, m_stdNodes[keep].m_nHeight);
+
+  return up;
+} //Balance
+
+/// Get the shapes whose fat AABBs overlap a given AABB. This doesn't test
+/// the shapes' own AABBs, so some of the shapes found may not actually
+/// overlap it.
+/// \param aabb An AABB.
+/// \param result [out] List of shapes whose fat AABBs overlap aabb.
+
+void CAabbTree::Query(const CAabb2D& aabb, std::vector<CShape*>& result){
+  result.clear();
+  if(m_nRoot == -1)return; //empty tree
+
+  m_stdStack.clear();
+  m_stdStack.push_back(m_nRoot);
+
+  while(!m_stdStack.empty()){
+    const CAabbTreeNode& node = m_stdNodes[m_stdStack.back()];
+    m_stdStack.pop_back();
+
+    if(node.m_cAABB && aabb){
+      if(node.IsLeaf())
+        result.push_back(node.m_pShape);
+
+      else{
+        m_stdStack.push_back(node.m_nChild0);
+        m_stdStack.push_back(node.m_nChild1);
+      } //else
+    } //if
+  } //while
+} //Query
+
+/// Reader function for the height of the tree.
+/// \return Height of tree, -1 if empty.
+
+const int CAabbTree::GetHeight() const{
+  return m_nRoot == -1? -1: m_stdNodes[m_nRoot].m_nHeight;
+} //GetHeight
+
+/// Reader function for the number of shapes in the tree.
+/// \return Number of shapes.
+
+const int CAabbTree::GetSize() const{
+  return m_nLeafCount;
+} //GetSize
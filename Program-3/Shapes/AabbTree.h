@@ -0,0 +1,76 @@
+/// \file AabbTree.h
+/// \brief Interface for the dynamic AABB tree class CAabbTree.
+
+#ifndef __L4RC_PHYSICS_AABBTREE_H__
+#define __L4RC_PHYSICS_AABBTREE_H__
+
+#include <vector>
+
+#include "Shape.h"
+
+/// \brief AABB tree node.
+///
+/// A node in an AABB tree. Leaves point to a shape, internal nodes have
+/// exactly two children. Nodes that aren't in use are kept in a free list
+/// threaded through m_nParent.
+
+class CAabbTreeNode{
+  public:
+    CAabb2D m_cAABB; ///< Fattened AABB, covers children if internal.
+    CShape* m_pShape = nullptr; ///< Pointer to shape if leaf.
+
+    int m_nParent = -1; ///< Parent node, or next free node if not in use.
+    int m_nChild0 = -1; ///< First child, -1 if leaf.
+    int m_nChild1 = -1; ///< Second child, -1 if leaf.
+    int m_nHeight = -1; ///< Height of subtree, 0 for leaf, -1 if not in use.
+
+    bool IsLeaf() const; ///< Is this a leaf?
+}; //CAabbTreeNode
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Dynamic AABB tree.
+///
+/// A dynamic AABB tree is a binary tree of AABBs that is used to find the
+/// shapes that might collide with a dynamic circle when those shapes move too
+/// often to be put into a uniform grid. Each shape is stored in a leaf whose
+/// AABB is the shape's AABB fattened by a small margin. A shape that moves but
+/// stays inside its fat AABB doesn't need to be touched, so kinematic shapes
+/// such as flippers are removed and reinserted only once every few steps
+/// while they are moving, and not at all while they are parked. The tree is
+/// kept balanced using rotations, and nodes are stored in a single array.
+
+class CAabbTree{
+  private:
+    std::vector<CAabbTreeNode> m_stdNodes; ///< Node array.
+    int m_nRoot = -1; ///< Root node, -1 if tree is empty.
+    int m_nFreeList = -1; ///< First free node, -1 if none.
+    int m_nLeafCount = 0; ///< Number of leaves.
+
+    float m_fMargin = 0.0f; ///< Distance by which leaf AABBs are fattened.
+
+    std::vector<int> m_stdStack; ///< Stack for tree traversal.
+
+    int AllocateNode(); ///< Get a node from the free list.
+    void FreeNode(int); ///< Put a node back on the free list.
+
+    void InsertLeaf(int); ///< Insert a leaf into the tree.
+    void RemoveLeaf(int); ///< Remove a leaf from the tree.
+    int Balance(int); ///< Rotate to balance a subtree.
+    void Refit(int); ///< Refit AABBs and heights from a node up to the root.
+
+  public:
+    CAabbTree(float =8.0f); ///< Constructor.
+
+    void Insert(CShape*); ///< Insert a shape.
+    void Remove(CShape*); ///< Remove a shape.
+    bool Update(CShape*); ///< Update a shape that may have moved.
+    void Clear(); ///< Remove all shapes.
+
+    void Query(const CAabb2D&, std::vector<CShape*>&); ///< Get shapes overlapping an AABB.
+
+    const int GetHeight() const; ///< Get tree height.
+    const int GetSize() const; ///< Get number of shapes.
+}; //CAabbTree
+
+#endif //__L4RC_PHYSICS_AABBTREE_H__
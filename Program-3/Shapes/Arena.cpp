@@ -0,0 +1,88 @@
+/// \file Arena.cpp
+/// \brief Code for the arena class CArena.
+
+#include "Arena.h"
+
+/// Construct an empty arena. No memory is allocated until it is needed.
+/// \param n Default block size in bytes.
+
+CArena::CArena(size_t n):
+  m_nBlockSize(n){
+} //constructor
+
+/// Destruct everything made by Make() and give the blocks back to the heap.
+
+CArena::~CArena(){
+  Reset();
+
+  for(auto const& b: m_stdBlocks)
+    ::operator delete(b.m_pData);
+} //destructor
+
+/// Allocate memory from the current block, moving on to the next block
+/// if it doesn't fit. A block that is too small for the request is skipped,
+/// and a new block is allocated if there are no more blocks. A request
+/// larger than the default block size gets a block of its own.
+/// \param n Number of bytes.
+/// \param align Alignment, which must be a power of two no larger than
+///   the alignment of std::max_align_t.
+/// \return Pointer to the memory.
+
+void* CArena::Allocate(size_t n, size_t align){
+  while(m_nBlock < m_stdBlocks.size()){ //try the blocks we already have
+    const CBlock& b = m_stdBlocks[m_nBlock];
+    const size_t start = (m_nUsed + align - 1) & ~(align - 1); //aligned offset
+
+    if(start + n <= b.m_nSize){ //it fits
+      m_nUsed = start + n;
+      m_nBytes += n;
+      return b.m_pData + start;
+    } //if
+
+    ++m_nBlock; //move on to the next block
+    m_nUsed = 0;
+  } //while
+
+  //out of blocks, so get a new one
+
+  const size_t size = max(n, m_nBlockSize);
+  CBlock b = {(char*)::operator new(size), size};
+
+  m_stdBlocks.push_back(b);
+  m_nBlock = m_stdBlocks.size() - 1;
+  m_nUsed = n;
+  m_nBytes += n;
+
+  return b.m_pData;
+} //Allocate
+
+/// Call the destructors of everything made by Make(), most recent first,
+/// and rewind to the start of the first block. The blocks are kept for reuse.
+/// Anything allocated from the arena must not be used after this.
+
+void CArena::Reset(){
+  for(auto i=m_stdDestructors.rbegin(); i!=m_stdDestructors.rend(); i++)
+    i->m_pFunc(i->m_pObject);
+
+  m_stdDestructors.clear();
+  m_nBlock = m_nUsed = m_nBytes = 0;
+} //Reset
+
+/// Reader function for the number of bytes handed out since the last reset.
+/// \return Number of bytes, not counting alignment padding.
+
+const size_t CArena::GetSize() const{
+  return m_nBytes;
+} //GetSize
+
+/// Reader function for the total size of the blocks.
+/// \return Number of bytes in all blocks.
+
+const size_t CArena::GetCapacity() const{
+  size_t n = 0;
+
+  for(auto const& b: m_stdBlocks)
+    n += b.m_nSize;
+
+  return n;
+} //GetCapacity
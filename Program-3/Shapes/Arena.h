@@ -0,0 +1,177 @@
+/// \file Arena.h
+/// \brief Interface for the arena class CArena and the arena list class CArenaList.
+
+#ifndef __L4RC_PHYSICS_ARENA_H__
+#define __L4RC_PHYSICS_ARENA_H__
+
+#include <new>
+#include <cassert>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+#include "VectorMath.h"
+
+/// \brief Arena.
+///
+/// A monotonic allocator. Memory is handed out from the end of the current
+/// block, and blocks are only given back to the heap when the arena is
+/// destroyed. Nothing can be freed individually. Instead, Reset() destructs
+/// everything made by Make() and rewinds to the start of the first block, so
+/// that the same memory is used again for whatever is made next without
+/// going back to the heap. Objects whose destructors do nothing cost nothing
+/// to reset, since their destructors aren't recorded.
+
+class CArena{
+  private:
+    /// \brief Destructor record.
+    ///
+    /// A pointer to an object and a function that destructs it.
+
+    class CDestructor{
+      public:
+        void (*m_pFunc)(void*); ///< Function that calls the destructor.
+        void* m_pObject; ///< Pointer to object.
+    }; //CDestructor
+
+    /// \brief Block of memory.
+
+    class CBlock{
+      public:
+        char* m_pData; ///< Pointer to the start of the block.
+        size_t m_nSize; ///< Size of the block in bytes.
+    }; //CBlock
+
+    std::vector<CBlock> m_stdBlocks; ///< Blocks, in the order they are used.
+    std::vector<CDestructor> m_stdDestructors; ///< Destructors to call on reset.
+
+    size_t m_nBlockSize = 0; ///< Default size of a new block in bytes.
+    size_t m_nBlock = 0; ///< Index of the current block.
+    size_t m_nUsed = 0; ///< Number of bytes used in the current block.
+    size_t m_nBytes = 0; ///< Number of bytes handed out since the last reset.
+
+    template<class T> static void Destruct(void*); ///< Call a destructor.
+
+  public:
+    CArena(size_t =65536); ///< Constructor.
+    ~CArena(); ///< Destructor.
+
+    CArena(const CArena&) = delete; ///< No copying.
+    CArena& operator=(const CArena&) = delete; ///< No assignment.
+
+    void* Allocate(size_t, size_t); ///< Allocate raw memory.
+    template<class T, class... Args> T* Make(Args&&...); ///< Make an object.
+    void Reset(); ///< Destruct everything and start again.
+
+    const size_t GetSize() const; ///< Get number of bytes in use.
+    const size_t GetCapacity() const; ///< Get number of bytes in blocks.
+}; //CArena
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Arena list.
+///
+/// A list of objects of the same type stored in pages of N objects that are
+/// allocated from an arena, so that objects of the same type sit next to each
+/// other in memory and never move once they have been made. Objects can be
+/// added to the end but not removed, except all at once by Clear(), which
+/// must be called before the arena is reset. The objects' destructors are
+/// never called, so T must not own any resources.
+
+template<class T, UINT N=64> class CArenaList{
+  private:
+    CArena* m_pArena = nullptr; ///< Arena to allocate pages from.
+    std::vector<T*> m_stdPages; ///< Pages of N objects each.
+    UINT m_nSize = 0; ///< Number of objects.
+
+  public:
+    CArenaList(CArena*); ///< Constructor.
+
+    template<class... Args> T& Add(Args&&...); ///< Make an object at the end.
+    T& operator[](UINT); ///< Get an object.
+    T* Get(UINT); ///< Get an object if there is one.
+    const UINT GetSize() const; ///< Get number of objects.
+    void Clear(); ///< Forget all objects.
+}; //CArenaList
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// CArena template functions
+
+/// Call the destructor of an object of type T.
+/// \param p Pointer to an object of type T.
+
+template<class T> void CArena::Destruct(void* p){
+  ((T*)p)->~T();
+} //Destruct
+
+/// Make an object in the arena. Its destructor will be called by Reset()
+/// or by the arena's destructor unless it is trivial.
+/// \param args Arguments for T's constructor.
+/// \return Pointer to the new object.
+
+template<class T, class... Args> T* CArena::Make(Args&&... args){
+  T* p = new(Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+  if(!std::is_trivially_destructible<T>::value)
+    m_stdDestructors.push_back({&Destruct<T>, p});
+
+  return p;
+} //Make
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// CArenaList template functions
+
+/// Construct an empty list.
+/// \param p Pointer to the arena that pages are to be allocated from.
+
+template<class T, UINT N> CArenaList<T, N>::CArenaList(CArena* p):
+  m_pArena(p){
+} //constructor
+
+/// Make an object at the end of the list, starting a new page if necessary.
+/// \param args Arguments for T's constructor.
+/// \return Reference to the new object.
+
+template<class T, UINT N> template<class... Args> T& CArenaList<T, N>::Add(Args&&... args){
+  if(m_nSize == N*(UINT)m_stdPages.size()) //out of room, so get a new page
+    m_stdPages.push_back((T*)m_pArena->Allocate(N*sizeof(T), alignof(T)));
+
+  T* p = new(m_stdPages[m_nSize/N] + m_nSize%N) T(std::forward<Args>(args)...);
+  ++m_nSize;
+
+  return *p;
+} //Add
+
+/// Get an object by its index.
+/// \param i Index, which must be less than the number of objects.
+/// \return Reference to the object.
+
+template<class T, UINT N> T& CArenaList<T, N>::operator[](UINT i){
+  assert(i < m_nSize);
+  return m_stdPages[i/N][i%N];
+} //operator[]
+
+/// Get an object by its index, checking the index first.
+/// \param i Index.
+/// \return Pointer to the object, nullptr if the index is out of range.
+
+template<class T, UINT N> T* CArenaList<T, N>::Get(UINT i){
+  return i < m_nSize? &m_stdPages[i/N][i%N]: nullptr;
+} //Get
+
+/// Reader function for the number of objects.
+/// \return Number of objects.
+
+template<class T, UINT N> const UINT CArenaList<T, N>::GetSize() const{
+  return m_nSize;
+} //GetSize
+
+/// Forget all of the objects and pages. The pages belong to the arena,
+/// so the memory isn't reused until the arena is reset.
+
+template<class T, UINT N> void CArenaList<T, N>::Clear(){
+  m_stdPages.clear();
+  m_nSize = 0;
+} //Clear
+
+#endif //__L4RC_PHYSICS_ARENA_H__
@@ -0,0 +1,281 @@
+/// \file CapsuleShape.cpp
+/// \brief Code for CCapsuleDesc, CCapsuleShape, and CKinematicCapsuleShape.
+
+#include "CapsuleShape.h"
+#include "DynamicCircle.h"
+#include "Contact.h"
+
+/////////////////////////////////////////////////////////////////////////////
+// CCapsuleDesc functions
+
+/// The default contructor creates a capsule descriptor with both ends at
+/// the origin.
+
+CCapsuleDesc::CCapsuleDesc(): CShapeDesc(eShape::Capsule){
+} //constructor
+
+/// This constructor creates a capsule descriptor given the centers and radii
+/// of its ends and its elasticity.
+/// \param p0 Center of end 0.
+/// \param r0 Radius of end 0.
+/// \param p1 Center of end 1.
+/// \param r1 Radius of end 1.
+/// \param e Elasticity, defaults to 1.0f.
+
+CCapsuleDesc::CCapsuleDesc(const Vector2& p0, float r0, const Vector2& p1, float r1, float e):
+  CShapeDesc(eShape::Capsule), m_vPt0(p0), m_vPt1(p1), m_fRadius0(r0), m_fRadius1(r1)
+{
+  m_vPos = p0;
+  m_fElasticity = e;
+} //constructor
+
+/////////////////////////////////////////////////////////////////////////////
+// CCapsuleShape functions
+
+/// Constructs a capsule described by a capsule descriptor. If the tangents
+/// make angle \f$\theta\f$ with the axis then
+/// \f$\sin\theta = (r_0 - r_1)/L\f$, where \f$L\f$ is the distance between
+/// the centers. This is clamped to \f$[-1, 1]\f$ so that a capsule with one
+/// end inside the other doesn't give a NaN.
+/// \param r Capsule descriptor.
+
+CCapsuleShape::CCapsuleShape(const CCapsuleDesc& r):
+  CShape(r), m_vPt0(r.m_vPt0), m_vPt1(r.m_vPt1),
+  m_fRadius0(r.m_fRadius0), m_fRadius1(r.m_fRadius1)
+{
+  const Vector2 u = m_vPt1 - m_vPt0;
+  m_fLength = u.Length();
+  m_vAxis = m_fLength > 0.0f? u/m_fLength: Vector2(1.0f, 0.0f);
+
+  m_fSin = m_fLength > 0.0f? (m_fRadius0 - m_fRadius1)/m_fLength: 0.0f;
+  m_fSin = min(max(m_fSin, -1.0f), 1.0f);
+  m_fCos = sqrtf(1.0f - sqr(m_fSin));
+
+  SetPos(m_vPt0);
+  UpdateAABB();
+} //constructor
+
+/// Update the AABB from the end circles. Since the capsule is the convex
+/// hull of its ends, the AABB of the ends is the AABB of the capsule, and
+/// its corners can be found directly instead of one point at a time.
+
+void CCapsuleShape::UpdateAABB(){
+  const Vector2 p = m_vPt1 - m_vPt0; //end 1 relative to position
+  const float r0 = m_fRadius0;
+  const float r1 = m_fRadius1;
+
+  SetAABBPoint(Vector2(min(-r0, p.x - r1), min(-r0, p.y - r1)));
+  AddAABBPoint(Vector2(max(r0, p.x + r1), max(r0, p.y + r1)));
+} //UpdateAABB
+
+/// Collision detection with a dynamic circle. Let \f$u\f$ be the distance of
+/// the dynamic circle's center along the axis from the center of end 0 and
+/// \f$w\f$ its distance from the axis. The tangent on the dynamic circle's
+/// side of the axis has outward normal
+/// \f$m = \cos\theta\,n + \sin\theta\,d\f$, where \f$d\f$ is the axis and
+/// \f$n\f$ the unit normal to the axis on that side, and
+/// \f$k = u\cos\theta - w\sin\theta\f$ is how far the foot of the
+/// perpendicular from the center to the tangent is along the tangent from
+/// where it touches end 0. If \f$k < 0\f$ then the closest point is on end 0,
+/// if \f$k > L\cos\theta\f$ then it is on end 1, and otherwise it is on the
+/// tangent, at distance \f$w\cos\theta + u\sin\theta - r_0\f$. This works
+/// for a center inside the capsule too, so there is always exactly one
+/// contact and no square roots are needed unless the closest point is on
+/// one of the ends.
+/// \param c [in, out] Contact descriptor for this collision.
+/// \return true is there was a collision.
+
+bool CCapsuleShape::PreCollide(CContactDesc& c){
+  if(!m_bCanCollide)return false; //bail and fail
+
+  CDynamicCircle* pCirc = c.m_pCircle;
+  const Vector2 p = pCirc->GetPos();
+  const float r = pCirc->GetRadius();
+
+  const Vector2 q = p - m_vPt0; //center relative to end 0
+  const Vector2 n = perp(m_vAxis); //normal to axis
+  const float u = m_vAxis.Dot(q); //distance along axis
+  const float wn = n.Dot(q); //signed distance from axis
+  const float w = fabsf(wn); //distance from axis
+  const float k = m_fCos*u - m_fSin*w; //distance along tangent
+
+  if(k < 0.0f || k > m_fCos*m_fLength){ //closest point is on an end
+    const bool bEnd0 = k < 0.0f;
+    const Vector2& center = bEnd0? m_vPt0: m_vPt1;
+    const float radius = bEnd0? m_fRadius0: m_fRadius1;
+
+    const Vector2 v = p - center;
+    const float dsq = v.LengthSquared(); //distance squared
+    FailIf(dsq >= sqr(radius + r + c.m_fMargin));
+
+    const float d = sqrtf(dsq);
+    c.m_vNorm = d > 0.0f? v/d: m_vAxis*(bEnd0? -1.0f: 1.0f);
+    c.m_vPOI = center + radius*c.m_vNorm;
+    c.m_fSetback = d - radius - r;
+  } //if
+
+  else{ //closest point is on a tangent
+    const Vector2 m = m_fCos*(wn < 0.0f? -n: n) + m_fSin*m_vAxis; //outward normal
+    const float d = m_fCos*w + m_fSin*u - m_fRadius0; //distance outside tangent
+    FailIf(d - r >= c.m_fMargin);
+
+    c.m_vNorm = m;
+    c.m_vPOI = p - d*m;
+    c.m_fSetback = d - r;
+  } //else
+
+  c.m_fSpeed = pCirc->GetVel().Length();
+
+  return true;
+} //PreCollide
+
+/// Swept collision detection with a dynamic circle. The circle moves in a
+/// straight line from its current position by displacement v as time goes
+/// from 0 to 1, and hits an end when its center is one radius outside it, or
+/// a tangent when its center is one radius outside the tangent's line and
+/// the foot of its perpendicular is between the points where the tangent
+/// touches the ends. Since the ends are inside the capsule, the earliest
+/// hit on either of them can't be earlier than the earliest hit on the
+/// capsule, so the ends need no such test. A circle that is already touching
+/// this capsule is left to PreCollide().
+/// \param c [in, out] Contact descriptor for this collision.
+/// \param v Displacement of the dynamic circle.
+/// \param t [in, out] Earliest time of impact found so far.
+/// \return true if there was a collision before time t.
+
+bool CCapsuleShape::TimeOfImpact(CContactDesc& c, const Vector2& v, float& t){
+  if(!m_bCanCollide)return false; //bail and fail
+
+  CDynamicCircle* pCirc = c.m_pCircle;
+  const Vector2 p = pCirc->GetPos();
+  const float r = pCirc->GetRadius();
+
+  CContactDesc cd(c); //touching test, with no margin
+  cd.m_fMargin = 0.0f;
+  FailIf(PreCollide(cd)); //already touching
+
+  bool bHit = false; //whether there was a hit before time t
+  Vector2 poi; //point of impact
+
+  for(int i=0; i<2; i++){ //tangents
+    const Vector2 n = (i == 0? 1.0f: -1.0f)*perp(m_vAxis); //normal to axis
+    const Vector2 m = m_fCos*n + m_fSin*m_vAxis; //outward normal
+    const float d = m.Dot(p - m_vPt0) - m_fRadius0 - r; //distance outside tangent
+    const float dv = m.Dot(v); //change in distance
+
+    if(d > 0.0f && dv < 0.0f && d < -t*dv){ //approaching, in time
+      const float s = -d/dv; //time at which distance is r
+      const Vector2 p2 = p + s*v; //center of circle at time of impact
+      const Vector2 q = p2 - m_vPt0;
+      const float k = m_fCos*m_vAxis.Dot(q) - m_fSin*n.Dot(q); //distance along tangent
+
+      if(k >= 0.0f && k <= m_fCos*m_fLength){ //between the ends
+        t = s;
+        poi = p2 - r*m;
+        bHit = true;
+      } //if
+    } //if
+  } //for
+
+  if(CircleTOI(p, v, m_vPt0, m_fRadius0 + r, t)){
+    poi = m_vPt0 + m_fRadius0*Normalize(p + t*v - m_vPt0);
+    bHit = true;
+  } //if
+
+  if(CircleTOI(p, v, m_vPt1, m_fRadius1 + r, t)){
+    poi = m_vPt1 + m_fRadius1*Normalize(p + t*v - m_vPt1);
+    bHit = true;
+  } //if
+
+  FailIf(!bHit);
+
+  c.m_pShape = this;
+  c.m_vPOI = poi;
+  c.m_fSetback = 0.0f;
+  c.m_fSpeed = pCirc->GetVel().Length();
+  c.m_vNorm = Normalize(p + t*v - poi);
+
+  return true;
+} //TimeOfImpact
+
+/// Reader function for the center of end 0.
+/// \return Center of end 0.
+
+const Vector2& CCapsuleShape::GetPt0() const{
+  return m_vPt0;
+} //GetPt0
+
+/// Reader function for the center of end 1.
+/// \return Center of end 1.
+
+const Vector2& CCapsuleShape::GetPt1() const{
+  return m_vPt1;
+} //GetPt1
+
+/// Reader function for the axis.
+/// \return Unit vector from the center of end 0 to the center of end 1.
+
+const Vector2& CCapsuleShape::GetAxis() const{
+  return m_vAxis;
+} //GetAxis
+
+/// Reader function for the radius of end 0.
+/// \return Radius of end 0.
+
+const float CCapsuleShape::GetRadius0() const{
+  return m_fRadius0;
+} //GetRadius0
+
+/// Reader function for the radius of end 1.
+/// \return Radius of end 1.
+
+const float CCapsuleShape::GetRadius1() const{
+  return m_fRadius1;
+} //GetRadius1
+
+/// Reader function for the sine of the angle between the axis and the
+/// tangents, which is positive if end 0 is the larger end.
+/// \return Sine of the tangent angle.
+
+const float CCapsuleShape::GetSin() const{
+  return m_fSin;
+} //GetSin
+
+/////////////////////////////////////////////////////////////////////////////
+// CKinematicCapsuleShape functions
+
+/// Constructs a kinematic capsule described by a capsule descriptor.
+/// \param r Capsule descriptor.
+
+CKinematicCapsuleShape::CKinematicCapsuleShape(const CCapsuleDesc& r):
+  CCapsuleShape(r), m_vOldPt0(m_vPt0), m_vOldPt1(m_vPt1), m_vOldAxis(m_vAxis)
+{
+  m_eMotionType = eMotion::Kinematic;
+} //constructor
+
+/// Rotate to a given orientation from original orientation. The end centers
+/// are rotated about the center of rotation and the axis about the origin,
+/// which leaves the length and the tangent angle unchanged.
+/// \param v Center of rotation.
+/// \param s Sine of the angle increment from original orientation.
+/// \param c Cosine of the angle increment from original orientation.
+
+void CKinematicCapsuleShape::Rotate(const Vector2& v, float s, float c){
+  m_vPt0 = RotatePt(m_vOldPt0, v, s, c);
+  m_vPt1 = RotatePt(m_vOldPt1, v, s, c);
+  m_vAxis = RotatePt(m_vOldAxis, Vector2(0.0f), s, c);
+
+  SetPos(m_vPt0);
+  UpdateAABB();
+} //Rotate
+
+/// Reset to original orientation.
+
+void CKinematicCapsuleShape::Reset(){
+  m_vPt0 = m_vOldPt0;
+  m_vPt1 = m_vOldPt1;
+  m_vAxis = m_vOldAxis;
+
+  SetPos(m_vPt0);
+  UpdateAABB();
+} //Reset
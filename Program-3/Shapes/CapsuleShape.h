@@ -0,0 +1,86 @@
+/// \file CapsuleShape.h
+/// \brief Interface for CCapsuleDesc, CCapsuleShape, and CKinematicCapsuleShape.
+
+#ifndef __L4RC_PHYSICS_CAPSULESHAPE_H__
+#define __L4RC_PHYSICS_CAPSULESHAPE_H__
+
+#include "Shape.h"
+
+/// \brief Capsule descriptor.
+///
+/// The capsule descriptor describes a tapered capsule by the centers and
+/// radii of its two end circles. The position is the center of end 0.
+
+class CCapsuleDesc: public CShapeDesc{
+  public:
+    Vector2 m_vPt0; ///< Center of end 0.
+    Vector2 m_vPt1; ///< Center of end 1.
+    float m_fRadius0 = 0.0f; ///< Radius of end 0.
+    float m_fRadius1 = 0.0f; ///< Radius of end 1.
+
+    CCapsuleDesc(); ///< Constructor.
+    CCapsuleDesc(const Vector2&, float, const Vector2&, float, float =1.0f); ///< Constructor.
+}; //CCapsuleDesc
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Capsule shape.
+///
+/// A tapered capsule is the convex hull of two circles of possibly different
+/// radii, that is, the two circles joined by their two common outer tangents,
+/// which is the shape of a pinball flipper. The centers of the circles must
+/// be further apart than the difference between their radii. Collision
+/// detection with a dynamic circle is a single closest point query that gives
+/// one contact whichever of the four pieces of the boundary is closest, so a
+/// dynamic circle where a tangent meets an end circle is hit once, not once
+/// by each of them.
+
+class CCapsuleShape: public CShape{
+  protected:
+    Vector2 m_vPt0; ///< Center of end 0.
+    Vector2 m_vPt1; ///< Center of end 1.
+    Vector2 m_vAxis; ///< Unit vector from end 0 to end 1.
+    float m_fRadius0 = 0.0f; ///< Radius of end 0.
+    float m_fRadius1 = 0.0f; ///< Radius of end 1.
+    float m_fLength = 0.0f; ///< Distance between centers.
+    float m_fSin = 0.0f; ///< Sine of the angle between the axis and the tangents.
+    float m_fCos = 1.0f; ///< Cosine of the angle between the axis and the tangents.
+
+    void UpdateAABB(); ///< Update AABB from the end circles.
+
+  public:
+    CCapsuleShape(const CCapsuleDesc&); ///< Constructor.
+
+    bool PreCollide(CContactDesc&); ///< Collision detection.
+    bool TimeOfImpact(CContactDesc&, const Vector2&, float&); ///< Swept collision detection.
+
+    const Vector2& GetPt0() const; ///< Get center of end 0.
+    const Vector2& GetPt1() const; ///< Get center of end 1.
+    const Vector2& GetAxis() const; ///< Get axis.
+    const float GetRadius0() const; ///< Get radius of end 0.
+    const float GetRadius1() const; ///< Get radius of end 1.
+    const float GetSin() const; ///< Get sine of tangent angle.
+}; //CCapsuleShape
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Kinematic capsule shape.
+///
+/// A capsule whose motion type is KINEMATIC. The end centers and the axis are
+/// rotated together from their original orientation, so nothing else needs
+/// to be recomputed.
+
+class CKinematicCapsuleShape: public CCapsuleShape{
+  private:
+    Vector2 m_vOldPt0; ///< Original center of end 0.
+    Vector2 m_vOldPt1; ///< Original center of end 1.
+    Vector2 m_vOldAxis; ///< Original axis.
+
+  public:
+    CKinematicCapsuleShape(const CCapsuleDesc&); ///< Constructor.
+
+    void Rotate(const Vector2&, float, float); ///< Rotate.
+    void Reset(); ///< Reset orientation.
+}; //CKinematicCapsuleShape
+
+#endif //__L4RC_PHYSICS_CAPSULESHAPE_H__
@@ -0,0 +1,361 @@
+/// \file ChainShape.cpp
+/// \brief Code for CChainDesc and CChainShape.
+
+#include "ChainShape.h"
+#include "DynamicCircle.h"
+#include "Contact.h"
+
+const UINT LEAF_EDGES = 4; ///< Most edges in a leaf of a chain's AABB hierarchy.
+
+/////////////////////////////////////////////////////////////////////////////
+// CChainDesc functions
+
+/// The default contructor creates a chain descriptor with no vertices.
+
+CChainDesc::CChainDesc(): CShapeDesc(eShape::Chain){
+} //constructor
+
+/// This constructor creates a chain descriptor given the chain's
+/// vertices and elasticity.
+/// \param v Array of vertices, which isn't copied until the chain is made.
+/// \param n Number of vertices.
+/// \param bLoop Whether the last vertex is joined to the first, defaults to false.
+/// \param e Elasticity, defaults to 1.0f.
+
+CChainDesc::CChainDesc(const Vector2* v, UINT n, bool bLoop, float e):
+  CShapeDesc(eShape::Chain)
+{
+  SetVertices(v, n, bLoop);
+  m_fElasticity = e;
+} //constructor
+
+/// Set the vertices of this chain descriptor and put its position at
+/// their average. Consecutive vertices must be different.
+/// \param v Array of vertices, which isn't copied until the chain is made.
+/// \param n Number of vertices.
+/// \param bLoop Whether the last vertex is joined to the first, defaults to false.
+
+void CChainDesc::SetVertices(const Vector2* v, UINT n, bool bLoop){
+  m_pVertex = v;
+  m_nVertices = n;
+  m_bLoop = bLoop;
+  m_vPos = Vector2(0.0f);
+
+  for(UINT i=0; i<n; i++)
+    m_vPos += v[i];
+
+  if(n > 0)
+    m_vPos /= (float)n;
+} //SetVertices
+
+/////////////////////////////////////////////////////////////////////////////
+// CChainShape functions
+
+/// Constructs a chain described by a chain descriptor. Its vertices, edge
+/// normals and lengths, and AABB hierarchy are allocated from an arena,
+/// so a chain owns nothing that needs to be destructed.
+/// \param r Chain descriptor.
+/// \param pArena Pointer to the arena to allocate from.
+
+CChainShape::CChainShape(const CChainDesc& r, CArena* pArena):
+  CShape(r),
+  m_nVertices(r.m_nVertices),
+  m_bLoop(r.m_bLoop && r.m_nVertices > 2)
+{
+  m_nEdges = m_nVertices < 2? 0: (m_bLoop? m_nVertices: m_nVertices - 1);
+
+  m_pVertex = (Vector2*)pArena->Allocate(m_nVertices*sizeof(Vector2), alignof(Vector2));
+  m_pNormal = (Vector2*)pArena->Allocate(m_nEdges*sizeof(Vector2), alignof(Vector2));
+  m_pLength = (float*)pArena->Allocate(m_nEdges*sizeof(float), alignof(float));
+  m_pNode = (CChainNode*)pArena->Allocate((2*m_nEdges + 1)*sizeof(CChainNode), alignof(CChainNode));
+
+  for(UINT i=0; i<m_nVertices; i++)
+    m_pVertex[i] = r.m_pVertex[i];
+
+  for(UINT i=0; i<m_nEdges; i++){
+    const Vector2 e = GetEnd(i) - m_pVertex[i];
+    m_pLength[i] = e.Length();
+    m_pNormal[i] = Vector2(e.y, -e.x)/m_pLength[i];
+  } //for
+
+  SetPos(r.m_vPos);
+
+  if(m_nVertices > 0){
+    SetAABBPoint(m_pVertex[0] - r.m_vPos);
+
+    for(UINT i=1; i<m_nVertices; i++)
+      AddAABBPoint(m_pVertex[i] - r.m_vPos);
+  } //if
+
+  if(m_nEdges > 0)
+    MakeNode(0, m_nEdges);
+} //constructor
+
+/// Make the subtree of the AABB hierarchy that covers a run of edges,
+/// splitting the run in half until there are few enough edges for a leaf.
+/// The nodes are appended to the node array in preorder.
+/// \param first First edge.
+/// \param last One past the last edge.
+
+void CChainShape::MakeNode(UINT first, UINT last){
+  const UINT i = m_nNodes++;
+  CChainNode& node = m_pNode[i];
+
+  node.m_nFirst = first;
+  node.m_nLast = last;
+  node.m_cAABB = m_pVertex[first];
+
+  for(UINT k=first; k<last; k++)
+    node.m_cAABB += GetEnd(k);
+
+  if(last - first > LEAF_EDGES){
+    const UINT mid = (first + last)/2;
+    MakeNode(first, mid);
+    MakeNode(mid, last);
+  } //if
+
+  node.m_nSkip = m_nNodes;
+} //MakeNode
+
+/// Find the next leaf of the AABB hierarchy in preorder, starting at a given
+/// node, whose AABB overlaps a given AABB. A node whose AABB doesn't overlap
+/// it is skipped together with its subtree, so no stack is needed.
+/// \param aabb An AABB.
+/// \param i Node to start at.
+/// \return Index of a leaf, or the number of nodes if there are no more.
+
+UINT CChainShape::NextLeaf(const CAabb2D& aabb, UINT i) const{
+  while(i < m_nNodes){
+    const CChainNode& node = m_pNode[i];
+
+    if(!(node.m_cAABB && aabb))i = node.m_nSkip; //skip subtree
+    else if(node.m_nSkip == i + 1)return i; //leaf
+    else ++i; //first child
+  } //while
+
+  return m_nNodes;
+} //NextLeaf
+
+/// Get the vertex at the end of an edge, which is the vertex at the start
+/// of the next edge unless this is the last edge of a chain that isn't a loop.
+/// \param i Edge index.
+/// \return The vertex at the end of edge i.
+
+const Vector2& CChainShape::GetEnd(UINT i) const{
+  return m_pVertex[(i + 1)%m_nVertices];
+} //GetEnd
+
+/// Collision detection between a dynamic circle and one edge. If the
+/// circle's center projects onto the edge, then the contact is with the edge.
+/// Otherwise it is with the vertex that the center is off the end of, but a
+/// joint between two edges is tested only when the edge that ends at it is,
+/// and only if the center is off the start of the next edge too. A joint
+/// that the center projects onto an edge from is left to that edge. The
+/// circle's center and radius are passed in so that they are fetched once
+/// per chain instead of once per edge.
+/// \param i Edge index.
+/// \param p Center of the dynamic circle.
+/// \param r Radius of the dynamic circle.
+/// \param c [in, out] Contact descriptor for this collision.
+/// \return true is there was a collision.
+
+bool CChainShape::Collide(UINT i, const Vector2& p, float r, CContactDesc& c) const{
+  const Vector2& p0 = m_pVertex[i];
+  const Vector2& n = m_pNormal[i];
+  const float d = n.Dot(p - p0); //signed distance from line
+
+  FailIf(fabsf(d) - r >= c.m_fMargin); //too far from line
+
+  const float a = Vector2(-n.y, n.x).Dot(p - p0); //distance along edge
+  UINT v = i; //vertex, if the contact is with one
+
+  if(a >= 0.0f && a <= m_pLength[i]){ //between the vertices
+    c.m_vPOI = p - d*n;
+    c.m_vNorm = d < 0.0f? -n: n;
+    c.m_fSetback = fabsf(d) - r;
+    c.m_nFeature = 2*i;
+    return true;
+  } //if
+
+  if(a < 0.0f){ //off the start
+    FailIf(i > 0 || m_bLoop); //a joint, so the previous edge tests it
+  } //if
+
+  else{ //off the end
+    v = (i + 1)%m_nVertices;
+
+    if(i + 1 < m_nEdges || m_bLoop){ //a joint
+      const UINT j = (i + 1)%m_nEdges; //next edge
+      FailIf(Vector2(-m_pNormal[j].y, m_pNormal[j].x).Dot(p - m_pVertex[j]) >= 0.0f);
+    } //if
+  } //else
+
+  const Vector2 u = p - m_pVertex[v];
+  const float s = u.Length() - r; //setback distance
+  FailIf(s >= c.m_fMargin);
+
+  c.m_vPOI = m_pVertex[v];
+  c.m_vNorm = Normalize(u);
+  c.m_fSetback = s;
+  c.m_nFeature = 2*v + 1;
+
+  return true;
+} //Collide
+
+/// Collision detection with a dynamic circle, giving only the deepest contact.
+/// The edges tested are those in the leaves of the AABB hierarchy that the
+/// circle's AABB, expanded by the margin, overlaps.
+/// \param c [in, out] Contact descriptor for this collision.
+/// \return true is there was a collision.
+
+bool CChainShape::PreCollide(CContactDesc& c){
+  if(!m_bCanCollide)return false; //bail and fail
+
+  const Vector2 p = c.m_pCircle->GetPos();
+  const float r = c.m_pCircle->GetRadius();
+
+  CAabb2D aabb = c.m_pCircle->GetAABB();
+  aabb.Expand(c.m_fMargin);
+
+  CContactDesc cd(c); //scratch contact descriptor
+  bool bHit = false; //whether there was a collision
+
+  for(UINT i=NextLeaf(aabb, 0); i<m_nNodes; i=NextLeaf(aabb, i + 1))
+    for(UINT k=m_pNode[i].m_nFirst; k<m_pNode[i].m_nLast; k++)
+      if(Collide(k, p, r, cd) && (!bHit || cd.m_fSetback < c.m_fSetback)){
+        c = cd;
+        bHit = true;
+      } //if
+
+  FailIf(!bHit);
+
+  c.m_fSpeed = c.m_pCircle->GetVel().Length();
+  return true;
+} //PreCollide
+
+/// Collision detection with a dynamic circle, giving every contact. A
+/// dynamic circle in a corner where the chain bends towards it touches both
+/// edges, so each edge or vertex touched gives a contact, and the feature
+/// in each contact descriptor tells them apart.
+/// \param c Contact descriptor for this collision, with the circle and margin filled in.
+/// \param result [in, out] Contacts are appended to this.
+/// \return Number of contacts appended.
+
+UINT CChainShape::PreCollide(CContactDesc& c, std::vector<CContactDesc>& result){
+  if(!m_bCanCollide)return 0; //bail and fail
+
+  const Vector2 p = c.m_pCircle->GetPos();
+  const float r = c.m_pCircle->GetRadius();
+
+  CAabb2D aabb = c.m_pCircle->GetAABB();
+  aabb.Expand(c.m_fMargin);
+
+  c.m_pShape = this;
+  c.m_fSpeed = c.m_pCircle->GetVel().Length();
+  const size_t n = result.size(); //number of contacts before
+
+  for(UINT i=NextLeaf(aabb, 0); i<m_nNodes; i=NextLeaf(aabb, i + 1))
+    for(UINT k=m_pNode[i].m_nFirst; k<m_pNode[i].m_nLast; k++)
+      if(Collide(k, p, r, c))
+        result.push_back(c);
+
+  return (UINT)(result.size() - n);
+} //PreCollide
+
+/// Swept collision detection with a dynamic circle. The circle moves in a
+/// straight line from its current position by displacement v as time goes
+/// from 0 to 1, and hits an edge when its center is one radius from the
+/// edge's line and between its vertices, or a vertex when its center is one
+/// radius from it. Only the edges in the leaves of the AABB hierarchy that
+/// the swept AABB overlaps are tested. A circle that is already touching
+/// this chain is left to PreCollide().
+/// \param c [in, out] Contact descriptor for this collision.
+/// \param v Displacement of the dynamic circle.
+/// \param t [in, out] Earliest time of impact found so far.
+/// \return true if there was a collision before time t.
+
+bool CChainShape::TimeOfImpact(CContactDesc& c, const Vector2& v, float& t){
+  if(!m_bCanCollide)return false; //bail and fail
+
+  CDynamicCircle* pCirc = c.m_pCircle;
+  const Vector2 p = pCirc->GetPos();
+  const float r = pCirc->GetRadius();
+
+  CContactDesc cd(c); //touching test, with no margin
+  cd.m_fMargin = 0.0f;
+  FailIf(PreCollide(cd)); //already touching
+
+  CAabb2D aabb = pCirc->GetAABB(); //swept AABB
+  CAabb2D aabb1 = aabb;
+  aabb1.Translate(v);
+  aabb += aabb1;
+
+  bool bHit = false; //whether there was a hit before time t
+  Vector2 poi; //point of impact
+  UINT feature = 0; //feature hit
+
+  for(UINT i=NextLeaf(aabb, 0); i<m_nNodes; i=NextLeaf(aabb, i + 1))
+    for(UINT k=m_pNode[i].m_nFirst; k<m_pNode[i].m_nLast; k++){
+      const Vector2& n = m_pNormal[k];
+      const float d = n.Dot(p - m_pVertex[k]); //signed distance from line
+      const float dv = n.Dot(v); //change in signed distance
+
+      if(fabsf(d) > r && d*dv < 0.0f && fabsf(d) - r < t*fabsf(dv)){ //outside, approaching, in time
+        const float s = (fabsf(d) - r)/fabsf(dv); //time at which distance is r
+        const Vector2 p2 = p + s*v; //center of circle at time of impact
+        const float a = Vector2(-n.y, n.x).Dot(p2 - m_pVertex[k]); //distance along edge
+
+        if(a >= 0.0f && a <= m_pLength[k]){ //between the vertices
+          t = s;
+          poi = p2 - (d > 0.0f? r: -r)*n;
+          feature = 2*k;
+          bHit = true;
+        } //if
+      } //if
+
+      if(CircleTOI(p, v, m_pVertex[k], r, t)){
+        poi = m_pVertex[k];
+        feature = 2*k + 1;
+        bHit = true;
+      } //if
+
+      if(k + 1 == m_nVertices - 1 && !m_bLoop && CircleTOI(p, v, GetEnd(k), r, t)){ //last vertex
+        poi = GetEnd(k);
+        feature = 2*(k + 1) + 1;
+        bHit = true;
+      } //if
+    } //for
+
+  FailIf(!bHit);
+
+  c.m_pShape = this;
+  c.m_vPOI = poi;
+  c.m_fSetback = 0.0f;
+  c.m_fSpeed = pCirc->GetVel().Length();
+  c.m_vNorm = Normalize(p + t*v - poi);
+  c.m_nFeature = feature;
+
+  return true;
+} //TimeOfImpact
+
+/// Reader function for the number of vertices.
+/// \return Number of vertices.
+
+const UINT CChainShape::GetNumVertices() const{
+  return m_nVertices;
+} //GetNumVertices
+
+/// Reader function for a vertex.
+/// \param i Vertex index, which must be less than the number of vertices.
+/// \return The i'th vertex.
+
+const Vector2& CChainShape::GetVertex(UINT i) const{
+  return m_pVertex[i];
+} //GetVertex
+
+/// Reader function for whether the last vertex is joined to the first.
+/// \return true if this chain is a loop.
+
+const bool CChainShape::IsLoop() const{
+  return m_bLoop;
+} //IsLoop
@@ -0,0 +1,95 @@
+/// \file ChainShape.h
+/// \brief Interface for CChainDesc and CChainShape.
+
+#ifndef __L4RC_PHYSICS_CHAINSHAPE_H__
+#define __L4RC_PHYSICS_CHAINSHAPE_H__
+
+#include <vector>
+
+#include "Shape.h"
+#include "Arena.h"
+
+/// \brief Chain descriptor.
+///
+/// The chain descriptor describes a chain by a list of vertices, each joined
+/// to the next by an edge, and whether the last vertex is joined back to the
+/// first to make a loop. The position is the average of the vertices.
+
+class CChainDesc: public CShapeDesc{
+  public:
+    const Vector2* m_pVertex = nullptr; ///< Vertices, which must outlive the descriptor's use.
+    UINT m_nVertices = 0; ///< Number of vertices.
+    bool m_bLoop = false; ///< Whether the last vertex is joined to the first.
+
+    CChainDesc(); ///< Constructor.
+    CChainDesc(const Vector2*, UINT, bool =false, float =1.0f); ///< Constructor.
+
+    void SetVertices(const Vector2*, UINT, bool =false); ///< Set vertices.
+}; //CChainDesc
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Chain node.
+///
+/// A node in a chain's AABB hierarchy, which covers a run of consecutive
+/// edges. The nodes are stored in preorder, so the first child of a node
+/// is the node after it, and each node knows the node after its subtree.
+
+class CChainNode{
+  public:
+    CAabb2D m_cAABB; ///< AABB of the edges.
+    UINT m_nFirst = 0; ///< First edge.
+    UINT m_nLast = 0; ///< One past the last edge.
+    UINT m_nSkip = 0; ///< Next node after this subtree, the next node if this is a leaf.
+}; //CChainNode
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Chain shape.
+///
+/// A static polyline, such as a wall, stored as a single shape instead of as
+/// a line segment for each edge with a point at each joint. Edge \f$i\f$
+/// joins vertex \f$i\f$ to vertex \f$i + 1\f$, so the vertices shared by two
+/// edges are stored once, and each edge knows its neighbours from its index.
+/// The vertices, the unit normal and length of each edge, and an AABB
+/// hierarchy over runs of consecutive edges are allocated from the shape
+/// store's arena when the chain is made, and don't change after that.
+///
+/// A dynamic circle is tested against only the edges in the leaves of the
+/// hierarchy that its AABB overlaps. A joint between two edges is a contact
+/// only if it is the closest point of both of them, which is what makes
+/// it a corner that the circle is off the end of. A dynamic circle sliding
+/// along a chain over a joint where the chain is straight or bends away from
+/// it touches one edge or the other, never the joint, so it doesn't catch on
+/// the seam. Both sides of a chain are solid, like a line segment.
+
+class CChainShape: public CShape{
+  private:
+    Vector2* m_pVertex = nullptr; ///< Vertices.
+    Vector2* m_pNormal = nullptr; ///< Unit normal of each edge.
+    float* m_pLength = nullptr; ///< Length of each edge.
+    CChainNode* m_pNode = nullptr; ///< AABB hierarchy, in preorder.
+
+    UINT m_nVertices = 0; ///< Number of vertices.
+    UINT m_nEdges = 0; ///< Number of edges.
+    UINT m_nNodes = 0; ///< Number of nodes in AABB hierarchy.
+    bool m_bLoop = false; ///< Whether the last vertex is joined to the first.
+
+    void MakeNode(UINT, UINT); ///< Make a subtree of the AABB hierarchy.
+    UINT NextLeaf(const CAabb2D&, UINT) const; ///< Find a leaf overlapping an AABB.
+    const Vector2& GetEnd(UINT) const; ///< Get the vertex at the end of an edge.
+    bool Collide(UINT, const Vector2&, float, CContactDesc&) const; ///< Collision detection with one edge.
+
+  public:
+    CChainShape(const CChainDesc&, CArena*); ///< Constructor.
+
+    bool PreCollide(CContactDesc&); ///< Collision detection, deepest contact.
+    UINT PreCollide(CContactDesc&, std::vector<CContactDesc>&); ///< Collision detection, all contacts.
+    bool TimeOfImpact(CContactDesc&, const Vector2&, float&); ///< Swept collision detection.
+
+    const UINT GetNumVertices() const; ///< Get number of vertices.
+    const Vector2& GetVertex(UINT) const; ///< Get vertex.
+    const bool IsLoop() const; ///< Is this chain a loop?
+}; //CChainShape
+
+#endif //__L4RC_PHYSICS_CHAINSHAPE_H__
@@ -1,200 +1,251 @@
-/// \file Circle.cpp
-/// \brief Code for CCircleDesc, CCircle, and CKinematicCircle.
-
-#include "Circle.h"
-#include "LineSeg.h"
-#include "Line.h"
-#include "AABB.h"
-#include "Contact.h"
-
-///////////////////////////////////////////////////////////////////
-// CCircleDesc functions.
-
-/// The default contructor creates a circle descriptor
-/// of zero radius.
-
-CCircleDesc::CCircleDesc(): 
-  CShapeDesc(eShape::Circle){
-} //constructor
-
-/// This constructor creates a circle descriptor given the circle's
-/// center, radius, and elasticity.
-/// \param p Center point.
-/// \param r Radius.
-/// \param e Elasticity.
-
-CCircleDesc::CCircleDesc(const Vector2& p, float r, float e):
-  CShapeDesc(eShape::Circle), 
-  m_fRadius(r)
-{
-  m_vPos = p;
-  m_fElasticity = e;
-} //constructor
-
-///////////////////////////////////////////////////////////////////
-// CCircle functions.
-
-/// Constructs a circle described by a circle descriptor.
-/// \param r Circle descriptor.
-
-CCircle::CCircle(const CCircleDesc& r): 
-  CShape(r), 
-  m_fRadius(r.m_fRadius), 
-  m_fRadiusSq(r.m_fRadius*r.m_fRadius)
-{
-  m_eShapeType = eShape::Circle;
-
-  SetAABBPoint(Vector2(m_fRadius, 0.0f));
-  AddAABBPoint(Vector2(-m_fRadius, 0.0f));
-  AddAABBPoint(Vector2(0.0f, m_fRadius));
-  AddAABBPoint(Vector2(0.0f, -m_fRadius));
-
-  SetPos(r.m_vPos);
-} //constructor
-
-/// Determine whether a given point is strictly inside this circle,
-/// that is, if the point's distance to the center of this circle
-/// is strictly less that its radius.
-/// \param p A point.
-/// \return true if p is in this circle.
-
-bool CCircle::PtInCircle(const Vector2& p){
-  return (GetPos() - p).LengthSquared() < m_fRadiusSq;
-} //PtInCircle
-
-/// Find the point on the perimeter of this circle that is
-/// closest to a given point.
-/// \param p A point.
-/// \return The closest point to p that is on the perimeter.
-
-Vector2 CCircle::ClosestPt(const Vector2& p){
-  const Vector2 p0 = GetPos();
-  const Vector2 nhat = Normalize(p - p0);
-  return p0 + m_fRadius*nhat;
-} //ClosestPt
-
-/// Collision detection with a dynamic circle.
-/// \param c [in, out] Contact descriptor for this collision.
-/// \return true is there was a collision.
-
-bool CCircle::PreCollide(CContactDesc& c){
-  CPoint poi = ClosestPt(c.m_pCircle->GetPos()); //point of impact
-  return CPoint(poi).PreCollide(c);
-} //PreCollide
-
-/// Compute the points of intersection of tangents passing through a point.
-/// Note that there are two possible tangents to a circle that pass through
-/// a given point outside the circle. If the point is inside the circle,
-/// then the tangents don't exist.
-/// \param p Point that must lie on the tangents.
-/// \param [out] p0 Intersection point with first tangent.
-/// \param [out] p1 Intersection point with second tangent.
-/// \return true if the tangents exist.
-
-bool CCircle::Tangents(const Vector2& p, Vector2& p0, Vector2& p1){
-  FailIf(PtInCircle(p)); //no tangents
-
-  const Vector2 v = GetPos() - p; //vector from p to center of circle
-  const float d = v.Length(); //distance from p to center of circle
-
-  const float delta = sqrtf(d*d - m_fRadiusSq); //distance from p along line to center of circle
-  const float phi = atan2f(v.y, v.x); //orientation of v
-  const float theta = asinf(m_fRadius/d); //angle from v to tangent (plus or minus)
-
-  const float ccw = phi + theta; //orientation of counterclockwise tangent
-  const float cw = phi - theta; //orientation of clockwise tangent
-
-  p0 = p + delta*Vector2(cosf(ccw), sinf(ccw)); //distance delta along tangent from p
-  p1 = p + delta*Vector2(cosf(cw), sinf(cw)); //distance delta along tangent from p
-
-  return true;
-} //Tangents
-
-/// A line tangent to circles at centers \f$p_0\f$ and \f$p_1\f$
-/// of radii \f$r_0\f$ and \f$r_1 < r_0\f$ is constructed by constructing the tangent
-/// to a single circle of radius \f$r_0 - r_1\f$ centered at \f$p_0\f$ and through \f$p_1\f$,
-/// then translating this line segment along the radius through \f$p_0\f$ a distance \f$r_1\f$.
-/// See J. Casey, "A sequel to the First Six Books of the Elements of Euclid", pp. 31-32, 1888.
-/// \param pCirc Pointer to another circle.
-/// \param [out] t0 Line segment descriptor for first common tangent.
-/// \param [out] t1 Line segment descriptor for second common tangent.
-/// \return true if tangents exist.
-
-bool CCircle::Tangents(CCircle* pCirc, CLineSegDesc& t0, CLineSegDesc& t1){
-  Vector2 p0 = GetPos();
-  Vector2 p1 = pCirc->GetPos();
-  
-  float r0 = m_fRadius;
-  float r1 = pCirc->m_fRadius;
-
-  //make sure that the first circle is the biggest one
-  if(r0 < r1) //it's not
-    return pCirc->Tangents(this, t1, t0); //flip the circles so that the largest one is first
-
-  Vector2 p2, p3; //points where tangents touch this circle
-
-  if(r0 == r1) //same radii
-    p2 = p3 = p0; //easy case, tangents are parallel with line joining centers
-
-  else{ //general case, use Casey's method
-    CCircle circ2(CCircleDesc(p0, r0 - r1));
-    FailIf(!circ2.Tangents(p1, p2, p3));
-  } //else
-
-  //compute tangent offsets
-  const Vector2 dv0 = r1*Normalize(perp(p2 - p1));
-  const Vector2 dv1 = -r1*Normalize(perp(p3 - p1));
-
-  //move intersection points by the appropriate offset
-  t0.SetEndPts(p2 + dv0, p1 + dv0);
-  t1.SetEndPts(p3 + dv1, p1 + dv1);
-
-  return true;
-} //Tangents
-
-/// Compute the common tangent with another circle that is counterclockwise
-/// from the vector pointing from this circle to that one.
-/// \param pCirc Pointer to another circle.
-/// \param [out] t Line segment descriptor for common tangent.
-/// \return true if tangent exists.
-
-bool CCircle::Tangent(CCircle* pCirc, CLineSegDesc& t){
-  CLineSegDesc t0; //for the tangent we don't want
-  FailIf(!Tangents(pCirc, t0, t)); //we want the second one
-  return true;
-} //Tangent
-
-/// Reader function for the radius.
-/// \return The radius.
-
-float CCircle::GetRadius(){
-  return m_fRadius;
-} //GetRadius
-
-///////////////////////////////////////////////////////////////////////////////////
-// CKinematicCircle functions.
-
-/// Constructs a kinematic circle described by a circle descriptor.
-/// \param r Circle descriptor.
-
-CKinematicCircle::CKinematicCircle(const CCircleDesc& r):
-  CCircle(r)
-{
-  m_vOldPos = GetPos();
-  m_eMotionType = eMotion::Kinematic;
-} //constructor
-
-/// Rotate to a given orientation from original orientation.
-/// \param v Center of rotation.
-/// \param a Angle increment from original orientation.
-
-void CKinematicCircle::Rotate(const Vector2& v, float a){  
-  SetPos(RotatePt(m_vOldPos, v, a));
-} //Rotate
-
-/// Reset to original orientation.
-
-void CKinematicCircle::Reset(){
-  SetPos(m_vOldPos);
-} //Reset
-
+/// \file Circle.cpp
+/// \brief Code for CCircleDesc, CCircle, and CKinematicCircle.
+
+#include "Circle.h"
+#include "LineSeg.h"
+#include "Line.h"
+#include "AABB.h"
+#include "Contact.h"
+
+///////////////////////////////////////////////////////////////////
+// CCircleDesc functions.
+
+/// The default contructor creates a circle descriptor
+/// of zero radius.
+
+CCircleDesc::CCircleDesc(): 
+  CShapeDesc(eShape::Circle){
+} //constructor
+
+/// This constructor creates a circle descriptor given the circle's
+/// center, radius, and elasticity.
+/// \param p Center point.
+/// \param r Radius.
+/// \param e Elasticity.
+
+CCircleDesc::CCircleDesc(const Vector2& p, float r, float e):
+  CShapeDesc(eShape::Circle), 
+  m_fRadius(r)
+{
+  m_vPos = p;
+  m_fElasticity = e;
+} //constructor
+
+///////////////////////////////////////////////////////////////////
+// CCircle functions.
+
+/// Constructs a circle described by a circle descriptor.
+/// \param r Circle descriptor.
+
+CCircle::CCircle(const CCircleDesc& r): 
+  CShape(r), 
+  m_fRadius(r.m_fRadius), 
+  m_fRadiusSq(r.m_fRadius*r.m_fRadius)
+{
+  m_eShapeType = eShape::Circle;
+
+  SetAABBPoint(Vector2(m_fRadius, 0.0f));
+  AddAABBPoint(Vector2(-m_fRadius, 0.0f));
+  AddAABBPoint(Vector2(0.0f, m_fRadius));
+  AddAABBPoint(Vector2(0.0f, -m_fRadius));
+
+  SetPos(r.m_vPos);
+} //constructor
+
+/// Determine whether a given point is strictly inside this circle,
+/// that is, if the point's distance to the center of this circle
+/// is strictly less that its radius.
+/// \param p A point.
+/// \return true if p is in this circle.
+
+bool CCircle::PtInCircle(const Vector2& p){
+  return (GetPos() - p).LengthSquared() < m_fRadiusSq;
+} //PtInCircle
+
+/// Find the point on the perimeter of this circle that is
+/// closest to a given point.
+/// \param p A point.
+/// \return The closest point to p that is on the perimeter.
+
+Vector2 CCircle::ClosestPt(const Vector2& p){
+  const Vector2 p0 = GetPos();
+  const Vector2 nhat = Normalize(p - p0);
+  return p0 + m_fRadius*nhat;
+} //ClosestPt
+
+/// Collision detection with a dynamic circle.
+/// \param c [in, out] Contact descriptor for this collision.
+/// \return true is there was a collision.
+
+bool CCircle::PreCollide(CContactDesc& c){
+  CPoint poi = ClosestPt(c.m_pCircle->GetPos()); //point of impact
+  return CPoint(poi).PreCollide(c);
+} //PreCollide
+
+/// Find the time of impact of a dynamic circle moving in a straight line with
+/// the perimeter of this circle. The dynamic circle moves from its current
+/// position by displacement v as time goes from 0 to 1. If it starts outside
+/// this circle, then it hits when the distance between centers is the sum of
+/// the radii. If it starts inside, then it hits when the distance between
+/// centers is the difference of the radii. A dynamic circle that is already
+/// touching the perimeter is left to PreCollide().
+/// \param pCirc Pointer to a dynamic circle.
+/// \param v Displacement of the dynamic circle.
+/// \param t [in, out] Earliest time of impact found so far.
+/// \return true if there was a collision before time t.
+
+bool CCircle::SweptTOI(CDynamicCircle* pCirc, const Vector2& v, float& t){
+  const Vector2 p = pCirc->GetPos();
+  const float r = pCirc->GetRadius();
+  const float dsq = (p - GetPos()).LengthSquared(); //distance between centers squared
+
+  if(dsq > sqr(m_fRadius + r)) //outside
+    return CircleTOI(p, v, GetPos(), m_fRadius + r, t);
+
+  if(m_fRadius > r && dsq < sqr(m_fRadius - r)) //inside
+    return CircleTOI(p, v, GetPos(), m_fRadius - r, t);
+
+  return false; //already touching
+} //SweptTOI
+
+/// Swept collision detection with a dynamic circle.
+/// \param c [in, out] Contact descriptor for this collision.
+/// \param v Displacement of the dynamic circle.
+/// \param t [in, out] Earliest time of impact found so far.
+/// \return true if there was a collision before time t.
+
+bool CCircle::TimeOfImpact(CContactDesc& c, const Vector2& v, float& t){
+  FailIf(!SweptTOI(c.m_pCircle, v, t));
+
+  const Vector2 p = c.m_pCircle->GetPos() + t*v; //center at time of impact
+
+  c.m_pShape = this;
+  c.m_vPOI = ClosestPt(p);
+  c.m_fSetback = 0.0f;
+  c.m_fSpeed = c.m_pCircle->GetVel().Length();
+  c.m_vNorm = Normalize(p - c.m_vPOI);
+
+  return true;
+} //TimeOfImpact
+
+/// Compute the points of intersection of tangents passing through a point.
+/// Note that there are two possible tangents to a circle that pass through
+/// a given point outside the circle. If the point is inside the circle,
+/// then the tangents don't exist. The tangents are at angle \f$\pm\theta\f$
+/// to the vector \f$\vec{v}\f$ from the point to the center, where
+/// \f$\sin\theta = r/d\f$ and \f$\cos\theta = \delta/d\f$, \f$r\f$ is the
+/// radius, \f$d = |\vec{v}|\f$, and \f$\delta\f$ is the length of the
+/// tangents. Rotating \f$\vec{v}\f$ by \f$\pm\theta\f$ and scaling it to length
+/// \f$\delta\f$ gives \f$(\delta/d^2)(\delta\vec{v} \pm r\vec{v}^\perp)\f$,
+/// so the angles themselves are never needed.
+/// \param p Point that must lie on the tangents.
+/// \param [out] p0 Intersection point with first tangent.
+/// \param [out] p1 Intersection point with second tangent.
+/// \return true if the tangents exist.
+
+bool CCircle::Tangents(const Vector2& p, Vector2& p0, Vector2& p1){
+  FailIf(PtInCircle(p)); //no tangents
+
+  const Vector2 v = GetPos() - p; //vector from p to center of circle
+  const float dsq = v.LengthSquared(); //distance from p to center of circle, squared
+
+  const float delta = sqrtf(dsq - m_fRadiusSq); //distance from p along tangent to circle
+  const Vector2 u = delta*v; //component along v, scaled by d^2
+  const Vector2 w = m_fRadius*perp(v); //component perpendicular to v, scaled by d^2
+  const float k = delta/dsq; //undo scaling by d^2, scale to length delta
+
+  p0 = p + k*(u + w); //counterclockwise tangent
+  p1 = p + k*(u - w); //clockwise tangent
+
+  return true;
+} //Tangents
+
+/// A line tangent to circles at centers \f$p_0\f$ and \f$p_1\f$
+/// of radii \f$r_0\f$ and \f$r_1 < r_0\f$ is constructed by constructing the tangent
+/// to a single circle of radius \f$r_0 - r_1\f$ centered at \f$p_0\f$ and through \f$p_1\f$,
+/// then translating this line segment along the radius through \f$p_0\f$ a distance \f$r_1\f$.
+/// See J. Casey, "A sequel to the First Six Books of the Elements of Euclid", pp. 31-32, 1888.
+/// \param pCirc Pointer to another circle.
+/// \param [out] t0 Line segment descriptor for first common tangent.
+/// \param [out] t1 Line segment descriptor for second common tangent.
+/// \return true if tangents exist.
+
+bool CCircle::Tangents(CCircle* pCirc, CLineSegDesc& t0, CLineSegDesc& t1){
+  Vector2 p0 = GetPos();
+  Vector2 p1 = pCirc->GetPos();
+  
+  float r0 = m_fRadius;
+  float r1 = pCirc->m_fRadius;
+
+  //make sure that the first circle is the biggest one
+  if(r0 < r1) //it's not
+    return pCirc->Tangents(this, t1, t0); //flip the circles so that the largest one is first
+
+  Vector2 p2, p3; //points where tangents touch this circle
+
+  if(r0 == r1) //same radii
+    p2 = p3 = p0; //easy case, tangents are parallel with line joining centers
+
+  else{ //general case, use Casey's method
+    CCircle circ2(CCircleDesc(p0, r0 - r1));
+    FailIf(!circ2.Tangents(p1, p2, p3));
+  } //else
+
+  //compute tangent offsets
+  const Vector2 dv0 = r1*Normalize(perp(p2 - p1));
+  const Vector2 dv1 = -r1*Normalize(perp(p3 - p1));
+
+  //move intersection points by the appropriate offset
+  t0.SetEndPts(p2 + dv0, p1 + dv0);
+  t1.SetEndPts(p3 + dv1, p1 + dv1);
+
+  return true;
+} //Tangents
+
+/// Compute the common tangent with another circle that is counterclockwise
+/// from the vector pointing from this circle to that one.
+/// \param pCirc Pointer to another circle.
+/// \param [out] t Line segment descriptor for common tangent.
+/// \return true if tangent exists.
+
+bool CCircle::Tangent(CCircle* pCirc, CLineSegDesc& t){
+  CLineSegDesc t0; //for the tangent we don't want
+  FailIf(!Tangents(pCirc, t0, t)); //we want the second one
+  return true;
+} //Tangent
+
+/// Reader function for the radius.
+/// \return The radius.
+
+float CCircle::GetRadius(){
+  return m_fRadius;
+} //GetRadius
+
+///////////////////////////////////////////////////////////////////////////////////
+// CKinematicCircle functions.
+
+/// Constructs a kinematic circle described by a circle descriptor.
+/// \param r Circle descriptor.
+
+CKinematicCircle::CKinematicCircle(const CCircleDesc& r):
+  CCircle(r)
+{
+  m_vOldPos = GetPos();
+  m_eMotionType = eMotion::Kinematic;
+} //constructor
+
+/// Rotate to a given orientation from original orientation.
+/// \param v Center of rotation.
+/// \param s Sine of the angle increment from original orientation.
+/// \param c Cosine of the angle increment from original orientation.
+
+void CKinematicCircle::Rotate(const Vector2& v, float s, float c){
+  SetPos(RotatePt(m_vOldPos, v, s, c));
+} //Rotate
+
+/// Reset to original orientation.
+
+void CKinematicCircle::Reset(){
+  SetPos(m_vOldPos);
+} //Reset
+
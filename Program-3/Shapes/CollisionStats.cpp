@@ -0,0 +1,276 @@
+/// \file CollisionStats.cpp
+/// \brief Code for the collision statistics classes CCollisionCounts and CCollisionStats.
+
+#include "CollisionStats.h"
+
+/// Names of shape types for CSV column names and on-screen statistics,
+/// in the same order as eShape.
+
+static const char* g_szShapeName[(UINT)eShape::Size] = {
+  "Unknown", "Point", "Line", "LineSeg", "Circle", "Arc", "Polygon", "Chain", "Capsule"
+}; //g_szShapeName
+
+/// Names of motion types for CSV column names, in the same order as eMotion.
+
+static const char* g_szMotionName[(UINT)eMotion::Size] = {
+  "Static", "Kinematic", "Dynamic"
+}; //g_szMotionName
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// CCollisionCounts functions.
+
+/// Reset all counts to zero.
+
+void CCollisionCounts::Clear(){
+  *this = CCollisionCounts();
+} //Clear
+
+/// Add another set of counts to this one.
+/// \param c A set of counts.
+/// \return This set of counts after the addition.
+
+CCollisionCounts& CCollisionCounts::operator+=(const CCollisionCounts& c){
+  for(UINT i=0; i<(UINT)eShape::Size; i++){
+    m_nAabbTests[i] += c.m_nAabbTests[i];
+    m_nPreCollides[i] += c.m_nPreCollides[i];
+    m_nHits[i] += c.m_nHits[i];
+  } //for
+
+  for(UINT i=0; i<(UINT)eMotion::Size; i++)
+    m_nPostCollides[i] += c.m_nPostCollides[i];
+
+  m_nSubsteps += c.m_nSubsteps;
+  m_nPasses += c.m_nPasses;
+
+  return *this;
+} //operator+=
+
+/// Reader function for the total number of AABB tests.
+/// \return Number of AABB tests for all shape types.
+
+const UINT CCollisionCounts::GetAabbTests() const{
+  UINT n = 0;
+  for(UINT i=0; i<(UINT)eShape::Size; i++)
+    n += m_nAabbTests[i];
+  return n;
+} //GetAabbTests
+
+/// Reader function for the total number of narrow phase tests.
+/// \return Number of narrow phase tests for all shape types.
+
+const UINT CCollisionCounts::GetPreCollides() const{
+  UINT n = 0;
+  for(UINT i=0; i<(UINT)eShape::Size; i++)
+    n += m_nPreCollides[i];
+  return n;
+} //GetPreCollides
+
+/// Reader function for the total number of narrow phase hits.
+/// \return Number of narrow phase hits for all shape types.
+
+const UINT CCollisionCounts::GetHits() const{
+  UINT n = 0;
+  for(UINT i=0; i<(UINT)eShape::Size; i++)
+    n += m_nHits[i];
+  return n;
+} //GetHits
+
+/// Reader function for the total number of collision responses.
+/// \return Number of collision responses for all motion types.
+
+const UINT CCollisionCounts::GetPostCollides() const{
+  UINT n = 0;
+  for(UINT i=0; i<(UINT)eMotion::Size; i++)
+    n += m_nPostCollides[i];
+  return n;
+} //GetPostCollides
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// CCollisionStats static member variables.
+
+thread_local CCollisionStats::CLocalCounts CCollisionStats::m_cLocal;
+
+std::mutex CCollisionStats::m_stdMutex;
+std::vector<CCollisionCounts*> CCollisionStats::m_stdThreads;
+CCollisionCounts CCollisionStats::m_cLeftover;
+
+CCollisionCounts CCollisionStats::m_cFrame;
+UINT CCollisionStats::m_nFrame = 0;
+
+FILE* CCollisionStats::m_pCSV = nullptr;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// CCollisionStats::CLocalCounts functions.
+
+/// Register this thread's counts so that EndFrame() can find them.
+
+CCollisionStats::CLocalCounts::CLocalCounts(){
+  std::lock_guard<std::mutex> lock(m_stdMutex);
+  m_stdThreads.push_back(this);
+} //constructor
+
+/// Unregister this thread's counts, keeping any counts that have
+/// not yet been merged so that they show up in the next frame.
+
+CCollisionStats::CLocalCounts::~CLocalCounts(){
+  std::lock_guard<std::mutex> lock(m_stdMutex);
+  m_cLeftover += *this;
+
+  for(auto i=m_stdThreads.begin(); i!=m_stdThreads.end(); i++)
+    if(*i == this){
+      m_stdThreads.erase(i);
+      break;
+    } //if
+} //destructor
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// CCollisionStats functions.
+
+/// Record an AABB test made in the broad phase.
+/// \param t Type of the shape being tested against a dynamic circle.
+
+void CCollisionStats::AabbTest(eShape t){
+  ++m_cLocal.m_nAabbTests[(UINT)t];
+} //AabbTest
+
+/// Record a narrow phase test, that is, a call to PreCollide().
+/// \param t Type of the shape being tested against a dynamic circle.
+/// \param bHit true if PreCollide() found a collision.
+
+void CCollisionStats::PreCollide(eShape t, bool bHit){
+  ++m_cLocal.m_nPreCollides[(UINT)t];
+  if(bHit)++m_cLocal.m_nHits[(UINT)t];
+} //PreCollide
+
+/// Record a batch of narrow phase tests made without calling PreCollide(),
+/// for example by CLineSegBatch::Collide().
+/// \param t Type of the shapes being tested against a dynamic circle.
+/// \param n Number of tests.
+/// \param hits Number of tests that found a collision.
+
+void CCollisionStats::PreCollide(eShape t, UINT n, UINT hits){
+  m_cLocal.m_nPreCollides[(UINT)t] += n;
+  m_cLocal.m_nHits[(UINT)t] += hits;
+} //PreCollide
+
+/// Record a collision response, that is, a call to PostCollide().
+/// \param m Motion type of the shape that a dynamic circle collided with.
+
+void CCollisionStats::PostCollide(eMotion m){
+  ++m_cLocal.m_nPostCollides[(UINT)m];
+} //PostCollide
+
+/// Record a physics substep.
+
+void CCollisionStats::Substep(){
+  ++m_cLocal.m_nSubsteps;
+} //Substep
+
+/// Record a broad phase pass, that is, one round of collision detection
+/// and response for all of the dynamic circles.
+
+void CCollisionStats::Pass(){
+  ++m_cLocal.m_nPasses;
+} //Pass
+
+/// Add up the counts from all threads into the counts for this frame,
+/// reset the per-thread counts, and append a row to the CSV file if it
+/// is open. Call this once per frame when no physics is in progress.
+
+void CCollisionStats::EndFrame(){
+  std::lock_guard<std::mutex> lock(m_stdMutex);
+
+  m_cFrame = m_cLeftover;
+  m_cLeftover.Clear();
+
+  for(auto const& p: m_stdThreads){
+    m_cFrame += *p;
+    p->Clear();
+  } //for
+
+  ++m_nFrame;
+
+  if(m_pCSV)
+    WriteCSVRow();
+} //EndFrame
+
+/// Reader function for the counts for the last frame ended.
+/// \return Counts for the last frame.
+
+const CCollisionCounts& CCollisionStats::GetFrame(){
+  return m_cFrame;
+} //GetFrame
+
+/// Get the name of a shape type, which is the one used in the CSV column names.
+/// \param t Shape type.
+/// \return Name of shape type, "Unknown" if it is out of range.
+
+const char* CCollisionStats::GetShapeName(eShape t){
+  return t < eShape::Size? g_szShapeName[(UINT)t]: g_szShapeName[0];
+} //GetShapeName
+
+/// Open a CSV file and write the column names to it. From now on a row
+/// will be appended for each frame until CloseCSV() is called. Any CSV
+/// file that is already open is closed first.
+/// \param fname File name.
+/// \return true if the file was opened.
+
+bool CCollisionStats::OpenCSV(const char* fname){
+  CloseCSV();
+
+  if(fopen_s(&m_pCSV, fname, "wt") != 0){
+    m_pCSV = nullptr;
+    return false;
+  } //if
+
+  WriteCSVHeader();
+  return true;
+} //OpenCSV
+
+/// Close the CSV file, if it is open.
+
+void CCollisionStats::CloseCSV(){
+  if(m_pCSV){
+    fclose(m_pCSV);
+    m_pCSV = nullptr;
+  } //if
+} //CloseCSV
+
+/// Reader function for whether the CSV file is open.
+/// \return true if the CSV file is open.
+
+bool CCollisionStats::IsCSVOpen(){
+  return m_pCSV != nullptr;
+} //IsCSVOpen
+
+/// Write the CSV column names. There is one column for the frame number,
+/// three for each shape type, one for each motion type, and one for the
+/// number of substeps.
+
+void CCollisionStats::WriteCSVHeader(){
+  fprintf(m_pCSV, "Frame");
+
+  for(UINT i=0; i<(UINT)eShape::Size; i++)
+    fprintf(m_pCSV, ",AABB%s,Pre%s,Hit%s", 
+      g_szShapeName[i], g_szShapeName[i], g_szShapeName[i]);
+
+  for(UINT i=0; i<(UINT)eMotion::Size; i++)
+    fprintf(m_pCSV, ",Post%s", g_szMotionName[i]);
+
+  fprintf(m_pCSV, ",Substeps,Passes\n");
+} //WriteCSVHeader
+
+/// Write the counts for the last frame as a row of the CSV file.
+
+void CCollisionStats::WriteCSVRow(){
+  fprintf(m_pCSV, "%u", m_nFrame);
+
+  for(UINT i=0; i<(UINT)eShape::Size; i++)
+    fprintf(m_pCSV, ",%u,%u,%u", 
+      m_cFrame.m_nAabbTests[i], m_cFrame.m_nPreCollides[i], m_cFrame.m_nHits[i]);
+
+  for(UINT i=0; i<(UINT)eMotion::Size; i++)
+    fprintf(m_pCSV, ",%u", m_cFrame.m_nPostCollides[i]);
+
+  fprintf(m_pCSV, ",%u,%u\n", m_cFrame.m_nSubsteps, m_cFrame.m_nPasses);
+} //WriteCSVRow
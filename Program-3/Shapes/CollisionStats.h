@@ -0,0 +1,94 @@
+/// \file CollisionStats.h
+/// \brief Interface for the collision statistics classes CCollisionCounts and CCollisionStats.
+
+#ifndef __L4RC_PHYSICS_COLLISIONSTATS_H__
+#define __L4RC_PHYSICS_COLLISIONSTATS_H__
+
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include "Shape.h"
+
+/// \brief Collision counts.
+///
+/// A set of counters for the work done by collision detection and response,
+/// broken down by shape type or motion type. The shape type is that of the
+/// shape that a dynamic circle is being tested against.
+
+class CCollisionCounts{
+  public:
+    UINT m_nAabbTests[(UINT)eShape::Size] = {0}; ///< AABB tests by shape type.
+    UINT m_nPreCollides[(UINT)eShape::Size] = {0}; ///< Narrow phase tests by shape type.
+    UINT m_nHits[(UINT)eShape::Size] = {0}; ///< Narrow phase hits by shape type.
+    UINT m_nPostCollides[(UINT)eMotion::Size] = {0}; ///< Collision responses by motion type.
+    UINT m_nSubsteps = 0; ///< Physics substeps.
+    UINT m_nPasses = 0; ///< Contact solver iterations.
+
+    void Clear(); ///< Reset all counts to zero.
+    CCollisionCounts& operator+=(const CCollisionCounts&); ///< Add counts.
+
+    const UINT GetAabbTests() const; ///< Get total AABB tests.
+    const UINT GetPreCollides() const; ///< Get total narrow phase tests.
+    const UINT GetHits() const; ///< Get total narrow phase hits.
+    const UINT GetPostCollides() const; ///< Get total collision responses.
+}; //CCollisionCounts
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Collision statistics.
+///
+/// Collision statistics are gathered into a set of counts that is local to
+/// each thread, so that recording them needs no locking. At the end of each
+/// frame EndFrame() adds up the counts from all threads into the counts for
+/// that frame, which can then be read with GetFrame(), and resets the
+/// per-thread counts to zero. EndFrame() must be called only when no other
+/// thread is in the middle of a physics step. If a CSV file has been opened,
+/// then the counts for each frame are also appended to it as a single row.
+
+class CCollisionStats{
+  private:
+    /// \brief Per-thread collision counts.
+    ///
+    /// The per-thread counts register themselves with CCollisionStats when
+    /// a thread first records something, and when the thread exits they add
+    /// whatever has not yet been merged into the leftovers.
+
+    class CLocalCounts: public CCollisionCounts{
+      public:
+        CLocalCounts(); ///< Constructor.
+        ~CLocalCounts(); ///< Destructor.
+    }; //CLocalCounts
+
+    static thread_local CLocalCounts m_cLocal; ///< Counts for this thread.
+
+    static std::mutex m_stdMutex; ///< Mutex for the per-thread count list.
+    static std::vector<CCollisionCounts*> m_stdThreads; ///< Per-thread counts.
+    static CCollisionCounts m_cLeftover; ///< Counts from threads that have exited.
+
+    static CCollisionCounts m_cFrame; ///< Counts for the last frame.
+    static UINT m_nFrame; ///< Number of frames ended.
+
+    static FILE* m_pCSV; ///< CSV file, nullptr if not open.
+
+    static void WriteCSVHeader(); ///< Write CSV column names.
+    static void WriteCSVRow(); ///< Write counts for last frame to CSV file.
+
+  public:
+    static void AabbTest(eShape); ///< Record an AABB test.
+    static void PreCollide(eShape, bool); ///< Record a narrow phase test.
+    static void PreCollide(eShape, UINT, UINT); ///< Record a batch of narrow phase tests.
+    static void PostCollide(eMotion); ///< Record a collision response.
+    static void Substep(); ///< Record a physics substep.
+    static void Pass(); ///< Record a broad phase pass.
+
+    static void EndFrame(); ///< Merge per-thread counts.
+    static const CCollisionCounts& GetFrame(); ///< Get counts for last frame.
+    static const char* GetShapeName(eShape); ///< Get name of shape type.
+
+    static bool OpenCSV(const char*); ///< Start writing counts to a CSV file.
+    static void CloseCSV(); ///< Stop writing counts to CSV file.
+    static bool IsCSVOpen(); ///< Is the CSV file open?
+}; //CCollisionStats
+
+#endif //__L4RC_PHYSICS_COLLISIONSTATS_H__
@@ -0,0 +1,288 @@
+/// \file ContactSolver.cpp
+/// \brief Code for the contact solver class CContactSolver.
+
+#include <cstdint>
+
+#include "ContactSolver.h"
+#include "CollisionStats.h"
+
+const UINT MIN_WARM_SIZE = 64; ///< Smallest size of the warm start table, a power of 2.
+
+/// Start a substep by emptying the contact buffer and the body arrays. The
+/// warm start impulses from the previous substep are kept.
+
+void CContactSolver::Begin(){
+  m_stdContacts.clear();
+
+  m_stdBody.clear();
+  m_stdVel.clear();
+  m_stdSetback.clear();
+  m_stdInvMass.clear();
+
+  if(++m_nStamp == 0) //skip zero, which every dynamic circle starts with
+    m_nStamp = 1;
+} //Begin
+
+/// Get the body index of a dynamic circle, making it a body if it isn't one
+/// already in this substep. A dynamic circle remembers its body index
+/// together with the stamp of the substep in which it was given it.
+/// \param p Pointer to a dynamic circle.
+/// \return Its body index.
+
+UINT CContactSolver::GetBody(CDynamicCircle* p){
+  if(p->m_nSolverStamp != m_nStamp){ //not a body yet
+    p->m_nSolverStamp = m_nStamp;
+    p->m_nSolverBody = (UINT)m_stdBody.size();
+
+    m_stdBody.push_back(p);
+    m_stdVel.push_back(p->m_vVel);
+    m_stdSetback.push_back(Vector2(0.0f));
+    m_stdInvMass.push_back(1.0f/p->m_fMass);
+  } //if
+
+  return p->m_nSolverBody;
+} //GetBody
+
+/// Hash a shape pointer, a dynamic circle pointer, and a feature to a slot
+/// in the warm start table by multiplying each by a different large odd
+/// constant and taking the high bits of the sum, which depend on all of the
+/// bits of all three. The slots mean nothing else, so it doesn't matter that
+/// they change from run to run.
+/// \param pShape Pointer to a shape.
+/// \param pCirc Pointer to a dynamic circle.
+/// \param feature Feature of the shape.
+/// \return Slot index.
+
+UINT CContactSolver::Hash(const CShape* pShape, const CDynamicCircle* pCirc, UINT feature) const{
+  const uint64_t h = (uint64_t)(uintptr_t)pShape*0x9E3779B97F4A7C15ull +
+    (uint64_t)(uintptr_t)pCirc*0xC2B2AE3D27D4EB4Full + (uint64_t)feature*0x165667B19E3779F9ull;
+
+  return (UINT)(h >> 32) & m_nWarmMask;
+} //Hash
+
+/// Find the impulse that a contact ended the previous substep with by
+/// probing the warm start table from the contact's slot until either the
+/// contact or an empty slot is found.
+/// \param c A contact.
+/// \return Its impulse, or zero if it didn't exist then.
+
+float CContactSolver::GetWarmStart(const CSolverContact& c) const{
+  if(m_stdWarm.empty())return 0.0f; //no table yet
+
+  for(UINT i=Hash(c.m_pShape, c.m_pCircle, c.m_nFeature);; i=(i + 1) & m_nWarmMask){
+    const CWarmStart& w = m_stdWarm[i];
+    if(w.m_pShape == nullptr)return 0.0f; //empty slot, so not there
+
+    if(w.m_pShape == c.m_pShape && w.m_pCircle == c.m_pCircle && w.m_nFeature == c.m_nFeature)
+      return w.m_fImpulse;
+  } //for
+} //GetWarmStart
+
+/// Empty the warm start table and put the impulse of every contact with a
+/// non-zero impulse into it. The table is kept at least twice the size of
+/// the number of contacts so that probes are short and always end.
+
+void CContactSolver::SaveWarmStart(){
+  UINT n = MIN_WARM_SIZE; //table size
+
+  while(n < 2*m_stdContacts.size())
+    n *= 2;
+
+  m_stdWarm.assign(n, CWarmStart());
+  m_nWarmMask = n - 1;
+
+  for(auto const& c: m_stdContacts)
+    if(c.m_fImpulse > 0.0f){
+      UINT i = Hash(c.m_pShape, c.m_pCircle, c.m_nFeature);
+
+      while(m_stdWarm[i].m_pShape != nullptr)
+        i = (i + 1) & m_nWarmMask;
+
+      m_stdWarm[i].m_pShape = c.m_pShape;
+      m_stdWarm[i].m_pCircle = c.m_pCircle;
+      m_stdWarm[i].m_nFeature = c.m_nFeature;
+      m_stdWarm[i].m_fImpulse = c.m_fImpulse;
+    } //if
+} //SaveWarmStart
+
+/// Add a contact found by collision detection to the contact buffer,
+/// working out the relative normal speed that the collision response law
+/// for the shape's motion type asks for. These are the laws used by
+/// CDynamicCircle::PostCollide(), reduced to the component along the normal,
+/// which is the only one that they change. If the circle isn't approaching
+/// the shape, then all that is asked for is that it doesn't start to, and
+/// if it is a near miss, that it doesn't approach fast enough to overlap.
+/// \param cd Contact descriptor which has been filled in by collision detection.
+
+void CContactSolver::Add(const CContactDesc& cd){
+  CShape* pShape = cd.m_pShape;
+  CDynamicCircle* pCirc = cd.m_pCircle;
+  const eMotion motion = pShape->GetMotionType();
+
+  CSolverContact c;
+  c.m_pShape = pShape;
+  c.m_pCircle = pCirc;
+  c.m_nFeature = cd.m_nFeature;
+  c.m_vNorm = cd.m_vNorm;
+  c.m_fSetback = cd.m_fSetback;
+  c.m_nBody0 = GetBody(pCirc);
+  c.m_nBody1 = CSolverContact::NO_BODY;
+
+  const Vector2& n = c.m_vNorm; //shorthand
+  float invmass = m_stdInvMass[c.m_nBody0]; //sum of inverse masses
+  float v = m_stdVel[c.m_nBody0].Dot(n); //normal speed of circle
+  float vs = 0.0f; //normal speed of shape
+
+  if(motion == eMotion::Dynamic){
+    c.m_nBody1 = GetBody((CDynamicCircle*)pShape);
+    invmass += m_stdInvMass[c.m_nBody1];
+    vs = m_stdVel[c.m_nBody1].Dot(n);
+  } //if
+
+  else if(pShape->GetRotating()) //rotating kinematic shape
+    vs = pShape->GetRotSpeed()*XM_2PI*perp(cd.m_vPOI - pShape->GetRotCenter()).Dot(n);
+
+  c.m_fSurfaceSpeed = motion == eMotion::Dynamic? 0.0f: vs;
+  c.m_fMass = 1.0f/invmass;
+
+  const float e = pCirc->m_fElasticity*pShape->GetElasticity();
+
+  if(c.m_fSetback < 0.0f) //actual contact, not a near miss
+    CCollisionStats::PostCollide(motion);
+
+  if(c.m_fSetback >= 0.0f) //near miss
+    c.m_fTarget = -c.m_fSetback/m_fTimeStep;
+
+  else if(v - vs < 0.0f){ //approaching
+    switch(motion){
+      case eMotion::Static:
+        c.m_fTarget = e <= 1.0f? -e*v: e;
+      break;
+
+      case eMotion::Kinematic: {
+        float v1 = v < 0.0f? (e <= 1.0f? -e*v: e): v; //bounce as if static
+        if(vs - v1 >= 0.0f)v1 += e*(vs - v1); //then get pushed by the surface
+        c.m_fTarget = v1 - vs;
+      } //case
+      break;
+
+      case eMotion::Dynamic:
+        c.m_fTarget = -e*(v - vs);
+      break;
+
+      default: break; //eMotion::Size isn't a motion type
+    } //switch
+  } //else if
+
+  m_stdContacts.push_back(c);
+} //Add
+
+/// One iteration of the solver for one contact. The change in impulse is
+/// whatever gives the relative normal speed asked for, except that the
+/// accumulated impulse can't become negative, since a contact can push
+/// but not pull.
+/// \param c [in, out] A contact.
+
+void CContactSolver::Relax(CSolverContact& c){
+  Vector2& v0 = m_stdVel[c.m_nBody0];
+  const bool bDynamic = c.m_nBody1 != CSolverContact::NO_BODY;
+  float v = v0.Dot(c.m_vNorm) - c.m_fSurfaceSpeed; //relative normal speed
+
+  if(bDynamic)
+    v -= m_stdVel[c.m_nBody1].Dot(c.m_vNorm);
+
+  const float p = max(c.m_fImpulse + c.m_fMass*(c.m_fTarget - v), 0.0f); //new impulse
+  const float dp = p - c.m_fImpulse; //change in impulse
+  c.m_fImpulse = p;
+
+  v0 += dp*m_stdInvMass[c.m_nBody0]*c.m_vNorm;
+
+  if(bDynamic)
+    m_stdVel[c.m_nBody1] -= dp*m_stdInvMass[c.m_nBody1]*c.m_vNorm;
+} //Relax
+
+/// One setback iteration for one contact. This is Relax() for positions
+/// instead of velocities: the setback still needed is reduced by however far
+/// the bodies have already been moved along the normal, so that a dynamic
+/// circle touching both a line segment and the point at the end of it isn't
+/// set back twice, and the accumulated setback can't become negative.
+/// \param c [in, out] A contact.
+
+void CContactSolver::RelaxSetback(CSolverContact& c){
+  Vector2& s0 = m_stdSetback[c.m_nBody0];
+  const bool bDynamic = c.m_nBody1 != CSolverContact::NO_BODY;
+  float d = c.m_fSetback + s0.Dot(c.m_vNorm); //relative setback so far
+
+  if(bDynamic)
+    d -= m_stdSetback[c.m_nBody1].Dot(c.m_vNorm);
+
+  const float p = max(c.m_fPush - c.m_fMass*d, 0.0f); //new accumulated setback
+  const float dp = p - c.m_fPush; //change in accumulated setback
+  c.m_fPush = p;
+
+  s0 += dp*m_stdInvMass[c.m_nBody0]*c.m_vNorm;
+
+  if(bDynamic)
+    m_stdSetback[c.m_nBody1] -= dp*m_stdInvMass[c.m_nBody1]*c.m_vNorm;
+} //RelaxSetback
+
+/// Solve the contacts in the contact buffer. Each contact first gets the
+/// impulse that it had at the end of the previous substep, then the given
+/// number of iterations, but not fewer than the minimum, are done over all of
+/// the contacts, first for the impulses and then for the setbacks. Finally the
+/// new velocities and positions are given to the dynamic circles, without
+/// waking them, and the impulses are kept for the next substep.
+/// \param n Number of iterations.
+
+void CContactSolver::Solve(UINT n){
+  n = max(n, m_nMinIterations);
+
+  for(auto& c: m_stdContacts){ //warm start
+    c.m_fImpulse = GetWarmStart(c);
+    m_stdVel[c.m_nBody0] += c.m_fImpulse*m_stdInvMass[c.m_nBody0]*c.m_vNorm;
+
+    if(c.m_nBody1 != CSolverContact::NO_BODY)
+      m_stdVel[c.m_nBody1] -= c.m_fImpulse*m_stdInvMass[c.m_nBody1]*c.m_vNorm;
+  } //for
+
+  for(UINT i=0; i<n; i++){
+    CCollisionStats::Pass();
+
+    for(auto& c: m_stdContacts)
+      Relax(c);
+  } //for
+
+  for(UINT i=0; i<n; i++)
+    for(auto& c: m_stdContacts)
+      RelaxSetback(c);
+
+  for(UINT i=0; i<(UINT)m_stdBody.size(); i++){
+    CDynamicCircle* p = m_stdBody[i];
+    p->m_vVel = m_stdVel[i];
+    p->SetPos(p->GetPos() + m_stdSetback[i]);
+  } //for
+
+  SaveWarmStart();
+} //Solve
+
+/// Forget the warm start impulses. Call this when the shapes are removed,
+/// since a new shape might be made at the address of an old one.
+
+void CContactSolver::Clear(){
+  m_stdWarm.clear();
+  m_stdContacts.clear();
+} //Clear
+
+/// Set the fewest iterations that Solve() will do, whatever it is asked for.
+/// \param n Minimum number of iterations.
+
+void CContactSolver::SetMinIterations(UINT n){
+  m_nMinIterations = n;
+} //SetMinIterations
+
+/// Reader function for the number of contacts in the contact buffer.
+/// \return Number of contacts.
+
+const UINT CContactSolver::GetSize() const{
+  return (UINT)m_stdContacts.size();
+} //GetSize
@@ -0,0 +1,129 @@
+/// \file ContactSolver.h
+/// \brief Interface for the contact solver class CContactSolver.
+
+#ifndef __L4RC_PHYSICS_CONTACTSOLVER_H__
+#define __L4RC_PHYSICS_CONTACTSOLVER_H__
+
+#include <vector>
+
+#include "Contact.h"
+#include "ShapeCommon.h"
+
+/// \brief Solver contact.
+///
+/// A contact as the contact solver sees it, with everything that it needs
+/// worked out when the contact is added so that solving it touches nothing
+/// but this and the velocities of the bodies. The dynamic circles involved
+/// are referred to by their index in the solver's body arrays.
+
+class CSolverContact{
+  public:
+    CShape* m_pShape = nullptr; ///< Shape, which may be another dynamic circle.
+    CDynamicCircle* m_pCircle = nullptr; ///< Dynamic circle.
+    UINT m_nFeature = 0; ///< Which edge or vertex of the shape.
+
+    UINT m_nBody0 = 0; ///< Body index of the dynamic circle.
+    UINT m_nBody1 = 0; ///< Body index of the shape if dynamic, otherwise NO_BODY.
+
+    Vector2 m_vNorm; ///< Unit normal, pointing from the shape to the dynamic circle.
+    float m_fSurfaceSpeed = 0.0f; ///< Speed of the shape's surface along the normal.
+    float m_fMass = 0.0f; ///< Effective mass along the normal.
+    float m_fTarget = 0.0f; ///< Relative normal speed asked for by the collision law.
+    float m_fImpulse = 0.0f; ///< Normal impulse accumulated so far.
+    float m_fSetback = 0.0f; ///< Setback distance, negative for overlap and positive for a near miss.
+    float m_fPush = 0.0f; ///< Setback accumulated so far.
+
+    static const UINT NO_BODY = 0xFFFFFFFF; ///< Body index for a static or kinematic shape.
+}; //CSolverContact
+
+/// \brief Warm start record.
+///
+/// The normal impulse that a contact ended up with, kept from one substep
+/// to the next so that the same contact can start from it. A record with
+/// a null shape pointer is an empty slot in the warm start table.
+
+class CWarmStart{
+  public:
+    CShape* m_pShape = nullptr; ///< Shape.
+    CDynamicCircle* m_pCircle = nullptr; ///< Dynamic circle.
+    UINT m_nFeature = 0; ///< Which edge or vertex of the shape.
+    float m_fImpulse = 0.0f; ///< Accumulated normal impulse.
+}; //CWarmStart
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Contact solver.
+///
+/// Collision response in two phases. First, all of the contacts found in a
+/// substep are added to a contact buffer instead of being responded to one
+/// at a time as they are found. Then the contact solver finds the normal
+/// impulse for each contact by sequential impulses, that is, it visits each
+/// contact in turn and changes its impulse just enough to give the relative
+/// normal speed asked for, keeping the impulse accumulated over all of the
+/// iterations and clamping it, rather than each change, to be non-negative.
+/// Since an iteration can take back some of the impulse that an earlier one
+/// applied, the impulses converge towards the same solution whatever order
+/// the contacts are visited in, and a dynamic circle touching several shapes
+/// at once settles in a few iterations instead of being pushed back and forth.
+/// They only get close to it after a few iterations, though, and a single
+/// iteration is worse than responding to each contact as it is found, so the
+/// solver never does fewer than a minimum number of iterations, 4 by default,
+/// however few it is asked for.
+///
+/// The relative normal speed asked for is that given by the collision
+/// response laws in CDynamicCircle::PostCollide(), applied to the velocities
+/// at the start of the substep, so that a dynamic circle touching only one
+/// shape does exactly what it did before. The setbacks are solved the same
+/// way after the impulses, as a displacement accumulated over the iterations
+/// that can push but not pull, shared between pairs of dynamic circles in
+/// inverse proportion to their masses.
+///
+/// A near miss, that is, a contact with a positive setback distance found
+/// using the contact descriptor's margin, asks only that the gap doesn't
+/// close by more than its width in the next time step. Near misses don't
+/// bounce, but they stop a dynamic circle that is set back by one contact
+/// from being pushed into a neighbour that it wasn't quite touching.
+///
+/// Each contact starts with the impulse that it ended the previous substep
+/// with, if it existed then, which is called warm starting. A dynamic circle
+/// resting on a shape needs the same impulse every substep, so warm starting
+/// lets it settle with fewer iterations. The impulses are kept in a hash
+/// table with open addressing, keyed by the pointers to the shape and the
+/// dynamic circle and by the feature of the shape, since a chain can touch
+/// a dynamic circle with more than one of its edges at once, so that a
+/// contact finds its old impulse in constant time. Velocities are kept in an array
+/// indexed by body for the duration of the solve, so that the inner loop
+/// doesn't chase pointers.
+
+class CContactSolver: public CShapeCommon{
+  private:
+    std::vector<CSolverContact> m_stdContacts; ///< Contact buffer.
+    std::vector<CWarmStart> m_stdWarm; ///< Hash table of impulses from the previous substep.
+    UINT m_nWarmMask = 0; ///< Size of the warm start table minus one.
+
+    std::vector<CDynamicCircle*> m_stdBody; ///< Dynamic circles in contact.
+    std::vector<Vector2> m_stdVel; ///< Velocity of each body.
+    std::vector<Vector2> m_stdSetback; ///< Total setback of each body.
+    std::vector<float> m_stdInvMass; ///< Inverse mass of each body.
+
+    UINT m_nStamp = 0; ///< Stamp for this substep, to tell which circles are bodies.
+    UINT m_nMinIterations = 4; ///< Fewest iterations done by Solve().
+
+    UINT GetBody(CDynamicCircle*); ///< Get body index.
+    UINT Hash(const CShape*, const CDynamicCircle*, UINT) const; ///< Hash a contact.
+    float GetWarmStart(const CSolverContact&) const; ///< Find previous impulse.
+    void SaveWarmStart(); ///< Put impulses into the warm start table.
+    void Relax(CSolverContact&); ///< One iteration for one contact.
+    void RelaxSetback(CSolverContact&); ///< One setback iteration for one contact.
+
+  public:
+    void Begin(); ///< Start a substep.
+    void Add(const CContactDesc&); ///< Add a contact.
+    void Solve(UINT); ///< Solve contacts and apply the result.
+    void Clear(); ///< Forget warm start impulses.
+    void SetMinIterations(UINT); ///< Set fewest iterations.
+
+    const UINT GetSize() const; ///< Get number of contacts.
+}; //CContactSolver
+
+#endif //__L4RC_PHYSICS_CONTACTSOLVER_H__
@@ -1,154 +1,393 @@
-/// \file DynamicCircle.cpp
-/// \brief Code for the dynamic circle class CDynamicCircle and the dynamic circle descriptor class CDynamicCircleDesc.
-
-#include "DynamicCircle.h"
-#include "Contact.h"
-#include "ShapeMath.h"
-
-//////////////////////////////////////////////////////////////////////////////////////////////////
-// CDynamicCircleDesc functions.
-
-/// The default contructor creates a dynamic circle descriptor 
-/// consisting of the default circle descriptor and
-/// velocity zero.
-
-CDynamicCircleDesc::CDynamicCircleDesc(): CCircleDesc(){
-  m_eMotionType = eMotion::Dynamic;
-} //constructor
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-// CDynamicCircle functions.
-
-/// Constructs a dynamic circle described by a dynamic circle descriptor.
-/// \param r Dynamic circle descriptor.
-
-CDynamicCircle::CDynamicCircle(const CDynamicCircleDesc& r): 
-  CCircle(r), 
-  m_vVel(r.m_vVel),
-  m_fMass(XM_PI*r.m_fRadius*r.m_fRadius*r.m_fRadius)
-{
-  SetAABBPoint(Vector2(m_fRadius, 0.0f));
-  AddAABBPoint(Vector2(-m_fRadius, 0.0f));
-  AddAABBPoint(Vector2(0.0f, m_fRadius));
-  AddAABBPoint(Vector2(0.0f, -m_fRadius));
-} //constructor
-
-/// Does the AABB for this dynamic circle overlap the AABB for another dynamic circle?
-/// \param pCirc Pointer to a dynamic circle.
-/// \return true if their AABBs overlap.
-
-bool CDynamicCircle::AABBCollide(CDynamicCircle* pCirc){
-  return m_cAABB && pCirc->m_cAABB;
-} //AABBCollide
-
-/// Collision response for a dynamic circle colliding with a static shape. 
-/// \param cd Contact descriptor which has been filled in by collision detection.
-
-void CDynamicCircle::PostCollideStatic(const CContactDesc& cd){
-  const Vector2& nhat = cd.m_vNorm; //shorthand
-  SetPos(GetPos() - cd.m_fSetback*nhat); //set back to POI
-
-  if(m_vVel.Dot(nhat) < 0.0f){ //heading towards POI
-    const Vector2 dv = ParallelComponent(m_vVel, nhat); 
-    const float e = m_fElasticity*cd.m_pShape->GetElasticity();
-    m_vVel -= dv + e*(e <= 1.0f? dv: -nhat);
-  } //if
-} //PostCollideStatic
-
-/// Collision response for a dynamic circle colliding with a kinematic
-/// shape. This circle's velocity is affected by the kinematic shape's rotation.
-/// This code assumes that all elasticities are less than unity.
-/// \param cd Contact descriptor that has been filled in by collision detection.
-
-void CDynamicCircle::PostCollideKinematic(const CContactDesc& cd){ 
-  PostCollideStatic(cd); //start by reflecting off as if static
-
-  if(cd.m_pShape->GetRotating()){ //if actually rotating
-    Vector2& v0 = m_vVel; //shorthand for the dynamic circle's velocity
-    CShape* p = cd.m_pShape; //pointer to the kinematic shape being collided with
-
-    const Vector2 v1 = perp(cd.m_vPOI - p->GetRotCenter()); //tangent times POI's radius about kinematic shape's center of rotation
-    const Vector2 v2 = p->GetRotSpeed()*XM_2PI*v1 - v0; //POI's velocity relative to this dynamic circle
-    const Vector2 v3 = ParallelComponent(v2, GetPos() - cd.m_vPOI); //component of that through center of this dynamic circle
-
-    if(v2.Dot(cd.m_vNorm) >= 0.0f) //if bouncing off the front of the kinematic shape (need >= not > in case the dynamic circle is stationary)
-      v0 += m_fElasticity*cd.m_pShape->GetElasticity()*v3; //add to velocity of this dynamic circle
-  } //if
-} //PostCollideKinematic
-
-/// Collision response for a dynamic circle colliding with a dynamic shape. 
-/// \param cd Contact descriptor which has been filled in by collision detection.
-
-void CDynamicCircle::PostCollideDynamic(const CContactDesc& cd){
-  CDynamicCircle* pCirc = (CDynamicCircle*)(cd.m_pShape); //the other dynamic circle
-  const Vector2 nhat = cd.m_vNorm; //collision normal
-  
-  const float m0 = m_fMass; //mass of this dynamic circle
-  const float m1 = pCirc->m_fMass; //mass of the other dynamic circle
-  const float msum = m0 + m1; //sum of the masses
-  const float mdiff = m0 - m1; //difference of the masses
-
-  //setback distances are inversely proportional to masses,
-  //that is, the heavier one gets set back the least.
-
-  const Vector2 delta0 = m1*cd.m_fSetback*nhat/msum;
-  const Vector2 delta1 = m0*cd.m_fSetback*nhat/msum;
-
-  SetPos(GetPos() - 2.0f*delta0);
-  pCirc->SetPos(pCirc->GetPos() + delta1);
-
-  //now for the velocities
-  
-  Vector2& u = m_vVel; //shorthand
-  Vector2& v = pCirc->m_vVel; //shorthand
-  const Vector2 uperp = u.Dot(nhat)*nhat;
-  const Vector2 vperp = v.Dot(nhat)*nhat;
-
-  //kill the components along the normals
-  u -= uperp;
-  v -= vperp;
-
-  //Now apportion rebound velocities according to masses
-  //You need both the law of conservation of momentum and
-  //the law of conservation of energy to figure this one out.
-
-  const float e = m_fElasticity*pCirc->m_fElasticity; //collision elasticity
-
-  u += e*(2.0f*m1*vperp + mdiff*uperp)/msum; 
-  v += e*(2.0f*m0*uperp - mdiff*vperp)/msum; 
-} //PostCollideDynamic
-
-/// Collision response for a dynamic circle colliding with a shape. 
-/// \param cd Contact descriptor which has been filled in by collision detection.
-
-void CDynamicCircle::PostCollide(const CContactDesc& cd){
-  switch(cd.m_pShape->GetMotionType()){ 
-    case eMotion::Static:    PostCollideStatic(cd); break;
-    case eMotion::Kinematic: PostCollideKinematic(cd); break;
-    case eMotion::Dynamic:   PostCollideDynamic(cd); break;
-  } //switch
-} //PostCollide
-
-/// Move the shape using Euler integration, depending on the
-/// physics time step and the gravity constant.
-
-void CDynamicCircle::move(){ 
-  SetPos(GetPos() + m_fTimeStep*m_vVel); //move
-  m_vVel.y += m_fTimeStep*m_fGravity; //acceleration due to gravity
-} //move
-
-/// Reader function for the velocity.
-/// \return The velocity.
-
-Vector2 CDynamicCircle::GetVel(){
-  return m_vVel;
-} //GetVel
-
-/// Set the velocity to a new value.
-/// \param v New velocity.
-
-void CDynamicCircle::SetVel(const Vector2& v){
-  m_vVel = v;
-} //SetVel
-
-
+/// \file DynamicCircle.cpp
+/// \brief Code for the dynamic circle class CDynamicCircle and the dynamic circle descriptor class CDynamicCircleDesc.
+
+#include <cfloat>
+
+#include "DynamicCircle.h"
+#include "Contact.h"
+#include "ShapeMath.h"
+#include "CollisionStats.h"
+#include "ShapeStore.h"
+
+const float SLEEP_SPEED = 20.0f; ///< Speed below which a dynamic circle is still, in pixels per second.
+const float SLEEP_DISTANCE = 0.25f; ///< Distance moved per substep below which a dynamic circle is still, in pixels.
+const UINT SLEEP_SUBSTEPS = 60; ///< Number of substeps that a dynamic circle must be still before falling asleep.
+const float CCD_TOLERANCE = 0.25f; ///< Gap at which conservative advancement counts as an impact, in pixels.
+const UINT CCD_ITERATIONS = 32; ///< Most steps of conservative advancement per rotating shape.
+
+thread_local CDynamicCircle CDynamicCircle::m_cStandIn = CDynamicCircle(CDynamicCircleDesc());
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// CDynamicCircleDesc functions.
+
+/// The default contructor creates a dynamic circle descriptor 
+/// consisting of the default circle descriptor and
+/// velocity zero.
+
+CDynamicCircleDesc::CDynamicCircleDesc(): CCircleDesc(){
+  m_eMotionType = eMotion::Dynamic;
+} //constructor
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CDynamicCircle functions.
+
+/// Constructs a dynamic circle described by a dynamic circle descriptor.
+/// \param r Dynamic circle descriptor.
+
+CDynamicCircle::CDynamicCircle(const CDynamicCircleDesc& r): 
+  CCircle(r), 
+  m_vVel(r.m_vVel),
+  m_fMass(XM_PI*r.m_fRadius*r.m_fRadius*r.m_fRadius),
+  m_vLastPos(r.m_vPos)
+{
+  SetRadius(m_fRadius);
+} //constructor
+
+/// Set the radius and make the AABB fit it.
+/// \param r Radius.
+
+void CDynamicCircle::SetRadius(float r){
+  m_fRadius = r;
+
+  SetAABBPoint(Vector2(m_fRadius, 0.0f));
+  AddAABBPoint(Vector2(-m_fRadius, 0.0f));
+  AddAABBPoint(Vector2(0.0f, m_fRadius));
+  AddAABBPoint(Vector2(0.0f, -m_fRadius));
+} //SetRadius
+
+/// Does the AABB for this dynamic circle overlap the AABB for another dynamic circle?
+/// \param pCirc Pointer to a dynamic circle.
+/// \return true if their AABBs overlap.
+
+bool CDynamicCircle::AABBCollide(CDynamicCircle* pCirc){
+  return m_cAABB && pCirc->m_cAABB;
+} //AABBCollide
+
+/// Collision response for a dynamic circle colliding with a static shape. 
+/// \param cd Contact descriptor which has been filled in by collision detection.
+
+void CDynamicCircle::PostCollideStatic(const CContactDesc& cd){
+  const Vector2& nhat = cd.m_vNorm; //shorthand
+  SetPos(GetPos() - cd.m_fSetback*nhat); //set back to POI
+
+  if(m_vVel.Dot(nhat) < 0.0f){ //heading towards POI
+    const Vector2 dv = ParallelComponent(m_vVel, nhat); 
+    const float e = m_fElasticity*cd.m_pShape->GetElasticity();
+    m_vVel -= dv + e*(e <= 1.0f? dv: -nhat);
+  } //if
+} //PostCollideStatic
+
+/// Collision response for a dynamic circle colliding with a kinematic
+/// shape. This circle's velocity is affected by the kinematic shape's rotation.
+/// This code assumes that all elasticities are less than unity. Finally, the
+/// circle is never left moving into the surface more slowly than the surface
+/// is moving, or a fast rotating shape such as a flipper would catch up
+/// with it and pass through it before the next collision test.
+/// \param cd Contact descriptor that has been filled in by collision detection.
+
+void CDynamicCircle::PostCollideKinematic(const CContactDesc& cd){ 
+  PostCollideStatic(cd); //start by reflecting off as if static
+
+  if(cd.m_pShape->GetRotating()){ //if actually rotating
+    Vector2& v0 = m_vVel; //shorthand for the dynamic circle's velocity
+    CShape* p = cd.m_pShape; //pointer to the kinematic shape being collided with
+
+    const Vector2 v1 = perp(cd.m_vPOI - p->GetRotCenter()); //tangent times POI's radius about kinematic shape's center of rotation
+    const Vector2 v2 = p->GetRotSpeed()*XM_2PI*v1 - v0; //POI's velocity relative to this dynamic circle
+    const Vector2 v3 = ParallelComponent(v2, GetPos() - cd.m_vPOI); //component of that through center of this dynamic circle
+
+    if(v2.Dot(cd.m_vNorm) >= 0.0f) //if bouncing off the front of the kinematic shape (need >= not > in case the dynamic circle is stationary)
+      v0 += m_fElasticity*cd.m_pShape->GetElasticity()*v3; //add to velocity of this dynamic circle
+
+    const float vs = p->GetRotSpeed()*XM_2PI*v1.Dot(cd.m_vNorm); //normal speed of surface
+    const float vn = v0.Dot(cd.m_vNorm); //normal speed of this dynamic circle
+    if(vn < vs)v0 += (vs - vn)*cd.m_vNorm; //keep ahead of the surface
+  } //if
+} //PostCollideKinematic
+
+/// Collision response for a dynamic circle colliding with a dynamic shape. 
+/// \param cd Contact descriptor which has been filled in by collision detection.
+
+void CDynamicCircle::PostCollideDynamic(const CContactDesc& cd){
+  CDynamicCircle* pCirc = (CDynamicCircle*)(cd.m_pShape); //the other dynamic circle
+  const Vector2 nhat = cd.m_vNorm; //collision normal
+  
+  const float m0 = m_fMass; //mass of this dynamic circle
+  const float m1 = pCirc->m_fMass; //mass of the other dynamic circle
+  const float msum = m0 + m1; //sum of the masses
+  const float mdiff = m0 - m1; //difference of the masses
+
+  //setback distances are inversely proportional to masses,
+  //that is, the heavier one gets set back the least.
+
+  const Vector2 delta0 = m1*cd.m_fSetback*nhat/msum;
+  const Vector2 delta1 = m0*cd.m_fSetback*nhat/msum;
+
+  SetPos(GetPos() - 2.0f*delta0);
+  pCirc->SetPos(pCirc->GetPos() + delta1);
+
+  //now for the velocities
+  
+  Vector2& u = m_vVel; //shorthand
+  Vector2& v = pCirc->m_vVel; //shorthand
+  const Vector2 uperp = u.Dot(nhat)*nhat;
+  const Vector2 vperp = v.Dot(nhat)*nhat;
+
+  //kill the components along the normals
+  u -= uperp;
+  v -= vperp;
+
+  //Now apportion rebound velocities according to masses
+  //You need both the law of conservation of momentum and
+  //the law of conservation of energy to figure this one out.
+
+  const float e = m_fElasticity*pCirc->m_fElasticity; //collision elasticity
+
+  u += e*(2.0f*m1*vperp + mdiff*uperp)/msum; 
+  v += e*(2.0f*m0*uperp - mdiff*vperp)/msum; 
+} //PostCollideDynamic
+
+/// Collision response for a dynamic circle colliding with a shape. 
+/// \param cd Contact descriptor which has been filled in by collision detection.
+
+void CDynamicCircle::PostCollide(const CContactDesc& cd){
+  CCollisionStats::PostCollide(cd.m_pShape->GetMotionType());
+
+  switch(cd.m_pShape->GetMotionType()){ 
+    case eMotion::Static:    PostCollideStatic(cd); break;
+    case eMotion::Kinematic: PostCollideKinematic(cd); break;
+    case eMotion::Dynamic:   PostCollideDynamic(cd); break;
+    default:                 break;
+  } //switch
+} //PostCollide
+
+/// Move the shape using Euler integration, depending on the
+/// physics time step and the gravity constant.
+
+void CDynamicCircle::move(){ 
+  move(1.0f);
+} //move
+
+/// Move the shape through part of the physics time step using Euler
+/// integration. This is used to advance to the time of impact found
+/// by TimeOfImpact() and then on through the rest of the time step.
+/// A dynamic circle that is asleep doesn't move.
+/// \param f Fraction of the time step.
+
+void CDynamicCircle::move(float f){ 
+  if(m_bAsleep)return; //asleep, so stay put
+
+  const float dt = f*m_fTimeStep; //time to move for
+  SetPos(GetPos() + dt*m_vVel); //move
+  m_vVel.y += dt*m_fGravity; //acceleration due to gravity
+} //move
+
+/// A dynamic circle that moves more than half of its radius in a single time
+/// step might end up with its center on the far side of a thin shape such as a 
+/// line segment, or even pass right through it without ever overlapping it. 
+/// Such a dynamic circle needs to be moved using TimeOfImpact() instead
+/// of just move().
+/// \return true if it's moving fast enough to tunnel.
+
+bool CDynamicCircle::IsFast() const{
+  return m_vVel.LengthSquared()*sqr(m_fTimeStep) > sqr(0.5f*m_fRadius);
+} //IsFast
+
+/// Get the AABB that this dynamic circle sweeps out as it moves through
+/// part of the time step, ignoring gravity.
+/// \param f Fraction of the time step.
+/// \return The AABB of both the start and end positions.
+
+CAabb2D CDynamicCircle::GetSweptAABB(float f) const{
+  CAabb2D aabb = m_cAABB;
+  aabb.Translate(f*m_fTimeStep*m_vVel); //AABB at end position
+  aabb += m_cAABB; //AABB at start position
+  return aabb;
+} //GetSweptAABB
+
+/// Find the earliest time of impact with a list of shapes as this dynamic
+/// circle moves in a straight line through part of the time step. Only
+/// static shapes that aren't sensors are tested, since those are the only
+/// ones whose collision response will stop it.
+/// \param shapes List of shapes that it might hit.
+/// \param f [in, out] Fraction of the time step, changed to the fraction
+///   at which the impact takes place if there is one.
+/// \param c [out] Contact descriptor for the earliest impact.
+/// \return true if it hits one of the shapes.
+
+bool CDynamicCircle::TimeOfImpact(const std::vector<CShape*>& shapes, float& f, CContactDesc& c){
+  const Vector2 v = f*m_fTimeStep*m_vVel; //displacement
+  float t = 1.0f; //time of earliest impact, as a fraction of v
+  bool bHit = false; //whether anything was hit
+
+  c.m_pCircle = this;
+
+  for(auto const& p: shapes)
+    if(p->GetMotionType() == eMotion::Static && !p->GetSensor())
+      bHit = CShapeStore::TimeOfImpact(p, c, v, t) || bHit; //no virtual call
+
+  FailIf(!bHit);
+
+  f *= t;
+  return true;
+} //TimeOfImpact
+
+/// Find the time of impact with a rotating kinematic shape by conservative
+/// advancement. The kinematic shape has already been rotated to where it
+/// will be at the end of the time step, so instead of turning it back, this
+/// dynamic circle is turned forward about the center of rotation by however
+/// far the shape lags that orientation, which puts it in the same place
+/// relative to the shape. Its distance from the shape is then found by
+/// PreCollide() using a stand-in with an unlimited margin. The stand-in is
+/// made once per thread and reused, and the shape store's PreCollide() is
+/// used so that there is no virtual call in the loop. Neither the
+/// distance from this dynamic circle to the center of rotation nor its
+/// distance from the shape can change faster than its own speed plus the
+/// angular speed times that distance from the center, so it can safely be
+/// advanced by the distance from the shape divided by that bound, and then
+/// the distance is found again. An impact is a gap of less than
+/// CCD_TOLERANCE across which the circle and the surface are approaching,
+/// which may be at time zero if it starts off touching a surface that is
+/// moving into it, as when a flipper flips under a ball resting on it. A
+/// shape for which PreCollide() gives no contact at all, such as a line
+/// segment beside its end points, is left to PreCollide() after the move.
+/// \param p Pointer to a rotating kinematic shape.
+/// \param v Displacement of this dynamic circle.
+/// \param lag Angle by which the shape lags its current orientation at time 0.
+/// \param turn Angle through which the shape turns from time 0 to time 1.
+/// \param t [in, out] Earliest time of impact found so far.
+/// \param c [out] Contact descriptor, filled in if there is an impact before time t.
+/// \return true if there was an impact before time t.
+
+bool CDynamicCircle::RotatingTOI(CShape* p, const Vector2& v, float lag, float turn,
+  float& t, CContactDesc& c)
+{
+  const Vector2 center = p->GetRotCenter(); //center of rotation
+  const float bound = v.Length() + fabsf(turn)*((GetPos() - center).Length() + v.Length()); //fastest approach
+  FailIf(bound <= 0.0f); //nothing is moving
+
+  CDynamicCircle& ghost = m_cStandIn; //stand-in, moved into the shape's current frame
+  if(ghost.m_fRadius != m_fRadius)ghost.SetRadius(m_fRadius);
+  ghost.m_vVel = m_vVel;
+
+  CContactDesc cd(p, &ghost);
+  cd.m_fMargin = FLT_MAX; //always find the closest point
+
+  float u = 0.0f; //time
+
+  for(UINT i=0; i<CCD_ITERATIONS; i++){
+    const float a = lag - u*turn; //angle by which the shape lags at time u
+    const float s = sinf(a);
+    const float co = cosf(a);
+
+    ghost.SetPos(RotatePt(GetPos() + u*v, center, s, co));
+    FailIf(!CShapeStore::PreCollide(p, cd)); //no closest point
+
+    if(cd.m_fSetback < CCD_TOLERANCE){ //touching or nearly, so back into the world frame
+      const Vector2 poi = RotatePt(cd.m_vPOI, center, -s, co);
+      const Vector2 n = RotatePt(cd.m_vNorm, Vector2(0.0f), -s, co);
+      const float vs = p->GetRotSpeed()*XM_2PI*perp(poi - center).Dot(n); //normal speed of surface
+      FailIf(m_vVel.Dot(n) >= vs); //not approaching
+
+      c.m_pShape = p;
+      c.m_pCircle = this;
+      c.m_vPOI = poi;
+      c.m_vNorm = n;
+      c.m_fSetback = cd.m_fSetback;
+      c.m_fSpeed = m_vVel.Length();
+      c.m_nFeature = cd.m_nFeature;
+      t = u;
+      return true;
+    } //if
+
+    u += cd.m_fSetback/bound;
+    FailIf(u >= t); //no impact in time
+  } //for
+
+  return false; //too close to call, so left to PreCollide()
+} //RotatingTOI
+
+/// Find the earliest time of impact with a list of kinematic shapes as this
+/// dynamic circle moves in a straight line through part of the time step
+/// while the shapes rotate. The kinematic shapes are assumed to have already
+/// been rotated to where they will be at the end of the time step. Only those
+/// that are rotating and aren't sensors are tested, since a shape that isn't
+/// rotating can't catch up with a dynamic circle that PreCollide() missed.
+/// \param shapes List of kinematic shapes that it might hit.
+/// \param s Fraction of the time step that has already gone by.
+/// \param f [in, out] Fraction of the time step, changed to the fraction
+///   at which the impact takes place if there is one.
+/// \param c [out] Contact descriptor for the earliest impact.
+/// \return true if it hits one of the shapes.
+
+bool CDynamicCircle::KinematicTOI(const std::vector<CShape*>& shapes, float s, float& f, CContactDesc& c){
+  const Vector2 v = f*m_fTimeStep*m_vVel; //displacement
+  float t = 1.0f; //time of earliest impact, as a fraction of v
+  bool bHit = false; //whether anything was hit
+
+  for(auto const& p: shapes)
+    if(p->GetRotating() && !p->GetSensor()){
+      const float w = XM_2PI*p->GetRotSpeed()*m_fTimeStep; //angle turned in a time step
+      bHit = RotatingTOI(p, v, w*(1.0f - s), w*f, t, c) || bHit;
+    } //if
+
+  FailIf(!bHit);
+
+  f *= t;
+  return true;
+} //KinematicTOI
+
+/// Reader function for the velocity.
+/// \return The velocity.
+
+Vector2 CDynamicCircle::GetVel(){
+  return m_vVel;
+} //GetVel
+
+/// Set the velocity to a new value.
+/// \param v New velocity.
+
+void CDynamicCircle::SetVel(const Vector2& v){
+  m_vVel = v;
+  Wake();
+} //SetVel
+
+/// A dynamic circle is still if its speed and the distance that it has moved
+/// since the last call to this function are both small. One that has been still
+/// for SLEEP_SUBSTEPS consecutive calls falls asleep, which means that it stops 
+/// moving and that collision detection can skip it until something wakes it up.
+/// Call this once per substep.
+
+void CDynamicCircle::UpdateSleep(){
+  if(m_bAsleep)return; //already asleep
+
+  const Vector2 p = GetPos();
+  const bool bStill = m_vVel.LengthSquared() < sqr(SLEEP_SPEED) &&
+    (p - m_vLastPos).LengthSquared() < sqr(SLEEP_DISTANCE);
+  m_vLastPos = p;
+
+  if(!bStill)
+    m_nStillCount = 0;
+
+  else if(++m_nStillCount >= SLEEP_SUBSTEPS){
+    m_bAsleep = true;
+    m_vVel = Vector2(0.0f);
+  } //else if
+} //UpdateSleep
+
+/// Wake up so that it moves and collides again. It must be still
+/// for another SLEEP_SUBSTEPS substeps before it can fall asleep again.
+
+void CDynamicCircle::Wake(){
+  m_bAsleep = false;
+  m_nStillCount = 0;
+} //Wake
+
+/// Reader function for the sleep state.
+/// \return true if asleep.
+
+const bool CDynamicCircle::IsAsleep() const{
+  return m_bAsleep;
+} //IsAsleep
+
+
@@ -1,48 +1,76 @@
-/// \file DynamicCircle.h
-/// \brief Interface for CDynamicCircleDesc and CDynamicCircle.
-
-#ifndef __L4RC_PHYSICS_DYNAMICCIRCLE_H__
-#define __L4RC_PHYSICS_DYNAMICCIRCLE_H__
-
-#include "LineSeg.h"
-#include "Arc.h"
-
-/// \brief Dynamic circle descriptor.
-///
-/// The dynamic circle descriptor describes a dynamic circle.
-
-class CDynamicCircleDesc: public CCircleDesc{
-  public:
-    Vector2 m_vVel; ///< Velocity. Speed is measured in pixels per second.
-
-    CDynamicCircleDesc(); ///< Constructor.
-}; //CDynamicCircleDesc
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////
-
-/// \brief Dynamic circle.
-///
-/// A dynamic circle is a circle shape that moves and can collide with 
-/// static, kinematic, and dynamic shapes.
-
-class CDynamicCircle: public CCircle{
-  private:
-    Vector2 m_vVel; ///< Velocity. Speed is measured in pixels per second.
-    float m_fMass = 0.0f; ///< Mass.
-    
-    void PostCollideStatic(const CContactDesc&); ///< Collision response for static shape.
-    void PostCollideKinematic(const CContactDesc&); ///< Collision response for kinematic shape.
-    void PostCollideDynamic(const CContactDesc&); ///< Collision response for dynamic shape.
-
-  public:
-    CDynamicCircle(const CDynamicCircleDesc&); ///< Constructor.
-    void move(); ///< Move using Euler integration.
-    
-    bool AABBCollide(CDynamicCircle*);  ///< Collide detection using AABBs.
-    void PostCollide(const CContactDesc&);  ///< Collision response 
-
-    Vector2 GetVel(); ///< Get velocity.  
-    void SetVel(const Vector2&); ///< Set velocity.
-}; //CDynamicCircle
-
+/// \file DynamicCircle.h
+/// \brief Interface for CDynamicCircleDesc and CDynamicCircle.
+
+#ifndef __L4RC_PHYSICS_DYNAMICCIRCLE_H__
+#define __L4RC_PHYSICS_DYNAMICCIRCLE_H__
+
+#include <vector>
+
+#include "LineSeg.h"
+#include "Arc.h"
+
+/// \brief Dynamic circle descriptor.
+///
+/// The dynamic circle descriptor describes a dynamic circle.
+
+class CDynamicCircleDesc: public CCircleDesc{
+  public:
+    Vector2 m_vVel; ///< Velocity. Speed is measured in pixels per second.
+
+    CDynamicCircleDesc(); ///< Constructor.
+}; //CDynamicCircleDesc
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Dynamic circle.
+///
+/// A dynamic circle is a circle shape that moves and can collide with 
+/// static, kinematic, and dynamic shapes.
+
+class CDynamicCircle: public CCircle{
+  friend class CContactSolver; ///< Changes velocities without waking.
+  friend class CSweepAndPrune; ///< Keeps track of where its entry is.
+
+  private:
+    Vector2 m_vVel; ///< Velocity. Speed is measured in pixels per second.
+    float m_fMass = 0.0f; ///< Mass.
+
+    bool m_bAsleep = false; ///< Whether it's asleep.
+    UINT m_nStillCount = 0; ///< Number of substeps for which it has been still.
+    Vector2 m_vLastPos; ///< Position at the last call to UpdateSleep().
+
+    UINT m_nSolverStamp = 0; ///< Contact solver's stamp when it was last made a body.
+    UINT m_nSolverBody = 0; ///< Contact solver's body index, if the stamp is current.
+    UINT m_nSweepIndex = 0; ///< Index of its entry in sweep and prune.
+
+    static thread_local CDynamicCircle m_cStandIn; ///< Stand-in for conservative advancement.
+    
+    void SetRadius(float); ///< Set radius and AABB.
+    void PostCollideStatic(const CContactDesc&); ///< Collision response for static shape.
+    void PostCollideKinematic(const CContactDesc&); ///< Collision response for kinematic shape.
+    void PostCollideDynamic(const CContactDesc&); ///< Collision response for dynamic shape.
+
+    bool RotatingTOI(CShape*, const Vector2&, float, float, float&, CContactDesc&); ///< Time of impact with a rotating shape.
+
+  public:
+    CDynamicCircle(const CDynamicCircleDesc&); ///< Constructor.
+    void move(); ///< Move using Euler integration.
+    void move(float); ///< Move through part of a time step.
+    
+    bool AABBCollide(CDynamicCircle*);  ///< Collide detection using AABBs.
+    void PostCollide(const CContactDesc&);  ///< Collision response 
+
+    bool IsFast() const; ///< Might it tunnel through a thin shape?
+    CAabb2D GetSweptAABB(float) const; ///< Get AABB swept through part of a time step.
+    bool TimeOfImpact(const std::vector<CShape*>&, float&, CContactDesc&); ///< Find earliest impact.
+    bool KinematicTOI(const std::vector<CShape*>&, float, float&, CContactDesc&); ///< Find earliest impact with rotating shapes.
+
+    Vector2 GetVel(); ///< Get velocity.  
+    void SetVel(const Vector2&); ///< Set velocity.
+
+    void UpdateSleep(); ///< Fall asleep if still for long enough.
+    void Wake(); ///< Wake up.
+    const bool IsAsleep() const; ///< Is it asleep?
+}; //CDynamicCircle
+
 #endif //__L4RC_PHYSICS_DYNAMICCIRCLE_H__
\ No newline at end of file
@@ -0,0 +1,412 @@
+/// \file Grid.cpp
+/// \brief Code for the uniform grid class CGrid.
+
+#include <algorithm>
+
+#include "Grid.h"
+#include "CollisionStats.h"
+
+/// Check that a list of cell lists has a start for each cell plus one past
+/// the end, that the starts run in order up to the end of the list, and that
+/// every index in the list is in range.
+/// \param start Start of each cell's list, plus one past the end.
+/// \param list Indices for all cells, cell by cell.
+/// \param nCells Number of cells.
+/// \param n Number of shapes that the indices refer to.
+/// \return true if the cell lists are consistent.
+
+static bool IsValidList(const std::vector<UINT>& start, const std::vector<UINT>& list,
+  size_t nCells, UINT n)
+{
+  FailIf(start.size() != nCells + 1 || start.front() != 0);
+  FailIf(start.back() != (UINT)list.size());
+
+  for(size_t i=1; i<start.size(); i++)
+    FailIf(start[i] < start[i - 1]);
+
+  for(auto const& j: list)
+    FailIf(j >= n);
+
+  return true;
+} //IsValidList
+
+/// Does the index fit a list of shapes? It must have been made for the same
+/// number of static line segments and other shapes, and its cell lists must
+/// be consistent with the number of cells. An index that has been read
+/// from file may not be.
+/// \param nLineSegs Number of static line segments.
+/// \param nOthers Number of other shapes.
+/// \return true if the index can be used to build a grid.
+
+bool CGridIndex::IsValid(UINT nLineSegs, UINT nOthers) const{
+  if(m_fCellSize == 0.0f) //empty index
+    return m_stdCellStart.empty() && m_stdCellList.empty() &&
+      m_stdLineSegStart.empty() && m_stdLineSegList.empty();
+
+  FailIf(!(m_fCellSize > 0.0f) || !isfinite(m_fCellSize)); //catches NaN too
+  FailIf(!isfinite(m_vOrigin.x) || !isfinite(m_vOrigin.y));
+  FailIf(m_nCols == 0 || m_nRows == 0);
+
+  const size_t nCells = (size_t)m_nCols*m_nRows;
+
+  return IsValidList(m_stdCellStart, m_stdCellList, nCells, nOthers) &&
+    IsValidList(m_stdLineSegStart, m_stdLineSegList, nCells, nLineSegs);
+} //IsValid
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Build the grid from a list of shapes. The grid is made just big enough
+/// to cover the AABBs of all of the shapes. Static line segments are copied
+/// into the line segment batch cell by cell, and the remaining shapes go
+/// into the cell lists.
+/// \param shapes List of shapes to put in the grid.
+/// \param s Width and height of a cell.
+
+void CGrid::Build(const std::vector<CShape*>& shapes, float s){
+  CGridIndex index;
+  MakeIndex(shapes, s, index);
+  Build(shapes, index);
+} //Build
+
+/// Work out the size and position of the grid and the cell lists for a list
+/// of shapes, as Build() does, without putting the shapes into the grid.
+/// \param shapes List of shapes to put in the grid.
+/// \param s Width and height of a cell.
+/// \param index [out] Grid index.
+
+void CGrid::MakeIndex(const std::vector<CShape*>& shapes, float s, CGridIndex& index){
+  Clear();
+  index = CGridIndex();
+
+  if(shapes.empty() || s <= 0.0f)return; //nothing to do
+
+  m_fCellSize = s;
+  m_fInvCellSize = 1.0f/s;
+
+  //find the extent of the grid
+
+  CAabb2D aabb = shapes[0]->GetAABB();
+
+  for(auto const& p: shapes)
+    aabb += p->GetAABB();
+
+  m_vOrigin = Vector2(aabb.GetTopLeft().x, aabb.GetBottomRt().y);
+  m_nCols = (UINT)floorf(aabb.GetWidth()*m_fInvCellSize) + 1;
+  m_nRows = (UINT)floorf(aabb.GetHt()*m_fInvCellSize) + 1;
+
+  index.m_vOrigin = m_vOrigin;
+  index.m_fCellSize = m_fCellSize;
+  index.m_nCols = m_nCols;
+  index.m_nRows = m_nRows;
+
+  //separate out the static line segments
+
+  std::vector<CShape*> linesegs, others;
+
+  for(auto const& p: shapes)
+    if(p->GetShapeType() == eShape::LineSeg && p->GetMotionType() == eMotion::Static)
+      linesegs.push_back(p);
+    else others.push_back(p);
+
+  Bucket(others, index.m_stdCellStart, index.m_stdCellList);
+  Bucket(linesegs, index.m_stdLineSegStart, index.m_stdLineSegList);
+} //MakeIndex
+
+/// Build the grid from a list of shapes and a grid index made by MakeIndex()
+/// for the same shapes in the same order. Nothing is worked out from the
+/// shapes' AABBs, the shapes are just put where the index says they go.
+/// If the index doesn't fit the shapes, it is ignored and the grid is built
+/// from the shapes' AABBs instead.
+/// \param shapes List of shapes to put in the grid.
+/// \param index Grid index.
+
+void CGrid::Build(const std::vector<CShape*>& shapes, const CGridIndex& index){
+  Clear();
+
+  if(!(index.m_fCellSize > 0.0f))return; //nothing to do, or NaN
+
+  //separate out the static line segments
+
+  std::vector<CShape*> linesegs;
+
+  for(auto const& p: shapes)
+    if(p->GetShapeType() == eShape::LineSeg && p->GetMotionType() == eMotion::Static)
+      linesegs.push_back(p);
+    else m_stdShapes.push_back(p);
+
+  if(!index.IsValid((UINT)linesegs.size(), (UINT)m_stdShapes.size())){
+    Build(shapes, index.m_fCellSize); //work it out again
+    return;
+  } //if
+
+  m_vOrigin = index.m_vOrigin;
+  m_fCellSize = index.m_fCellSize;
+  m_fInvCellSize = 1.0f/index.m_fCellSize;
+  m_nCols = index.m_nCols;
+  m_nRows = index.m_nRows;
+
+  //other shapes go into the cell lists
+
+  m_stdCellStart = index.m_stdCellStart;
+  m_stdCellList = index.m_stdCellList;
+  m_stdStamp.assign(m_stdShapes.size(), 0);
+
+  //line segments go into the batch in cell order
+
+  const std::vector<UINT>& start = index.m_stdLineSegStart; //shorthand
+  const std::vector<UINT>& list = index.m_stdLineSegList; //shorthand
+
+  m_stdLineSegStart.resize(start.size());
+
+  for(size_t cell=0; cell<start.size() - 1; cell++){
+    m_stdLineSegStart[cell] = m_cLineSegs.GetSize();
+
+    for(UINT j=start[cell]; j<start[cell + 1]; j++)
+      m_cLineSegs.Add((CLineSeg*)linesegs[list[j]], list[j]);
+  } //for
+
+  m_stdLineSegStart.back() = m_cLineSegs.GetSize();
+  m_nLineSegs = (UINT)linesegs.size();
+  m_stdLineSegStamp.assign(linesegs.size(), 0);
+} //Build
+
+/// Sort shapes into cells. The cell lists are built in two passes, the
+/// first of which counts the number of shapes in each cell so that the
+/// second can drop them straight into place in a single array.
+/// \param shapes List of shapes.
+/// \param start [out] Start of each cell's list, plus one past the end.
+/// \param list [out] Shape indices for all cells, cell by cell.
+
+void CGrid::Bucket(const std::vector<CShape*>& shapes, 
+  std::vector<UINT>& start, std::vector<UINT>& list) const
+{
+  //count the shapes in each cell
+
+  start.assign(m_nCols*m_nRows + 1, 0);
+  UINT x0, x1, y0, y1; //cell range
+
+  for(auto const& p: shapes)
+    if(GetCells(p->GetAABB(), x0, x1, y0, y1))
+      for(UINT y=y0; y<=y1; y++)
+        for(UINT x=x0; x<=x1; x++)
+          ++start[y*m_nCols + x + 1];
+
+  for(size_t i=1; i<start.size(); i++) //running total
+    start[i] += start[i - 1];
+
+  //drop the shapes into their cells
+
+  list.resize(start.back());
+  std::vector<UINT> next(start.begin(), start.end() - 1);
+
+  for(UINT i=0; i<(UINT)shapes.size(); i++)
+    if(GetCells(shapes[i]->GetAABB(), x0, x1, y0, y1))
+      for(UINT y=y0; y<=y1; y++)
+        for(UINT x=x0; x<=x1; x++)
+          list[next[y*m_nCols + x]++] = i;
+} //Bucket
+
+/// Remove all of the shapes from the grid. The shapes
+/// themselves are not deleted, so beware.
+
+void CGrid::Clear(){
+  m_stdShapes.clear();
+  m_stdCellStart.clear();
+  m_stdCellList.clear();
+  m_stdStamp.clear();
+
+  m_cLineSegs.Clear();
+  m_stdLineSegStart.clear();
+  m_stdLineSegStamp.clear();
+  m_nLineSegs = 0;
+
+  m_nCols = m_nRows = 0;
+  m_nStamp = 0;
+} //Clear
+
+/// Get the range of cells overlapped by an AABB, clamped to the grid.
+/// \param aabb An AABB.
+/// \param x0 [out] Leftmost column.
+/// \param x1 [out] Rightmost column.
+/// \param y0 [out] Bottom row.
+/// \param y1 [out] Top row.
+/// \return true if the AABB overlaps the grid.
+
+bool CGrid::GetCells(const CAabb2D& aabb, UINT& x0, UINT& x1, UINT& y0, UINT& y1) const{
+  const Vector2 p0 = (Vector2(aabb.GetTopLeft().x, aabb.GetBottomRt().y) - m_vOrigin)*m_fInvCellSize;
+  const Vector2 p1 = (Vector2(aabb.GetBottomRt().x, aabb.GetTopLeft().y) - m_vOrigin)*m_fInvCellSize;
+
+  FailIf(p1.x < 0.0f || p1.y < 0.0f); //below or left of the grid
+  FailIf(p0.x >= (float)m_nCols || p0.y >= (float)m_nRows); //above or right of the grid
+
+  x0 = (UINT)max(0.0f, p0.x);
+  y0 = (UINT)max(0.0f, p0.y);
+  x1 = min(m_nCols - 1, (UINT)p1.x);
+  y1 = min(m_nRows - 1, (UINT)p1.y);
+
+  return true;
+} //GetCells
+
+/// Move on to a new stamp so that shapes found by earlier queries
+/// don't look like they have already been found by this one.
+
+void CGrid::NextStamp(){
+  if(++m_nStamp == 0){ //stamps have wrapped around, so start again
+    std::fill(m_stdStamp.begin(), m_stdStamp.end(), 0);
+    std::fill(m_stdLineSegStamp.begin(), m_stdLineSegStamp.end(), 0);
+    m_nStamp = 1;
+  } //if
+} //NextStamp
+
+/// Get the shapes in the cells overlapped by an AABB. A shape that is
+/// in more than one of those cells is reported only once. Note that this
+/// doesn't test the AABB against the shapes' AABBs, it only tells you
+/// which shapes are close enough to be worth testing. Static line segments
+/// are not reported, use Collide() for those.
+/// \param aabb An AABB.
+/// \param result [out] List of shapes near the AABB.
+
+void CGrid::Query(const CAabb2D& aabb, std::vector<CShape*>& result){
+  result.clear();
+
+  UINT x0, x1, y0, y1; //cell range
+  if(!GetCells(aabb, x0, x1, y0, y1))return; //nowhere near the grid
+
+  NextStamp();
+
+  for(UINT y=y0; y<=y1; y++)
+    for(UINT x=x0; x<=x1; x++){
+      const UINT cell = y*m_nCols + x;
+
+      for(UINT j=m_stdCellStart[cell]; j<m_stdCellStart[cell + 1]; j++){
+        const UINT i = m_stdCellList[j]; //index of shape
+
+        if(m_stdStamp[i] != m_nStamp){ //not already found
+          m_stdStamp[i] = m_nStamp;
+          result.push_back(m_stdShapes[i]);
+        } //if
+      } //for
+    } //for
+} //Query
+
+/// Get the static line segments in the cells overlapped by an AABB. A line
+/// segment that is in more than one of those cells is reported only once.
+/// Unlike Query(), this appends to the result instead of replacing it, so
+/// that the two can be used together to get all of the shapes near an AABB.
+/// \param aabb An AABB.
+/// \param result [in, out] List of shapes to append the line segments to.
+
+void CGrid::QueryLineSegs(const CAabb2D& aabb, std::vector<CShape*>& result){
+  UINT x0, x1, y0, y1; //cell range
+  if(!GetCells(aabb, x0, x1, y0, y1))return; //nowhere near the grid
+
+  NextStamp();
+
+  for(UINT y=y0; y<=y1; y++)
+    for(UINT x=x0; x<=x1; x++){
+      const UINT cell = y*m_nCols + x;
+
+      for(UINT i=m_stdLineSegStart[cell]; i<m_stdLineSegStart[cell + 1]; i++){
+        const UINT id = m_cLineSegs.GetId(i);
+
+        if(m_stdLineSegStamp[id] != m_nStamp){ //not already found
+          m_stdLineSegStamp[id] = m_nStamp;
+          result.push_back(m_cLineSegs.GetLineSeg(i));
+        } //if
+      } //for
+    } //for
+} //QueryLineSegs
+
+/// Find the static line segments that collide with a dynamic circle, testing
+/// the circle against all of the line segments in each cell that its AABB
+/// overlaps using CLineSegBatch::Collide(). A line segment that is in more than
+/// one of those cells is reported only once. The contact descriptors are all
+/// computed from the circle's current position, so once the first one has been
+/// used for collision response the rest should be checked again using
+/// CLineSeg::PreCollide().
+/// \param pCirc Pointer to a dynamic circle.
+/// \param result [out] Contact descriptors for the collisions found.
+
+void CGrid::Collide(CDynamicCircle* pCirc, std::vector<CContactDesc>& result){
+  result.clear();
+
+  UINT x0, x1, y0, y1; //cell range
+  if(!GetCells(pCirc->GetAABB(), x0, x1, y0, y1))return; //nowhere near the grid
+
+  NextStamp();
+  UINT tests = 0; //number of line segments tested
+
+  for(UINT y=y0; y<=y1; y++)
+    for(UINT x=x0; x<=x1; x++){
+      const UINT cell = y*m_nCols + x;
+      const UINT begin = m_stdLineSegStart[cell];
+      const UINT end = m_stdLineSegStart[cell + 1];
+
+      m_stdHits.clear();
+      m_cLineSegs.Collide(pCirc, begin, end, m_stdHits);
+      tests += end - begin;
+
+      for(auto const& i: m_stdHits){
+        const UINT id = m_cLineSegs.GetId(i);
+
+        if(m_stdLineSegStamp[id] != m_nStamp){ //not already found
+          m_stdLineSegStamp[id] = m_nStamp;
+          result.push_back(CContactDesc(nullptr, pCirc));
+          m_cLineSegs.GetContact(i, result.back());
+        } //if
+      } //for
+    } //for
+
+  CCollisionStats::PreCollide(eShape::LineSeg, tests, (UINT)result.size());
+} //Collide
+
+/// Find the static line segments that a dynamic circle is colliding with or 
+/// is within a margin of colliding with, using CLineSegBatch::Collide() in
+/// the same way as Collide(). This is for finding candidates that will be
+/// checked again using CLineSeg::PreCollide() after the circle has moved 
+/// by no more than the margin.
+/// \param pCirc Pointer to a dynamic circle.
+/// \param margin How close it must be.
+/// \param result [in, out] List of shapes to append the line segments to.
+
+void CGrid::NearLineSegs(CDynamicCircle* pCirc, float margin, std::vector<CShape*>& result){
+  CAabb2D aabb = pCirc->GetAABB();
+  aabb.Expand(margin);
+
+  UINT x0, x1, y0, y1; //cell range
+  if(!GetCells(aabb, x0, x1, y0, y1))return; //nowhere near the grid
+
+  NextStamp();
+  UINT tests = 0; //number of line segments tested
+  UINT hits = 0; //number of line segments found
+
+  for(UINT y=y0; y<=y1; y++)
+    for(UINT x=x0; x<=x1; x++){
+      const UINT cell = y*m_nCols + x;
+      const UINT begin = m_stdLineSegStart[cell];
+      const UINT end = m_stdLineSegStart[cell + 1];
+
+      m_stdHits.clear();
+      m_cLineSegs.Collide(pCirc, begin, end, m_stdHits, margin);
+      tests += end - begin;
+
+      for(auto const& i: m_stdHits){
+        const UINT id = m_cLineSegs.GetId(i);
+
+        if(m_stdLineSegStamp[id] != m_nStamp){ //not already found
+          m_stdLineSegStamp[id] = m_nStamp;
+          result.push_back(m_cLineSegs.GetLineSeg(i));
+          ++hits;
+        } //if
+      } //for
+    } //for
+
+  CCollisionStats::PreCollide(eShape::LineSeg, tests, hits);
+} //NearLineSegs
+
+/// Reader function for the number of shapes in the grid.
+/// \return Number of shapes, including static line segments.
+
+const size_t CGrid::GetSize() const{
+  return m_stdShapes.size() + m_nLineSegs;
+} //GetSize
@@ -0,0 +1,92 @@
+/// \file Grid.h
+/// \brief Interface for the uniform grid class CGrid.
+
+#ifndef __L4RC_PHYSICS_GRID_H__
+#define __L4RC_PHYSICS_GRID_H__
+
+#include <vector>
+
+#include "LineSegBatch.h"
+
+/// \brief Uniform grid index.
+///
+/// Everything that CGrid works out from the shapes' AABBs when it is built,
+/// that is, the size and position of the grid and the cell lists. Shapes are
+/// given by their positions in the list of shapes that the grid is built from,
+/// with static line segments and other shapes counted separately. An index
+/// can be saved along with the shapes, and the grid can then be built again
+/// from the same list of shapes without working any of this out again.
+
+class CGridIndex{
+  public:
+    Vector2 m_vOrigin; ///< Bottom left corner of the grid.
+    float m_fCellSize = 0.0f; ///< Width and height of a cell.
+    UINT m_nCols = 0; ///< Number of columns of cells.
+    UINT m_nRows = 0; ///< Number of rows of cells.
+
+    std::vector<UINT> m_stdCellStart; ///< Start of each cell's list in m_stdCellList, plus one past the end.
+    std::vector<UINT> m_stdCellList; ///< Indices of shapes other than static line segments, cell by cell.
+    std::vector<UINT> m_stdLineSegStart; ///< Start of each cell's list in m_stdLineSegList, plus one past the end.
+    std::vector<UINT> m_stdLineSegList; ///< Indices of static line segments, cell by cell.
+
+    bool IsValid(UINT, UINT) const; ///< Does the index fit the shapes?
+}; //CGridIndex
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Uniform grid.
+///
+/// A uniform grid is a spatial index for shapes that don't move. The plane is
+/// divided into square cells, and each cell keeps a list of the shapes whose
+/// world space AABB overlaps it. The grid is built once after all of the static
+/// shapes have been created. A dynamic circle then needs to be tested against
+/// only the shapes in the cells that its AABB overlaps instead of against
+/// every static shape in the world. The cell lists are stored one after the
+/// other in a single array so that a query touches as little memory as possible.
+/// Static line segments, which make up most of a table, are kept out of the
+/// cell lists. Instead, each cell's line segments are copied one after the
+/// other into a line segment batch so that Collide() can test a dynamic circle
+/// against all of the line segments in a cell using SIMD instructions.
+
+class CGrid{
+  private:
+    Vector2 m_vOrigin; ///< Bottom left corner of the grid.
+    float m_fCellSize = 0.0f; ///< Width and height of a cell.
+    float m_fInvCellSize = 0.0f; ///< Reciprocal of the cell size.
+
+    UINT m_nCols = 0; ///< Number of columns of cells.
+    UINT m_nRows = 0; ///< Number of rows of cells.
+
+    std::vector<CShape*> m_stdShapes; ///< Shapes in the grid.
+    std::vector<UINT> m_stdCellStart; ///< Start of each cell's list in m_stdCellList.
+    std::vector<UINT> m_stdCellList; ///< Shape indices for all cells, cell by cell.
+
+    CLineSegBatch m_cLineSegs; ///< Static line segments, cell by cell.
+    std::vector<UINT> m_stdLineSegStart; ///< Start of each cell's line segments in m_cLineSegs.
+    UINT m_nLineSegs = 0; ///< Number of static line segments, not counting copies.
+
+    std::vector<UINT> m_stdStamp; ///< Stamp of the last query that found each shape.
+    std::vector<UINT> m_stdLineSegStamp; ///< Stamp of the last query that found each line segment.
+    UINT m_nStamp = 0; ///< Stamp for the current query.
+
+    std::vector<UINT> m_stdHits; ///< Line segments hit in a cell.
+
+    bool GetCells(const CAabb2D&, UINT&, UINT&, UINT&, UINT&) const; ///< Get cells overlapped by AABB.
+    void Bucket(const std::vector<CShape*>&, std::vector<UINT>&, std::vector<UINT>&) const; ///< Sort shapes into cells.
+    void NextStamp(); ///< Get a new stamp.
+
+  public:
+    void Build(const std::vector<CShape*>&, float); ///< Build the grid.
+    void Build(const std::vector<CShape*>&, const CGridIndex&); ///< Build the grid from an index.
+    void MakeIndex(const std::vector<CShape*>&, float, CGridIndex&); ///< Work out the index.
+    void Clear(); ///< Remove all shapes.
+
+    void Query(const CAabb2D&, std::vector<CShape*>&); ///< Get shapes near an AABB.
+    void QueryLineSegs(const CAabb2D&, std::vector<CShape*>&); ///< Get line segments near an AABB.
+    void Collide(CDynamicCircle*, std::vector<CContactDesc>&); ///< Collide with line segments.
+    void NearLineSegs(CDynamicCircle*, float, std::vector<CShape*>&); ///< Get line segments close to dynamic circle.
+
+    const size_t GetSize() const; ///< Get number of shapes.
+}; //CGrid
+
+#endif //__L4RC_PHYSICS_GRID_H__
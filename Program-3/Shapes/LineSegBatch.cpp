@@ -0,0 +1,243 @@
+/// \file LineSegBatch.cpp
+/// \brief Code for the line segment batch class CLineSegBatch.
+
+#include <cfloat>
+
+#include "LineSegBatch.h"
+
+#if defined(__AVX__)
+  #include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+
+/// Construct an empty line segment batch, which consists of nothing
+/// but padding.
+
+CLineSegBatch::CLineSegBatch(){
+  Clear();
+} //constructor
+
+/// Append padding to the arrays. A padding line segment has hugely negative
+/// length, so no point can project onto it, even with a margin.
+/// \param n Number of padding line segments to append.
+
+void CLineSegBatch::Pad(UINT n){
+  for(UINT i=0; i<n; i++){
+    m_stdP0x.push_back(0.0f);
+    m_stdP0y.push_back(0.0f);
+    m_stdTx.push_back(0.0f);
+    m_stdTy.push_back(0.0f);
+    m_stdNx.push_back(0.0f);
+    m_stdNy.push_back(0.0f);
+    m_stdLen.push_back(-FLT_MAX);
+  } //for
+} //Pad
+
+/// Remove all line segments. The line segments themselves are not deleted.
+
+void CLineSegBatch::Clear(){
+  m_stdP0x.clear();
+  m_stdP0y.clear();
+  m_stdTx.clear();
+  m_stdTy.clear();
+  m_stdNx.clear();
+  m_stdNy.clear();
+  m_stdLen.clear();
+
+  m_stdLineSeg.clear();
+  m_stdId.clear();
+
+  m_nSize = 0;
+  Pad(WIDTH);
+} //Clear
+
+/// Add a line segment to the end of the batch, overwriting the first
+/// padding entry and appending a new one. The line segment must not move
+/// while it is in the batch.
+/// \param p Pointer to a line segment.
+/// \param id An id for the line segment, which is up to the caller.
+/// \return Index of the line segment in the batch.
+
+UINT CLineSegBatch::Add(CLineSeg* p, UINT id){
+  Vector2 p0, p1;
+  p->GetEndPts(p0, p1);
+
+  const Vector2 t = Normalize(p1 - p0); //unit tangent
+  const Vector2 n = perp(t); //unit normal
+
+  const UINT i = m_nSize++;
+
+  m_stdP0x[i] = p0.x;
+  m_stdP0y[i] = p0.y;
+  m_stdTx[i] = t.x;
+  m_stdTy[i] = t.y;
+  m_stdNx[i] = n.x;
+  m_stdNy[i] = n.y;
+  m_stdLen[i] = (p1 - p0).Length();
+
+  m_stdLineSeg.push_back(p);
+  m_stdId.push_back(id);
+
+  Pad(1); //replace the padding that was overwritten
+
+  return i;
+} //Add
+
+/// Find the line segments in a range of the batch that collide with a
+/// dynamic circle. This is the same test as CLineSeg::PreCollide(), but
+/// done on several line segments at once from the stored arrays. Let
+/// \f$\vec{v}\f$ be the vector from end point 0 to the circle's center.
+/// The center projects onto the line segment if
+/// \f$0 \leq \vec{v} \cdot \hat{t} \leq \ell\f$, where \f$\hat{t}\f$ is
+/// the tangent and \f$\ell\f$ is the length, and then the circle overlaps
+/// the line segment if \f$|\vec{v} \cdot \hat{n}| < r\f$, where
+/// \f$\hat{n}\f$ is the normal and \f$r\f$ is the radius. A positive
+/// margin loosens all three tests by that distance so that line segments
+/// that the circle is close to but not yet touching are found too.
+/// \param pCirc Pointer to a dynamic circle.
+/// \param begin Index of first line segment to test.
+/// \param end One more than the index of the last line segment to test.
+/// \param result [out] Indices of the line segments that collide, appended.
+/// \param margin Distance by which to loosen the tests, defaults to zero.
+/// \return Number of indices appended to result.
+
+UINT CLineSegBatch::Collide(CDynamicCircle* pCirc, UINT begin, UINT end, 
+  std::vector<UINT>& result, float margin) const
+{
+  const size_t oldsize = result.size();
+  const Vector2 c = pCirc->GetPos();
+  const float r = pCirc->GetRadius() + margin;
+
+  const float* p0x = m_stdP0x.data();
+  const float* p0y = m_stdP0y.data();
+  const float* tx = m_stdTx.data();
+  const float* ty = m_stdTy.data();
+  const float* nx = m_stdNx.data();
+  const float* ny = m_stdNy.data();
+  const float* len = m_stdLen.data();
+
+#if defined(__AVX__)
+  const __m256 cx = _mm256_set1_ps(c.x);
+  const __m256 cy = _mm256_set1_ps(c.y);
+  const __m256 rr = _mm256_set1_ps(r);
+  const __m256 lo = _mm256_set1_ps(-margin);
+  const __m256 mm = _mm256_set1_ps(margin);
+  const __m256 absmask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+  for(UINT i=begin; i<end; i+=8){
+    const __m256 vx = _mm256_sub_ps(cx, _mm256_loadu_ps(p0x + i));
+    const __m256 vy = _mm256_sub_ps(cy, _mm256_loadu_ps(p0y + i));
+
+    const __m256 t = _mm256_add_ps(
+      _mm256_mul_ps(vx, _mm256_loadu_ps(tx + i)), 
+      _mm256_mul_ps(vy, _mm256_loadu_ps(ty + i)));
+    const __m256 s = _mm256_add_ps(
+      _mm256_mul_ps(vx, _mm256_loadu_ps(nx + i)), 
+      _mm256_mul_ps(vy, _mm256_loadu_ps(ny + i)));
+
+    const __m256 hit = _mm256_and_ps(
+      _mm256_and_ps(
+        _mm256_cmp_ps(t, lo, _CMP_GE_OQ), 
+        _mm256_cmp_ps(t, _mm256_add_ps(_mm256_loadu_ps(len + i), mm), _CMP_LE_OQ)),
+      _mm256_cmp_ps(_mm256_and_ps(s, absmask), rr, _CMP_LT_OQ));
+
+    UINT bits = (UINT)_mm256_movemask_ps(hit);
+    if(end - i < 8)bits &= (1 << (end - i)) - 1; //ignore lanes past the end
+
+    for(UINT j=0; bits; j++, bits>>=1)
+      if(bits & 1)result.push_back(i + j);
+  } //for
+
+#elif defined(_M_X64) || defined(__SSE2__)
+  const __m128 cx = _mm_set1_ps(c.x);
+  const __m128 cy = _mm_set1_ps(c.y);
+  const __m128 rr = _mm_set1_ps(r);
+  const __m128 lo = _mm_set1_ps(-margin);
+  const __m128 mm = _mm_set1_ps(margin);
+  const __m128 absmask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+  for(UINT i=begin; i<end; i+=4){
+    const __m128 vx = _mm_sub_ps(cx, _mm_loadu_ps(p0x + i));
+    const __m128 vy = _mm_sub_ps(cy, _mm_loadu_ps(p0y + i));
+
+    const __m128 t = _mm_add_ps(
+      _mm_mul_ps(vx, _mm_loadu_ps(tx + i)), 
+      _mm_mul_ps(vy, _mm_loadu_ps(ty + i)));
+    const __m128 s = _mm_add_ps(
+      _mm_mul_ps(vx, _mm_loadu_ps(nx + i)), 
+      _mm_mul_ps(vy, _mm_loadu_ps(ny + i)));
+
+    const __m128 hit = _mm_and_ps(
+      _mm_and_ps(_mm_cmpge_ps(t, lo), _mm_cmple_ps(t, _mm_add_ps(_mm_loadu_ps(len + i), mm))),
+      _mm_cmplt_ps(_mm_and_ps(s, absmask), rr));
+
+    UINT bits = (UINT)_mm_movemask_ps(hit);
+    if(end - i < 4)bits &= (1 << (end - i)) - 1; //ignore lanes past the end
+
+    for(UINT j=0; bits; j++, bits>>=1)
+      if(bits & 1)result.push_back(i + j);
+  } //for
+
+#else //no SIMD, do it one at a time
+  for(UINT i=begin; i<end; i++){
+    const float vx = c.x - p0x[i];
+    const float vy = c.y - p0y[i];
+    const float t = vx*tx[i] + vy*ty[i];
+    const float s = vx*nx[i] + vy*ny[i];
+
+    if(t >= -margin && t <= len[i] + margin && fabsf(s) < r)
+      result.push_back(i);
+  } //for
+#endif
+
+  return (UINT)(result.size() - oldsize);
+} //Collide
+
+/// Fill in a contact descriptor for a line segment that Collide() found to
+/// be colliding with the dynamic circle in the contact descriptor. The point
+/// of intersection is the point on the line segment closest to the circle's
+/// center, and the collision normal is whichever of the line segment's normals
+/// faces the circle's center.
+/// \param i Index of a line segment.
+/// \param c [in, out] Contact descriptor with the dynamic circle filled in.
+
+void CLineSegBatch::GetContact(UINT i, CContactDesc& c) const{
+  CDynamicCircle* pCirc = c.m_pCircle;
+
+  const Vector2 p0(m_stdP0x[i], m_stdP0y[i]);
+  const Vector2 t(m_stdTx[i], m_stdTy[i]);
+  const Vector2 n(m_stdNx[i], m_stdNy[i]);
+
+  const Vector2 v = pCirc->GetPos() - p0;
+  const float s = v.Dot(n); //signed distance from line
+
+  c.m_pShape = m_stdLineSeg[i];
+  c.m_vPOI = p0 + v.Dot(t)*t;
+  c.m_vNorm = s < 0.0f? -n: n;
+  c.m_fSetback = fabsf(s) - pCirc->GetRadius();
+  c.m_fSpeed = pCirc->GetVel().Length();
+} //GetContact
+
+/// Reader function for a line segment pointer.
+/// \param i Index of a line segment.
+/// \return Pointer to that line segment.
+
+CLineSeg* CLineSegBatch::GetLineSeg(UINT i) const{
+  return m_stdLineSeg[i];
+} //GetLineSeg
+
+/// Reader function for the caller's id for a line segment.
+/// \param i Index of a line segment.
+/// \return Id given to Add() for that line segment.
+
+const UINT CLineSegBatch::GetId(UINT i) const{
+  return m_stdId[i];
+} //GetId
+
+/// Reader function for the number of line segments.
+/// \return Number of line segments, not including padding.
+
+const UINT CLineSegBatch::GetSize() const{
+  return m_nSize;
+} //GetSize
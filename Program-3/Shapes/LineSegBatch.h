@@ -0,0 +1,59 @@
+/// \file LineSegBatch.h
+/// \brief Interface for the line segment batch class CLineSegBatch.
+
+#ifndef __L4RC_PHYSICS_LINESEGBATCH_H__
+#define __L4RC_PHYSICS_LINESEGBATCH_H__
+
+#include <vector>
+
+#include "LineSeg.h"
+#include "Contact.h"
+
+/// \brief Line segment batch.
+///
+/// A line segment batch stores the line segments that a dynamic circle
+/// is to be tested against as a structure of arrays, that is, one array for
+/// each coordinate of end point 0, of the unit tangent pointing from end point
+/// 0 to end point 1, of the unit normal, and of the length. This lets a dynamic
+/// circle be tested against 4 line segments at a time using SSE, or 8 at a time
+/// using AVX if the compiler has been told that it may use it. The arrays are
+/// padded at the end with line segments of negative length that can never
+/// collide, so that the last few line segments in the batch can be tested
+/// without having to worry about reading past the end of an array. A batch
+/// may hold more than one copy of a line segment, so each entry also has an
+/// id that the caller can use to find duplicates.
+
+class CLineSegBatch{
+  private:
+    std::vector<float> m_stdP0x; ///< End point 0 \f$x\f$ coordinates.
+    std::vector<float> m_stdP0y; ///< End point 0 \f$y\f$ coordinates.
+    std::vector<float> m_stdTx; ///< Tangent \f$x\f$ coordinates.
+    std::vector<float> m_stdTy; ///< Tangent \f$y\f$ coordinates.
+    std::vector<float> m_stdNx; ///< Normal \f$x\f$ coordinates.
+    std::vector<float> m_stdNy; ///< Normal \f$y\f$ coordinates.
+    std::vector<float> m_stdLen; ///< Lengths.
+
+    std::vector<CLineSeg*> m_stdLineSeg; ///< Pointers to line segments.
+    std::vector<UINT> m_stdId; ///< Caller's ids for line segments.
+
+    UINT m_nSize = 0; ///< Number of line segments, not including padding.
+
+    void Pad(UINT); ///< Append padding.
+
+  public:
+    static const UINT WIDTH = 8; ///< Maximum number of line segments tested at once.
+
+    CLineSegBatch(); ///< Constructor.
+
+    void Clear(); ///< Remove all line segments.
+    UINT Add(CLineSeg*, UINT); ///< Add a line segment.
+
+    UINT Collide(CDynamicCircle*, UINT, UINT, std::vector<UINT>&, float =0.0f) const; ///< Find collisions.
+    void GetContact(UINT, CContactDesc&) const; ///< Fill in contact descriptor.
+
+    CLineSeg* GetLineSeg(UINT) const; ///< Get line segment.
+    const UINT GetId(UINT) const; ///< Get caller's id for line segment.
+    const UINT GetSize() const; ///< Get number of line segments.
+}; //CLineSegBatch
+
+#endif //__L4RC_PHYSICS_LINESEGBATCH_H__
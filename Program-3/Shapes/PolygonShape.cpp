@@ -0,0 +1,261 @@
+/// \file PolygonShape.cpp
+/// \brief Code for CPolygonDesc, CPolygonShape, and CKinematicPolygonShape.
+
+#include "PolygonShape.h"
+#include "DynamicCircle.h"
+#include "Contact.h"
+
+/////////////////////////////////////////////////////////////////////////////
+// CPolygonDesc functions
+
+/// The default contructor creates a polygon descriptor with no vertices.
+
+CPolygonDesc::CPolygonDesc(): CShapeDesc(eShape::Polygon){
+} //constructor
+
+/// This constructor creates a polygon descriptor given the polygon's
+/// vertices and elasticity.
+/// \param v Array of vertices.
+/// \param n Number of vertices.
+/// \param e Elasticity, defaults to 1.0f.
+
+CPolygonDesc::CPolygonDesc(const Vector2* v, UINT n, float e):
+  CShapeDesc(eShape::Polygon)
+{
+  SetVertices(v, n);
+  m_fElasticity = e;
+} //constructor
+
+/// Set the vertices of this polygon descriptor and put its position at
+/// their average. Vertices past the maximum number are ignored.
+/// \param v Array of vertices.
+/// \param n Number of vertices.
+
+void CPolygonDesc::SetVertices(const Vector2* v, UINT n){
+  m_nVertices = min(n, MAX_VERTICES);
+  m_vPos = Vector2(0.0f);
+
+  for(UINT i=0; i<m_nVertices; i++){
+    m_vVertex[i] = v[i];
+    m_vPos += v[i];
+  } //for
+
+  if(m_nVertices > 0)
+    m_vPos /= (float)m_nVertices;
+} //SetVertices
+
+/////////////////////////////////////////////////////////////////////////////
+// CPolygonShape functions
+
+/// Constructs a polygon described by a polygon descriptor. The vertices are
+/// put into counterclockwise order, that is, they are reversed if the signed
+/// area is negative, so that the normal of each edge is clockwise from the
+/// edge and points out of the polygon.
+/// \param r Polygon descriptor.
+
+CPolygonShape::CPolygonShape(const CPolygonDesc& r): CShape(r){
+  m_nVertices = r.m_nVertices;
+
+  float area = 0.0f; //twice the signed area
+
+  for(UINT i=0; i<m_nVertices; i++){
+    const Vector2& p0 = r.m_vVertex[i];
+    const Vector2& p1 = r.m_vVertex[(i + 1)%m_nVertices];
+    area += p0.x*p1.y - p1.x*p0.y;
+  } //for
+
+  for(UINT i=0; i<m_nVertices; i++)
+    m_vVertex[i] = r.m_vVertex[area < 0.0f? m_nVertices - 1 - i: i];
+
+  for(UINT i=0; i<m_nVertices; i++){
+    const Vector2 e = m_vVertex[(i + 1)%m_nVertices] - m_vVertex[i];
+    m_fLength[i] = e.Length();
+    m_vNormal[i] = Vector2(e.y, -e.x)/m_fLength[i];
+  } //for
+
+  SetPos(r.m_vPos);
+  UpdateAABB();
+} //constructor
+
+/// Update the AABB from the position and vertices.
+
+void CPolygonShape::UpdateAABB(){
+  const Vector2 p = GetPos();
+  SetAABBPoint(m_vVertex[0] - p);
+
+  for(UINT i=1; i<m_nVertices; i++)
+    AddAABBPoint(m_vVertex[i] - p);
+} //UpdateAABB
+
+/// Collision detection with a dynamic circle. The edge whose line the
+/// circle's center is furthest outside of is found first. Since the polygon
+/// is convex, if the center is further from it than one radius plus the
+/// margin then there is no collision, and if the center is not outside of it
+/// then the center is inside the polygon and the circle is pushed out through
+/// that edge. Otherwise the closest feature is that edge or one of its
+/// vertices, depending on where the center projects onto the edge's tangent.
+/// Either way there is exactly one contact, so a dynamic circle that hits a
+/// corner is not hit by both edges.
+/// \param c [in, out] Contact descriptor for this collision.
+/// \return true is there was a collision.
+
+bool CPolygonShape::PreCollide(CContactDesc& c){
+  if(!m_bCanCollide)return false; //bail and fail
+
+  CDynamicCircle* pCirc = c.m_pCircle;
+  const Vector2 p = pCirc->GetPos();
+  const float r = pCirc->GetRadius();
+
+  UINT k = 0; //edge of greatest separation
+  float s = m_vNormal[0].Dot(p - m_vVertex[0]); //greatest separation
+
+  for(UINT i=1; i<m_nVertices; i++){
+    const float d = m_vNormal[i].Dot(p - m_vVertex[i]);
+    if(d > s){k = i; s = d;}
+  } //for
+
+  FailIf(s - r >= c.m_fMargin); //too far outside an edge
+
+  const Vector2& n = m_vNormal[k];
+  const Vector2& p0 = m_vVertex[k];
+  const float a = Vector2(-n.y, n.x).Dot(p - p0); //distance along edge
+
+  if(s <= 0.0f || (a >= 0.0f && a <= m_fLength[k])){ //closest feature is edge k
+    c.m_vPOI = p - s*n;
+    c.m_vNorm = n;
+    c.m_fSetback = s - r;
+  } //if
+
+  else{ //closest feature is a vertex
+    c.m_vPOI = a < 0.0f? p0: m_vVertex[(k + 1)%m_nVertices];
+    const Vector2 u = p - c.m_vPOI;
+    const float d = u.Length() - r; //setback distance
+    FailIf(d >= c.m_fMargin);
+    c.m_vNorm = Normalize(u);
+    c.m_fSetback = d;
+  } //else
+
+  c.m_fSpeed = pCirc->GetVel().Length();
+
+  return true;
+} //PreCollide
+
+/// Swept collision detection with a dynamic circle. The circle moves in a
+/// straight line from its current position by displacement v as time goes
+/// from 0 to 1, and hits an edge when its center is one radius outside the
+/// edge's line and between its end points, or a vertex when its center is
+/// one radius from it. A circle that is already touching this polygon
+/// is left to PreCollide().
+/// \param c [in, out] Contact descriptor for this collision.
+/// \param v Displacement of the dynamic circle.
+/// \param t [in, out] Earliest time of impact found so far.
+/// \return true if there was a collision before time t.
+
+bool CPolygonShape::TimeOfImpact(CContactDesc& c, const Vector2& v, float& t){
+  if(!m_bCanCollide)return false; //bail and fail
+
+  CDynamicCircle* pCirc = c.m_pCircle;
+  const Vector2 p = pCirc->GetPos();
+  const float r = pCirc->GetRadius();
+
+  CContactDesc cd(c); //touching test, with no margin
+  cd.m_fMargin = 0.0f;
+  FailIf(PreCollide(cd)); //already touching
+
+  bool bHit = false; //whether there was a hit before time t
+  Vector2 poi; //point of impact
+
+  for(UINT i=0; i<m_nVertices; i++){
+    const Vector2& n = m_vNormal[i];
+    const float d = n.Dot(p - m_vVertex[i]) - r; //distance outside edge
+    const float dv = n.Dot(v); //change in distance
+
+    if(d > 0.0f && dv < 0.0f && d < -t*dv){ //approaching, in time
+      const float s = -d/dv; //time at which distance is r
+      const Vector2 p2 = p + s*v; //center of circle at time of impact
+      const float a = Vector2(-n.y, n.x).Dot(p2 - m_vVertex[i]); //distance along edge
+
+      if(a >= 0.0f && a <= m_fLength[i]){ //between the vertices
+        t = s;
+        poi = p2 - r*n;
+        bHit = true;
+      } //if
+    } //if
+
+    if(CircleTOI(p, v, m_vVertex[i], r, t)){
+      poi = m_vVertex[i];
+      bHit = true;
+    } //if
+  } //for
+
+  FailIf(!bHit);
+
+  c.m_pShape = this;
+  c.m_vPOI = poi;
+  c.m_fSetback = 0.0f;
+  c.m_fSpeed = pCirc->GetVel().Length();
+  c.m_vNorm = Normalize(p + t*v - poi);
+
+  return true;
+} //TimeOfImpact
+
+/// Reader function for the number of vertices.
+/// \return Number of vertices.
+
+const UINT CPolygonShape::GetNumVertices() const{
+  return m_nVertices;
+} //GetNumVertices
+
+/// Reader function for a vertex.
+/// \param i Vertex index, which must be less than the number of vertices.
+/// \return The i'th vertex in counterclockwise order.
+
+const Vector2& CPolygonShape::GetVertex(UINT i) const{
+  return m_vVertex[i];
+} //GetVertex
+
+/////////////////////////////////////////////////////////////////////////////
+// CKinematicPolygonShape functions
+
+/// Constructs a kinematic polygon described by a polygon descriptor.
+/// \param r Polygon descriptor.
+
+CKinematicPolygonShape::CKinematicPolygonShape(const CPolygonDesc& r):
+  CPolygonShape(r), m_vOldPos(GetPos())
+{
+  m_eMotionType = eMotion::Kinematic;
+
+  for(UINT i=0; i<m_nVertices; i++){
+    m_vOldVertex[i] = m_vVertex[i];
+    m_vOldNormal[i] = m_vNormal[i];
+  } //for
+} //constructor
+
+/// Rotate to a given orientation from original orientation. The vertices are
+/// rotated about the center of rotation and the normals about the origin,
+/// which keeps them in counterclockwise order with the same edge lengths.
+/// \param v Center of rotation.
+/// \param s Sine of the angle increment from original orientation.
+/// \param c Cosine of the angle increment from original orientation.
+
+void CKinematicPolygonShape::Rotate(const Vector2& v, float s, float c){
+  for(UINT i=0; i<m_nVertices; i++){
+    m_vVertex[i] = RotatePt(m_vOldVertex[i], v, s, c);
+    m_vNormal[i] = RotatePt(m_vOldNormal[i], Vector2(0.0f), s, c);
+  } //for
+
+  SetPos(RotatePt(m_vOldPos, v, s, c));
+  UpdateAABB();
+} //Rotate
+
+/// Reset to original orientation.
+
+void CKinematicPolygonShape::Reset(){
+  for(UINT i=0; i<m_nVertices; i++){
+    m_vVertex[i] = m_vOldVertex[i];
+    m_vNormal[i] = m_vOldNormal[i];
+  } //for
+
+  SetPos(m_vOldPos);
+  UpdateAABB();
+} //Reset
@@ -0,0 +1,79 @@
+/// \file PolygonShape.h
+/// \brief Interface for CPolygonDesc, CPolygonShape, and CKinematicPolygonShape.
+
+#ifndef __L4RC_PHYSICS_POLYGONSHAPE_H__
+#define __L4RC_PHYSICS_POLYGONSHAPE_H__
+
+#include "Shape.h"
+
+/// \brief Polygon descriptor.
+///
+/// The polygon descriptor describes a convex polygon by its vertices, which
+/// may be given in either order around the polygon. The position is the
+/// average of the vertices.
+
+class CPolygonDesc: public CShapeDesc{
+  public:
+    static const UINT MAX_VERTICES = 8; ///< Maximum number of vertices.
+
+    Vector2 m_vVertex[MAX_VERTICES]; ///< Vertices.
+    UINT m_nVertices = 0; ///< Number of vertices.
+
+    CPolygonDesc(); ///< Constructor.
+    CPolygonDesc(const Vector2*, UINT, float =1.0f); ///< Constructor.
+
+    void SetVertices(const Vector2*, UINT); ///< Set vertices.
+}; //CPolygonDesc
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Polygon shape.
+///
+/// A convex polygon with up to CPolygonDesc::MAX_VERTICES vertices, stored
+/// counterclockwise in an array together with the outward unit normal and
+/// the length of the edge from each vertex to the next. Collision detection
+/// with a dynamic circle is a single closest feature query that gives one
+/// contact, whether the closest feature is an edge or a vertex, so a
+/// dynamic circle that hits a corner is hit once, not once by each edge.
+
+class CPolygonShape: public CShape{
+  protected:
+    Vector2 m_vVertex[CPolygonDesc::MAX_VERTICES]; ///< Vertices, counterclockwise.
+    Vector2 m_vNormal[CPolygonDesc::MAX_VERTICES]; ///< Outward unit normal of each edge.
+    float m_fLength[CPolygonDesc::MAX_VERTICES] = {0.0f}; ///< Length of each edge.
+    UINT m_nVertices = 0; ///< Number of vertices.
+
+    void UpdateAABB(); ///< Update AABB from the vertices.
+
+  public:
+    CPolygonShape(const CPolygonDesc&); ///< Constructor.
+
+    bool PreCollide(CContactDesc&); ///< Collision detection.
+    bool TimeOfImpact(CContactDesc&, const Vector2&, float&); ///< Swept collision detection.
+
+    const UINT GetNumVertices() const; ///< Get number of vertices.
+    const Vector2& GetVertex(UINT) const; ///< Get vertex.
+}; //CPolygonShape
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Kinematic polygon shape.
+///
+/// A polygon whose motion type is KINEMATIC. The vertices and normals are
+/// rotated together from their original orientation, so the edge lengths
+/// never need to be recomputed.
+
+class CKinematicPolygonShape: public CPolygonShape{
+  private:
+    Vector2 m_vOldVertex[CPolygonDesc::MAX_VERTICES]; ///< Original vertices.
+    Vector2 m_vOldNormal[CPolygonDesc::MAX_VERTICES]; ///< Original normals.
+    Vector2 m_vOldPos; ///< Original position.
+
+  public:
+    CKinematicPolygonShape(const CPolygonDesc&); ///< Constructor.
+
+    void Rotate(const Vector2&, float, float); ///< Rotate.
+    void Reset(); ///< Reset orientation.
+}; //CKinematicPolygonShape
+
+#endif //__L4RC_PHYSICS_POLYGONSHAPE_H__
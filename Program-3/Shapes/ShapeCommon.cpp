@@ -1,8 +1,8 @@
-/// \file ShapeCommon.cpp
-/// \brief Code for the class CShapeCommon.
-
-#include "ShapeCommon.h"
-
-float CShapeCommon::m_fGravity = 0.0f;
-float CShapeCommon::m_fTimeStep = 0.0f;
-
+/// \file ShapeCommon.cpp
+/// \brief Code for the class CShapeCommon.
+
+#include "ShapeCommon.h"
+
+float CShapeCommon::m_fGravity = 0.0f;
+float CShapeCommon::m_fTimeStep = 0.0f;
+
@@ -1,64 +1,104 @@
-/// \file ShapeMath.cpp
-/// \brief Handy math functions for the collision module.
-
-#include "ShapeMath.h"
-
-/// /brief Normalize angle to [0, 2PI).
-///
-/// \param a Angle in radians.
-/// \return Normalized angle, that is, in the range [0, 2PI).
-
-float NormalizeAngle(float a){
-  a -= floorf(a/XM_2PI)*XM_2PI; //a is now in (-2PI, 2PI)
-  return (a < 0.0f)? a + XM_2PI: a; //fix the negative angles
-} //NormalizeAngle
-
-/// The DirectXTK doesn't have a function that returns a
-/// normalized vector, so here it is.
-/// \param v A vector.
-/// \return A unit vector that points in the direction of v.
-
-Vector2 Normalize(Vector2 v){
-  v.Normalize();
-  return v;
-} //Normalize
-
-/// Compute the perpendicular to a given vector in a counterclockwise direction.
-/// \param v A vector.
-/// \return The vector perpendicular to v in a counterclockwise direction.
-
-Vector2 perp(const Vector2& v){
-  return Vector2(-v.y, v.x);
-} //perp
-
-/// Get a normalized vector at a given orientation.
-/// \param a Orientation angle.
-/// \return Unit vector at orientation a.
-
-Vector2 AngleToVector(const float a){
-  return Vector2(cosf(a), sinf(a));
-} //AngleToVector
-
-/// Rotate a point about an arbitrary center.
-/// \param p Point to be rotated.
-/// \param q Center of rotation.
-/// \param a Angle of rotation in radians.
-/// \return Rotated point.
-
-Vector2 RotatePt(Vector2 p, const Vector2& q, const float a){
-  const float s = sinf(a);
-  const float c = cosf(a);
-
-  p -= q;
-  return q + Vector2(p.x*c - p.y*s, p.x*s + p.y*c);
-} //RotatePt
-
-/// Find the component of one vector parallel to another.
-/// \param v0 Vector whose component we want.
-/// \param v1 Vector that the component must be parallel to.
-/// \return Component of v0 that is parallel to v1.
-
-Vector2 ParallelComponent(const Vector2& v0, const Vector2& v1){
-  const Vector2 v1hat = Normalize(v1);
-  return v0.Dot(v1hat)*v1hat;
-} //ParallelComponent
\ No newline at end of file
+/// \file ShapeMath.cpp
+/// \brief Handy math functions for the collision module.
+
+#include "ShapeMath.h"
+
+/// /brief Normalize angle to [0, 2PI).
+///
+/// \param a Angle in radians.
+/// \return Normalized angle, that is, in the range [0, 2PI).
+
+float NormalizeAngle(float a){
+  a -= floorf(a/XM_2PI)*XM_2PI; //a is now in (-2PI, 2PI)
+  return (a < 0.0f)? a + XM_2PI: a; //fix the negative angles
+} //NormalizeAngle
+
+/// The DirectXTK doesn't have a function that returns a
+/// normalized vector, so here it is.
+/// \param v A vector.
+/// \return A unit vector that points in the direction of v.
+
+Vector2 Normalize(Vector2 v){
+  v.Normalize();
+  return v;
+} //Normalize
+
+/// Compute the perpendicular to a given vector in a counterclockwise direction.
+/// \param v A vector.
+/// \return The vector perpendicular to v in a counterclockwise direction.
+
+Vector2 perp(const Vector2& v){
+  return Vector2(-v.y, v.x);
+} //perp
+
+/// Get a normalized vector at a given orientation.
+/// \param a Orientation angle.
+/// \return Unit vector at orientation a.
+
+Vector2 AngleToVector(const float a){
+  return Vector2(cosf(a), sinf(a));
+} //AngleToVector
+
+/// Rotate a point about an arbitrary center.
+/// \param p Point to be rotated.
+/// \param q Center of rotation.
+/// \param a Angle of rotation in radians.
+/// \return Rotated point.
+
+Vector2 RotatePt(Vector2 p, const Vector2& q, const float a){
+  return RotatePt(p, q, sinf(a), cosf(a));
+} //RotatePt
+
+/// Rotate a point about an arbitrary center given the sine and cosine of the
+/// angle of rotation. Use this when rotating many points through the same 
+/// angle, so that the sine and cosine need only be computed once.
+/// \param p Point to be rotated.
+/// \param q Center of rotation.
+/// \param s Sine of the angle of rotation.
+/// \param c Cosine of the angle of rotation.
+/// \return Rotated point.
+
+Vector2 RotatePt(Vector2 p, const Vector2& q, const float s, const float c){
+  p -= q;
+  return q + Vector2(p.x*c - p.y*s, p.x*s + p.y*c);
+} //RotatePt
+
+/// Find the component of one vector parallel to another.
+/// \param v0 Vector whose component we want.
+/// \param v1 Vector that the component must be parallel to.
+/// \return Component of v0 that is parallel to v1.
+
+Vector2 ParallelComponent(const Vector2& v0, const Vector2& v1){
+  const Vector2 v1hat = Normalize(v1);
+  return v0.Dot(v1hat)*v1hat;
+} //ParallelComponent
+
+/// Find the time of impact of a point moving in a straight line with a circle.
+/// The point moves from \f$p\f$ to \f$p + v\f$ as time goes from 0 to 1.
+/// If it starts outside the circle, then this is the time at which it enters
+/// the circle, otherwise it is the time at which it leaves. This is the root
+/// of the quadratic \f$|p + tv - c|^2 = r^2\f$ that we need.
+/// \param p Starting position of the point.
+/// \param v Displacement of the point.
+/// \param c Center of the circle.
+/// \param r Radius of the circle.
+/// \param t [in, out] Earliest time of impact found so far, replaced if this one is earlier.
+/// \return true if the point hits the circle before time t.
+
+bool CircleTOI(const Vector2& p, const Vector2& v, const Vector2& c, float r, float& t){
+  const Vector2 q = p - c; //start relative to center of circle
+  const float a = v.Dot(v); 
+  const float b = q.Dot(v); //half of the usual b
+  const float d = q.Dot(q) - r*r; //positive if starting outside
+
+  FailIf(a == 0.0f); //not moving
+
+  const float disc = b*b - a*d; //discriminant
+  FailIf(disc < 0.0f); //misses
+
+  const float s = (d > 0.0f? -b - sqrtf(disc): -b + sqrtf(disc))/a; //in or out
+  FailIf(s < 0.0f || s >= t); //behind us or too late
+
+  t = s;
+  return true;
+} //CircleTOI
@@ -0,0 +1,322 @@
+/// \file ShapeStore.cpp
+/// \brief Code for the shape handle class CShapeHandle and the shape store class CShapeStore.
+
+#include "ShapeStore.h"
+#include "Contact.h"
+
+/////////////////////////////////////////////////////////////////////////////
+// CShapeHandle functions
+
+/// A default handle has unknown shape type and refers to no shape.
+/// \return true if this handle refers to a shape.
+
+bool CShapeHandle::IsValid() const{
+  return m_eShapeType != eShape::Unknown;
+} //IsValid
+
+/////////////////////////////////////////////////////////////////////////////
+// CShapeStore functions
+
+/// The constructor gives each shape container the shape store's arena.
+
+CShapeStore::CShapeStore():
+  m_cPoint(&m_cArena), m_cLineSeg(&m_cArena), m_cCircle(&m_cArena), m_cArc(&m_cArena),
+  m_cPolygon(&m_cArena), m_cChain(&m_cArena), m_cCapsule(&m_cArena),
+  m_cKinematicPoint(&m_cArena), m_cKinematicLineSeg(&m_cArena),
+  m_cKinematicCircle(&m_cArena), m_cKinematicArc(&m_cArena),
+  m_cKinematicPolygon(&m_cArena), m_cKinematicCapsule(&m_cArena),
+  m_cDynamicCircle(&m_cArena){
+} //constructor
+
+/// Make a shape from a shape descriptor, which must be of the class that
+/// matches its shape type, and put it into the container for shapes of its
+/// shape type and motion type. A dynamic circle goes into an unused slot
+/// if there is one.
+/// \param sd Pointer to a shape descriptor.
+/// \return Handle for the new shape, invalid if the types aren't supported.
+
+CShapeHandle CShapeStore::Make(CShapeDesc* sd){
+  CShapeHandle h;
+  h.m_eShapeType = sd->m_eShapeType;
+  h.m_eMotionType = sd->m_eMotionType;
+
+  switch(sd->m_eMotionType){
+    case eMotion::Static:
+      switch(sd->m_eShapeType){
+        case eShape::Point:
+          h.m_nIndex = m_cPoint.GetSize();
+          m_cPoint.Add(*(CPointDesc*)sd); 
+        break;
+
+        case eShape::LineSeg: 
+          h.m_nIndex = m_cLineSeg.GetSize();
+          m_cLineSeg.Add(*(CLineSegDesc*)sd); 
+        break;
+
+        case eShape::Circle:
+          h.m_nIndex = m_cCircle.GetSize();
+          m_cCircle.Add(*(CCircleDesc*)sd); 
+        break;
+
+        case eShape::Arc:
+          h.m_nIndex = m_cArc.GetSize();
+          m_cArc.Add(*(CArcDesc*)sd); 
+        break;
+
+        case eShape::Polygon:
+          h.m_nIndex = m_cPolygon.GetSize();
+          m_cPolygon.Add(*(CPolygonDesc*)sd); 
+        break;
+
+        case eShape::Chain:
+          h.m_nIndex = m_cChain.GetSize();
+          m_cChain.Add(*(CChainDesc*)sd, &m_cArena); 
+        break;
+
+        case eShape::Capsule:
+          h.m_nIndex = m_cCapsule.GetSize();
+          m_cCapsule.Add(*(CCapsuleDesc*)sd); 
+        break;
+
+        default: h.m_eShapeType = eShape::Unknown;
+      } //switch
+      break;
+
+    case eMotion::Kinematic:
+      switch(sd->m_eShapeType){
+        case eShape::Point:
+          h.m_nIndex = m_cKinematicPoint.GetSize();
+          m_cKinematicPoint.Add(*(CPointDesc*)sd); 
+        break;
+
+        case eShape::LineSeg: 
+          h.m_nIndex = m_cKinematicLineSeg.GetSize();
+          m_cKinematicLineSeg.Add(*(CLineSegDesc*)sd); 
+        break;
+
+        case eShape::Circle:
+          h.m_nIndex = m_cKinematicCircle.GetSize();
+          m_cKinematicCircle.Add(*(CCircleDesc*)sd); 
+        break;
+
+        case eShape::Arc:
+          h.m_nIndex = m_cKinematicArc.GetSize();
+          m_cKinematicArc.Add(*(CArcDesc*)sd); 
+        break;
+
+        case eShape::Polygon:
+          h.m_nIndex = m_cKinematicPolygon.GetSize();
+          m_cKinematicPolygon.Add(*(CPolygonDesc*)sd); 
+        break;
+
+        case eShape::Capsule:
+          h.m_nIndex = m_cKinematicCapsule.GetSize();
+          m_cKinematicCapsule.Add(*(CCapsuleDesc*)sd); 
+        break;
+
+        default: h.m_eShapeType = eShape::Unknown;
+      } //switch
+      break;
+
+    case eMotion::Dynamic:
+      h.m_eShapeType = eShape::Circle;
+
+      if(m_stdDynamicFree.empty()){ //no free slots, so make a new one
+        h.m_nIndex = m_cDynamicCircle.GetSize();
+        m_cDynamicCircle.Add(*(CDynamicCircleDesc*)sd);
+        m_stdDynamicUsed.push_back(true);
+        m_stdDynamicGeneration.push_back(0);
+      } //if
+
+      else{ //recycle a free slot
+        h.m_nIndex = m_stdDynamicFree.back();
+        m_stdDynamicFree.pop_back();
+        m_cDynamicCircle[h.m_nIndex] = CDynamicCircle(*(CDynamicCircleDesc*)sd);
+        m_stdDynamicUsed[h.m_nIndex] = true;
+      } //else
+
+      h.m_nGeneration = m_stdDynamicGeneration[h.m_nIndex];
+      break;
+
+    default: h.m_eShapeType = eShape::Unknown;
+  } //switch
+
+  return h;
+} //Make
+
+/// Is there a container for shapes of a given shape type and motion type?
+/// Make() gives an invalid handle for a shape that has none, such as a
+/// kinematic chain.
+/// \param s Shape type.
+/// \param m Motion type.
+/// \return true if a shape of this shape type and motion type can be made.
+
+bool CShapeStore::CanMake(eShape s, eMotion m){
+  switch(s){
+    case eShape::Point:
+    case eShape::LineSeg:
+    case eShape::Arc:
+    case eShape::Polygon:
+    case eShape::Capsule: return m == eMotion::Static || m == eMotion::Kinematic;
+    case eShape::Circle:  return true;
+    case eShape::Chain:   return m == eMotion::Static;
+    default:              return false;
+  } //switch
+} //CanMake
+
+/// Remove a dynamic circle, freeing its slot for reuse. The slot's generation
+/// changes, so the handle and any copies of it become stale. Static and 
+/// kinematic shapes can't be removed, and stale handles are ignored.
+/// \param h Handle of a dynamic circle.
+
+void CShapeStore::Remove(const CShapeHandle& h){
+  if(Get(h) == nullptr || h.m_eMotionType != eMotion::Dynamic)
+    return;
+
+  m_stdDynamicUsed[h.m_nIndex] = false;
+  ++m_stdDynamicGeneration[h.m_nIndex];
+  m_stdDynamicFree.push_back(h.m_nIndex);
+} //Remove
+
+/// Remove all of the shapes and rewind the arena. Pointers to shapes and
+/// handles made before this must not be used after it, so beware.
+
+void CShapeStore::Clear(){
+  m_cPoint.Clear();
+  m_cLineSeg.Clear();
+  m_cCircle.Clear();
+  m_cArc.Clear();
+  m_cPolygon.Clear();
+  m_cChain.Clear();
+  m_cCapsule.Clear();
+
+  m_cKinematicPoint.Clear();
+  m_cKinematicLineSeg.Clear();
+  m_cKinematicCircle.Clear();
+  m_cKinematicArc.Clear();
+  m_cKinematicPolygon.Clear();
+  m_cKinematicCapsule.Clear();
+
+  m_cDynamicCircle.Clear();
+  m_stdDynamicUsed.clear();
+  m_stdDynamicGeneration.clear();
+  m_stdDynamicFree.clear();
+
+  m_cArena.Reset();
+} //Clear
+
+/// Get a pointer to the shape that a handle refers to.
+/// \param h A shape handle.
+/// \return Pointer to shape, nullptr if there isn't one, the handle is stale,
+/// or its index is out of range.
+
+CShape* CShapeStore::Get(const CShapeHandle& h){
+  switch(h.m_eMotionType){
+    case eMotion::Static:
+      switch(h.m_eShapeType){
+        case eShape::Point:   return m_cPoint.Get(h.m_nIndex);
+        case eShape::LineSeg: return m_cLineSeg.Get(h.m_nIndex);
+        case eShape::Circle:  return m_cCircle.Get(h.m_nIndex);
+        case eShape::Arc:     return m_cArc.Get(h.m_nIndex);
+        case eShape::Polygon: return m_cPolygon.Get(h.m_nIndex);
+        case eShape::Chain:   return m_cChain.Get(h.m_nIndex);
+        case eShape::Capsule: return m_cCapsule.Get(h.m_nIndex);
+        default:              return nullptr;
+      } //switch
+      break;
+
+    case eMotion::Kinematic:
+      switch(h.m_eShapeType){
+        case eShape::Point:   return m_cKinematicPoint.Get(h.m_nIndex);
+        case eShape::LineSeg: return m_cKinematicLineSeg.Get(h.m_nIndex);
+        case eShape::Circle:  return m_cKinematicCircle.Get(h.m_nIndex);
+        case eShape::Arc:     return m_cKinematicArc.Get(h.m_nIndex);
+        case eShape::Polygon: return m_cKinematicPolygon.Get(h.m_nIndex);
+        case eShape::Capsule: return m_cKinematicCapsule.Get(h.m_nIndex);
+        default:              return nullptr; //no kinematic chains
+      } //switch
+      break;
+
+    case eMotion::Dynamic:
+      if(h.m_eShapeType == eShape::Circle && h.m_nIndex < m_stdDynamicUsed.size() &&
+        m_stdDynamicUsed[h.m_nIndex] && m_stdDynamicGeneration[h.m_nIndex] == h.m_nGeneration)
+        return &m_cDynamicCircle[h.m_nIndex];
+      break;
+
+    default: break;
+  } //switch
+
+  return nullptr;
+} //Get
+
+/// Reader function for the number of shapes in the store.
+/// \return Number of shapes, including unused dynamic circle slots.
+
+const size_t CShapeStore::GetSize() const{
+  return m_cPoint.GetSize() + m_cLineSeg.GetSize() + m_cCircle.GetSize() + 
+    m_cArc.GetSize() + m_cPolygon.GetSize() + m_cChain.GetSize() + m_cCapsule.GetSize() +
+    m_cKinematicPoint.GetSize() + m_cKinematicLineSeg.GetSize() + m_cKinematicCircle.GetSize() +
+    m_cKinematicArc.GetSize() + m_cKinematicPolygon.GetSize() + m_cKinematicCapsule.GetSize() +
+    m_cDynamicCircle.GetSize();
+} //GetSize
+
+/// Collision detection between any shape and a dynamic circle. The shape type
+/// and motion type are used to select the right instance of Collide(), so
+/// the only run-time dispatch is a switch instead of a virtual function call.
+/// Kinematic shapes use the same collision detection as static ones.
+/// \param p Pointer to a shape.
+/// \param c [in, out] Contact descriptor.
+/// \return true if there was a collision.
+
+bool CShapeStore::PreCollide(CShape* p, CContactDesc& c){
+  switch(p->GetShapeType()){
+    case eShape::Point:   return Collide<CPoint>(p, c);
+    case eShape::LineSeg: return Collide<CLineSeg>(p, c);
+    case eShape::Circle:  return Collide<CCircle>(p, c);
+    case eShape::Arc:     return Collide<CArc>(p, c);
+    case eShape::Polygon: return Collide<CPolygonShape>(p, c);
+    case eShape::Chain:   return Collide<CChainShape>(p, c);
+    case eShape::Capsule: return Collide<CCapsuleShape>(p, c);
+    default:              return p->PreCollide(c);
+  } //switch
+} //PreCollide
+
+/// Collision detection between any shape and a dynamic circle, giving every
+/// contact instead of just one. A chain can touch a dynamic circle with more
+/// than one of its edges at once, any other shape with at most one feature.
+/// \param p Pointer to a shape.
+/// \param c [in, out] Contact descriptor with the shape, dynamic circle, and margin filled in.
+/// \param result [in, out] Contacts are appended to this.
+/// \return Number of contacts appended.
+
+UINT CShapeStore::PreCollide(CShape* p, CContactDesc& c, std::vector<CContactDesc>& result){
+  if(p->GetShapeType() == eShape::Chain)
+    return ((CChainShape*)p)->CChainShape::PreCollide(c, result);
+
+  if(!PreCollide(p, c))return 0; //no contact
+
+  result.push_back(c);
+  return 1;
+} //PreCollide
+
+/// Swept collision detection between any shape and a dynamic circle, using
+/// the shape type to select the right instance of SweptCollide() the same
+/// way that PreCollide() selects the right instance of Collide().
+/// \param p Pointer to a shape.
+/// \param c [in, out] Contact descriptor.
+/// \param v Displacement of the dynamic circle.
+/// \param t [in, out] Earliest time of impact found so far.
+/// \return true if there was a collision before time t.
+
+bool CShapeStore::TimeOfImpact(CShape* p, CContactDesc& c, const Vector2& v, float& t){
+  switch(p->GetShapeType()){
+    case eShape::Point:   return SweptCollide<CPoint>(p, c, v, t);
+    case eShape::LineSeg: return SweptCollide<CLineSeg>(p, c, v, t);
+    case eShape::Circle:  return SweptCollide<CCircle>(p, c, v, t);
+    case eShape::Arc:     return SweptCollide<CArc>(p, c, v, t);
+    case eShape::Polygon: return SweptCollide<CPolygonShape>(p, c, v, t);
+    case eShape::Chain:   return SweptCollide<CChainShape>(p, c, v, t);
+    case eShape::Capsule: return SweptCollide<CCapsuleShape>(p, c, v, t);
+    default:              return p->TimeOfImpact(c, v, t);
+  } //switch
+} //TimeOfImpact
@@ -0,0 +1,124 @@
+/// \file ShapeStore.h
+/// \brief Interface for the shape handle class CShapeHandle and the shape store class CShapeStore.
+
+#ifndef __L4RC_PHYSICS_SHAPESTORE_H__
+#define __L4RC_PHYSICS_SHAPESTORE_H__
+
+#include <vector>
+
+#include "Arena.h"
+#include "Point.h"
+#include "LineSeg.h"
+#include "Circle.h"
+#include "Arc.h"
+#include "PolygonShape.h"
+#include "ChainShape.h"
+#include "CapsuleShape.h"
+#include "DynamicCircle.h"
+
+/// \brief Shape handle.
+///
+/// A shape handle identifies a shape in a shape store by its shape type,
+/// its motion type, and its index in the container for shapes of those types.
+/// Dynamic circle slots are recycled, so a handle for a dynamic circle also
+/// has the generation of its slot, which changes when the dynamic circle is
+/// removed. A handle for a removed dynamic circle is then stale, and the shape
+/// store won't mistake it for whichever dynamic circle gets the slot next.
+/// It is small enough to be passed around by value.
+
+class CShapeHandle{
+  public:
+    eShape m_eShapeType = eShape::Unknown; ///< Shape type.
+    eMotion m_eMotionType = eMotion::Static; ///< Motion type.
+    UINT m_nIndex = 0; ///< Index into container.
+    UINT m_nGeneration = 0; ///< Generation of dynamic circle slot.
+
+    bool IsValid() const; ///< Does this handle refer to a shape?
+}; //CShapeHandle
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Shape collision detection without virtual function calls.
+///
+/// Collision detection for a shape whose type is known at compile time.
+/// The qualified call to `T::PreCollide` is a direct call instead of
+/// a virtual one, so the compiler is free to inline it.
+/// \param p Pointer to a shape, which must be of type T.
+/// \param c [in, out] Contact descriptor.
+/// \return true if there was a collision.
+
+template<class T> bool Collide(CShape* p, CContactDesc& c){
+  return ((T*)p)->T::PreCollide(c);
+} //Collide
+
+/// \brief Swept collision detection without virtual function calls.
+///
+/// Swept collision detection for a shape whose type is known at compile time,
+/// with a direct call to `T::TimeOfImpact` for the same reason as Collide().
+/// \param p Pointer to a shape, which must be of type T.
+/// \param c [in, out] Contact descriptor.
+/// \param v Displacement of the dynamic circle.
+/// \param t [in, out] Earliest time of impact found so far.
+/// \return true if there was a collision before time t.
+
+template<class T> bool SweptCollide(CShape* p, CContactDesc& c, const Vector2& v, float& t){
+  return ((T*)p)->T::TimeOfImpact(c, v, t);
+} //SweptCollide
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Shape store.
+///
+/// The shape store owns all of the shapes. Each combination of shape type and
+/// motion type has its own container, so shapes of the same type sit next to
+/// each other in memory instead of being scattered around the heap by
+/// `new`. The containers are arena lists, which never move a shape once it
+/// has been made, so pointers to shapes remain valid for as long as the shape
+/// exists. Static and kinematic shapes live until the store is cleared or
+/// destroyed. Dynamic circles come and go, so their slots are recycled.
+/// Clearing the store rewinds its arena, so a whole table can be thrown
+/// away and another one made without going back to the heap. Chains are
+/// static only, and their vertices are made in the store's arena too.
+
+class CShapeStore{
+  private:
+    CArena m_cArena; ///< Arena that the shapes are made in.
+
+    CArenaList<CPoint> m_cPoint; ///< Static points.
+    CArenaList<CLineSeg> m_cLineSeg; ///< Static line segments.
+    CArenaList<CCircle> m_cCircle; ///< Static circles.
+    CArenaList<CArc> m_cArc; ///< Static arcs.
+    CArenaList<CPolygonShape> m_cPolygon; ///< Static polygons.
+    CArenaList<CChainShape> m_cChain; ///< Static chains.
+    CArenaList<CCapsuleShape> m_cCapsule; ///< Static capsules.
+
+    CArenaList<CKinematicPoint> m_cKinematicPoint; ///< Kinematic points.
+    CArenaList<CKinematicLineSeg> m_cKinematicLineSeg; ///< Kinematic line segments.
+    CArenaList<CKinematicCircle> m_cKinematicCircle; ///< Kinematic circles.
+    CArenaList<CKinematicArc> m_cKinematicArc; ///< Kinematic arcs.
+    CArenaList<CKinematicPolygonShape> m_cKinematicPolygon; ///< Kinematic polygons.
+    CArenaList<CKinematicCapsuleShape> m_cKinematicCapsule; ///< Kinematic capsules.
+
+    CArenaList<CDynamicCircle> m_cDynamicCircle; ///< Dynamic circles.
+    std::vector<bool> m_stdDynamicUsed; ///< Whether each dynamic circle slot is in use.
+    std::vector<UINT> m_stdDynamicGeneration; ///< Generation of each dynamic circle slot.
+    std::vector<UINT> m_stdDynamicFree; ///< Unused dynamic circle slots.
+
+  public:
+    CShapeStore(); ///< Constructor.
+
+    CShapeHandle Make(CShapeDesc*); ///< Make a shape.
+    void Remove(const CShapeHandle&); ///< Remove a dynamic circle.
+    void Clear(); ///< Remove all shapes.
+
+    CShape* Get(const CShapeHandle&); ///< Get pointer to shape.
+    const size_t GetSize() const; ///< Get number of shapes.
+
+    static bool CanMake(eShape, eMotion); ///< Is there a container for this type?
+
+    static bool PreCollide(CShape*, CContactDesc&); ///< Collision detection.
+    static UINT PreCollide(CShape*, CContactDesc&, std::vector<CContactDesc>&); ///< Collision detection, all contacts.
+    static bool TimeOfImpact(CShape*, CContactDesc&, const Vector2&, float&); ///< Swept collision detection.
+}; //CShapeStore
+
+#endif //__L4RC_PHYSICS_SHAPESTORE_H__
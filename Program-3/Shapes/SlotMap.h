@@ -0,0 +1,219 @@
+/// \file SlotMap.h
+/// \brief Interface for the slot handle class CSlotHandle and the slot map class CSlotMap.
+
+#ifndef __L4RC_PHYSICS_SLOTMAP_H__
+#define __L4RC_PHYSICS_SLOTMAP_H__
+
+#include <vector>
+#include <utility>
+
+#include "VectorMath.h"
+
+/// \brief Slot handle.
+///
+/// A slot handle identifies a value in a slot map by the index of its slot
+/// and the generation of that slot when the value was put into it. The
+/// generation of a slot changes whenever its value is removed, so a handle
+/// to a value that has been removed can be told apart from a handle to a
+/// newer value in the same slot. Generations start at 1, which makes the
+/// default handle invalid.
+
+class CSlotHandle{
+  public:
+    UINT m_nIndex = 0; ///< Slot index.
+    UINT m_nGeneration = 0; ///< Generation of slot, 0 for none.
+
+    bool IsValid() const; ///< Could this handle refer to a value?
+}; //CSlotHandle
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Slot map.
+///
+/// A slot map keeps its values packed together in a single array so that
+/// iterating through them is as fast as for a vector. Values are found
+/// through slot handles, each of which refers to a slot that knows where
+/// the value is in the array. Inserting a value and removing one both take
+/// constant time. A value is removed by moving the last value into its place,
+/// so the order of the values changes and pointers to values don't remain
+/// valid after an insertion or removal. Keep the handle instead, and use
+/// Get() to find the value again, which returns nullptr if it has been removed.
+
+template<class T> class CSlotMap{
+  private:
+    /// \brief Slot.
+    ///
+    /// The position of the value in the array if the slot is in use,
+    /// otherwise the index of the next free slot.
+
+    class CSlot{
+      public:
+        UINT m_nIndex = 0; ///< Index into value array, or next free slot.
+        UINT m_nGeneration = 1; ///< Generation, changes on removal.
+        bool m_bUsed = false; ///< Whether in use.
+    }; //CSlot
+
+    std::vector<T> m_stdValues; ///< Values, packed together.
+    std::vector<UINT> m_stdSlotOf; ///< Slot index for each value.
+    std::vector<CSlot> m_stdSlots; ///< Slots.
+    UINT m_nFree = 0; ///< First free slot, or number of slots if none.
+
+  public:
+    template<class... Args> CSlotHandle Insert(Args&&...); ///< Insert a value.
+    bool Remove(const CSlotHandle&); ///< Remove a value.
+    void Clear(); ///< Remove all values.
+
+    T* Get(const CSlotHandle&); ///< Get value from handle.
+    CSlotHandle GetHandle(UINT) const; ///< Get handle from position.
+    T& operator[](UINT); ///< Get value from position.
+    const UINT GetSize() const; ///< Get number of values.
+
+    typename std::vector<T>::iterator begin(); ///< Start of values.
+    typename std::vector<T>::iterator end(); ///< End of values.
+}; //CSlotMap
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// CSlotHandle functions
+
+/// A default handle has generation zero and refers to no value.
+/// \return true if this handle might refer to a value.
+
+inline bool CSlotHandle::IsValid() const{
+  return m_nGeneration != 0;
+} //IsValid
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// CSlotMap functions
+
+/// Construct a value at the end of the array and give it the first free
+/// slot, making a new slot if none are free.
+/// \param args Arguments for T's constructor.
+/// \return Handle for the new value.
+
+template<class T> template<class... Args> CSlotHandle CSlotMap<T>::Insert(Args&&... args){
+  if(m_nFree == (UINT)m_stdSlots.size()){ //no free slots, so make one
+    m_stdSlots.push_back(CSlot());
+    m_stdSlots.back().m_nIndex = m_nFree + 1;
+  } //if
+
+  const UINT i = m_nFree; //slot index
+  CSlot& slot = m_stdSlots[i];
+  m_nFree = slot.m_nIndex;
+
+  slot.m_nIndex = (UINT)m_stdValues.size();
+  slot.m_bUsed = true;
+  m_stdValues.emplace_back(std::forward<Args>(args)...);
+  m_stdSlotOf.push_back(i);
+
+  CSlotHandle h;
+  h.m_nIndex = i;
+  h.m_nGeneration = slot.m_nGeneration;
+  return h;
+} //Insert
+
+/// Remove the value that a handle refers to by moving the last value into
+/// its place, and put its slot at the front of the free list with a new
+/// generation so that handles to the removed value become stale.
+/// \param h A slot handle.
+/// \return true if the handle referred to a value.
+
+template<class T> bool CSlotMap<T>::Remove(const CSlotHandle& h){
+  if(Get(h) == nullptr)return false; //stale or invalid
+
+  CSlot& slot = m_stdSlots[h.m_nIndex];
+  const UINT j = slot.m_nIndex; //position of value
+  const UINT last = (UINT)m_stdValues.size() - 1; //position of last value
+
+  if(j != last){ //move the last value into the gap
+    m_stdValues[j] = std::move(m_stdValues[last]);
+    m_stdSlotOf[j] = m_stdSlotOf[last];
+    m_stdSlots[m_stdSlotOf[j]].m_nIndex = j;
+  } //if
+
+  m_stdValues.pop_back();
+  m_stdSlotOf.pop_back();
+
+  if(++slot.m_nGeneration == 0) //skip zero, which means no generation
+    slot.m_nGeneration = 1;
+
+  slot.m_bUsed = false;
+  slot.m_nIndex = m_nFree;
+  m_nFree = h.m_nIndex;
+
+  return true;
+} //Remove
+
+/// Remove all values. The slots are kept with new generations,
+/// so that all existing handles become stale.
+
+template<class T> void CSlotMap<T>::Clear(){
+  m_stdValues.clear();
+  m_stdSlotOf.clear();
+
+  for(UINT i=0; i<(UINT)m_stdSlots.size(); i++){
+    CSlot& slot = m_stdSlots[i];
+
+    if(slot.m_bUsed && ++slot.m_nGeneration == 0)
+      slot.m_nGeneration = 1;
+
+    slot.m_bUsed = false;
+    slot.m_nIndex = i + 1;
+  } //for
+
+  m_nFree = 0;
+} //Clear
+
+/// Get the value that a handle refers to.
+/// \param h A slot handle.
+/// \return Pointer to the value, nullptr if it has been removed.
+
+template<class T> T* CSlotMap<T>::Get(const CSlotHandle& h){
+  if(h.m_nIndex >= (UINT)m_stdSlots.size())return nullptr;
+
+  const CSlot& slot = m_stdSlots[h.m_nIndex];
+  if(!slot.m_bUsed || slot.m_nGeneration != h.m_nGeneration)return nullptr;
+
+  return &m_stdValues[slot.m_nIndex];
+} //Get
+
+/// Get a handle for the value at a position in the array.
+/// \param i Position, which must be less than the number of values.
+/// \return Handle for that value.
+
+template<class T> CSlotHandle CSlotMap<T>::GetHandle(UINT i) const{
+  CSlotHandle h;
+  h.m_nIndex = m_stdSlotOf[i];
+  h.m_nGeneration = m_stdSlots[h.m_nIndex].m_nGeneration;
+  return h;
+} //GetHandle
+
+/// Get the value at a position in the array.
+/// \param i Position, which must be less than the number of values.
+/// \return Reference to the value.
+
+template<class T> T& CSlotMap<T>::operator[](UINT i){
+  return m_stdValues[i];
+} //operator[]
+
+/// Reader function for the number of values.
+/// \return Number of values.
+
+template<class T> const UINT CSlotMap<T>::GetSize() const{
+  return (UINT)m_stdValues.size();
+} //GetSize
+
+/// Iterator for the start of the values, for range-based for loops.
+/// \return Iterator pointing to the first value.
+
+template<class T> typename std::vector<T>::iterator CSlotMap<T>::begin(){
+  return m_stdValues.begin();
+} //begin
+
+/// Iterator for the end of the values, for range-based for loops.
+/// \return Iterator pointing one past the last value.
+
+template<class T> typename std::vector<T>::iterator CSlotMap<T>::end(){
+  return m_stdValues.end();
+} //end
+
+#endif //__L4RC_PHYSICS_SLOTMAP_H__
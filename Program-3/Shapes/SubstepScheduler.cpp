@@ -0,0 +1,107 @@
+/// \file SubstepScheduler.cpp
+/// \brief Code for the substep scheduler class CSubstepScheduler.
+
+#include <cfloat>
+
+#include "SubstepScheduler.h"
+#include "Circle.h"
+#include "CapsuleShape.h"
+
+/// Set the bounds on the choices made by the scheduler.
+/// \param smin Minimum number of substeps per frame.
+/// \param smax Maximum number of substeps per frame.
+/// \param cmax Maximum number of collision iterations per substep.
+
+void CSubstepScheduler::SetBounds(UINT smin, UINT smax, UINT cmax){
+  m_nMinSubsteps = max(1U, smin);
+  m_nMaxSubsteps = max(m_nMinSubsteps, smax);
+  m_nMaxCIterations = max(1U, cmax);
+} //SetBounds
+
+/// Set the distance that anything can move in a single substep as a fraction
+/// of the size of the smallest feature near it. Smaller values give more
+/// substeps.
+/// \param f Fraction of feature size.
+
+void CSubstepScheduler::SetMaxTravel(float f){
+  m_fMaxTravel = f;
+} //SetMaxTravel
+
+/// Set the frame time, which is divided into substeps.
+/// \param t Frame time in seconds.
+
+void CSubstepScheduler::SetFrameTime(float t){
+  m_fFrameTime = t;
+} //SetFrameTime
+
+/// Start scheduling a frame by forgetting what was asked for last frame.
+
+void CSubstepScheduler::Begin(){
+  m_fDemand = 0.0f;
+  m_bContact = false;
+} //Begin
+
+/// Add something that moves during this frame.
+/// \param v Its speed in pixels per second.
+/// \param s Size of the smallest feature near it in pixels.
+
+void CSubstepScheduler::Add(float v, float s){
+  if(s > 0.0f)
+    m_fDemand = max(m_fDemand, v*m_fFrameTime/(m_fMaxTravel*s));
+  else m_fDemand = (float)m_nMaxSubsteps; //no size, no chances
+} //Add
+
+/// Note that some dynamic circles are touching each other. Resolving one
+/// contact can push a dynamic circle into another shape, so these frames get 
+/// the maximum number of collision iterations.
+
+void CSubstepScheduler::AddContact(){
+  m_bContact = true;
+} //AddContact
+
+/// Choose the number of substeps for this frame, which is just enough to satisfy
+/// the most demanding thing added, and the number of collision iterations.
+
+void CSubstepScheduler::End(){
+  const UINT n = (UINT)ceilf(min(m_fDemand, (float)m_nMaxSubsteps));
+  m_nSubsteps = min(max(n, m_nMinSubsteps), m_nMaxSubsteps);
+  m_nCIterations = m_bContact? m_nMaxCIterations: 1;
+} //End
+
+/// Reader function for the number of substeps chosen by End().
+/// \return Number of substeps for this frame.
+
+const UINT CSubstepScheduler::GetSubsteps() const{
+  return m_nSubsteps;
+} //GetSubsteps
+
+/// Reader function for the number of collision iterations chosen by End().
+/// \return Number of collision iterations per substep for this frame.
+
+const UINT CSubstepScheduler::GetCIterations() const{
+  return m_nCIterations;
+} //GetCIterations
+
+/// Get the size of the feature that a shape presents to a dynamic circle
+/// moving past it. Circles and arcs are as big as their radius, and capsules
+/// as big as the radius of their smaller end. Points and
+/// line segments have no thickness, so the dynamic circle's own radius is
+/// what limits how far it can move before it sinks too deeply into one,
+/// and they are treated here as being infinitely large.
+/// \param p Pointer to a shape.
+/// \return Feature size in pixels.
+
+float CSubstepScheduler::GetFeatureSize(CShape* p){
+  switch(p->GetShapeType()){
+    case eShape::Circle:
+    case eShape::Arc:
+      return ((CCircle*)p)->GetRadius();
+
+    case eShape::Capsule: {
+      CCapsuleShape* pCapsule = (CCapsuleShape*)p;
+      return min(pCapsule->GetRadius0(), pCapsule->GetRadius1());
+    } //case
+
+    default: return FLT_MAX;
+  } //switch
+} //GetFeatureSize
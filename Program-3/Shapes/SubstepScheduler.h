@@ -0,0 +1,50 @@
+/// \file SubstepScheduler.h
+/// \brief Interface for the substep scheduler class CSubstepScheduler.
+
+#ifndef __L4RC_PHYSICS_SUBSTEPSCHEDULER_H__
+#define __L4RC_PHYSICS_SUBSTEPSCHEDULER_H__
+
+#include "Shape.h"
+
+/// \brief Substep scheduler.
+///
+/// The substep scheduler chooses how many substeps to divide each frame into,
+/// and how many contact solver iterations to do in each substep. Nothing
+/// should move further in a single substep than some fraction of the size of
+/// the smallest feature near it, so a frame with fast moving dynamic circles
+/// near small shapes gets more substeps than a frame in which everything is
+/// slow. At the start of each frame call Begin(), then Add()
+/// the speed and neighbourhood feature size of each dynamic circle, then call
+/// End() to make the choice.
+
+class CSubstepScheduler{
+  private:
+    UINT m_nMinSubsteps = 1; ///< Minimum number of substeps per frame.
+    UINT m_nMaxSubsteps = 4; ///< Maximum number of substeps per frame.
+    UINT m_nMaxCIterations = 2; ///< Maximum number of collision iterations per substep.
+    float m_fMaxTravel = 1.0f; ///< Fraction of feature size that can be travelled in a substep.
+    float m_fFrameTime = 1.0f/60.0f; ///< Frame time in seconds.
+
+    float m_fDemand = 0.0f; ///< Largest number of substeps asked for this frame.
+    bool m_bContact = false; ///< Whether any dynamic circles are touching.
+
+    UINT m_nSubsteps = 1; ///< Number of substeps chosen.
+    UINT m_nCIterations = 1; ///< Number of collision iterations chosen.
+
+  public:
+    void SetBounds(UINT, UINT, UINT); ///< Set bounds.
+    void SetMaxTravel(float); ///< Set maximum travel per substep.
+    void SetFrameTime(float); ///< Set frame time.
+
+    void Begin(); ///< Start scheduling a frame.
+    void Add(float, float); ///< Add a moving thing.
+    void AddContact(); ///< Note that dynamic circles are touching.
+    void End(); ///< Choose substeps and collision iterations.
+
+    const UINT GetSubsteps() const; ///< Get number of substeps.
+    const UINT GetCIterations() const; ///< Get number of collision iterations.
+
+    static float GetFeatureSize(CShape*); ///< Get feature size of a shape.
+}; //CSubstepScheduler
+
+#endif //__L4RC_PHYSICS_SUBSTEPSCHEDULER_H__
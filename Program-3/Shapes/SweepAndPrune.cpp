@@ -0,0 +1,112 @@
+/// \file SweepAndPrune.cpp
+/// \brief Code for the sweep and prune class CSweepAndPrune.
+
+#include "SweepAndPrune.h"
+#include "CollisionStats.h"
+
+/// Insert a dynamic circle by appending it to the end of the list, where
+/// it stays until Update() sorts it into place. There is no attempt to
+/// ensure that it's not already in there, so beware.
+/// \param p Pointer to a dynamic circle.
+
+void CSweepAndPrune::Insert(CDynamicCircle* p){
+  CSweepEntry e;
+  e.m_pCircle = p;
+  e.m_fMinX = p->GetAABB().GetTopLeft().x;
+  e.m_fMaxX = p->GetAABB().GetBottomRt().x;
+
+  p->m_nSweepIndex = (UINT)m_stdEntries.size();
+  m_stdEntries.push_back(e);
+} //Insert
+
+/// Remove a dynamic circle by marking its entry, which Update() will
+/// squeeze out. The dynamic circle itself is not deleted, and its slot
+/// may be reused for a new dynamic circle before then.
+/// \param p Pointer to a dynamic circle.
+
+void CSweepAndPrune::Remove(CDynamicCircle* p){
+  CSweepEntry& e = m_stdEntries[p->m_nSweepIndex];
+
+  if(e.m_pCircle == p){ //beware of removing twice
+    e.m_pCircle = nullptr;
+    ++m_nRemoved;
+  } //if
+} //Remove
+
+/// Remove all dynamic circles.
+
+void CSweepAndPrune::Clear(){
+  m_stdEntries.clear();
+  m_nRemoved = 0;
+} //Clear
+
+/// Squeeze out the entries of removed dynamic circles, copy the extents of
+/// the dynamic circles' AABBs, restore the sorted order using insertion sort,
+/// and tell each dynamic circle where its entry is now.
+
+void CSweepAndPrune::Update(){
+  if(m_nRemoved > 0){ //squeeze out removed entries, keeping the order
+    size_t n = 0; //number of entries kept so far
+
+    for(auto const& e: m_stdEntries)
+      if(e.m_pCircle != nullptr)
+        m_stdEntries[n++] = e;
+
+    m_stdEntries.resize(n);
+    m_nRemoved = 0;
+  } //if
+
+  for(auto& e: m_stdEntries){
+    const CAabb2D& aabb = e.m_pCircle->GetAABB();
+    e.m_fMinX = aabb.GetTopLeft().x;
+    e.m_fMaxX = aabb.GetBottomRt().x;
+  } //for
+
+  for(size_t i=1; i<m_stdEntries.size(); i++){
+    const CSweepEntry e = m_stdEntries[i];
+    size_t j = i;
+
+    for(; j>0 && m_stdEntries[j - 1].m_fMinX > e.m_fMinX; j--)
+      m_stdEntries[j] = m_stdEntries[j - 1];
+
+    m_stdEntries[j] = e;
+  } //for
+
+  for(size_t i=0; i<m_stdEntries.size(); i++)
+    m_stdEntries[i].m_pCircle->m_nSweepIndex = (UINT)i;
+} //Update
+
+/// Sweep along the sorted list to find the pairs of dynamic circles whose
+/// AABBs overlap. Call Update() first if any of them have moved. A positive
+/// margin expands each AABB by that distance on all sides, so that pairs
+/// that are close but not yet overlapping are found too.
+/// \param result [out] List of pairs of dynamic circles with overlapping AABBs.
+/// \param margin Distance by which to expand the AABBs, defaults to zero.
+
+void CSweepAndPrune::GetPairs(std::vector<CCirclePair>& result, float margin){
+  result.clear();
+
+  const size_t n = m_stdEntries.size();
+  const float gap = 2.0f*margin; //largest gap between expanded AABBs that overlap
+
+  for(size_t i=0; i<n; i++){
+    const CSweepEntry& e0 = m_stdEntries[i];
+    CAabb2D aabb0 = e0.m_pCircle->GetAABB();
+    aabb0.Expand(gap); //same as expanding both by margin
+
+    for(size_t j=i + 1; j<n && m_stdEntries[j].m_fMinX <= e0.m_fMaxX + gap; j++){
+      CDynamicCircle* p1 = m_stdEntries[j].m_pCircle;
+      CCollisionStats::AabbTest(p1->GetShapeType());
+
+      if(aabb0 && p1->GetAABB()) //overlap in y too
+        result.push_back(CCirclePair(e0.m_pCircle, p1));
+    } //for
+  } //for
+} //GetPairs
+
+/// Reader function for the number of dynamic circles.
+/// \return Number of dynamic circles.
+
+const size_t CSweepAndPrune::GetSize() const{
+  return m_stdEntries.size() - m_nRemoved;
+} //GetSize
@@ -0,0 +1,63 @@
+/// \file SweepAndPrune.h
+/// \brief Interface for the sweep and prune class CSweepAndPrune.
+
+#ifndef __L4RC_PHYSICS_SWEEPANDPRUNE_H__
+#define __L4RC_PHYSICS_SWEEPANDPRUNE_H__
+
+#include <vector>
+#include <utility>
+
+#include "DynamicCircle.h"
+
+/// \brief Pair of dynamic circles.
+
+typedef std::pair<CDynamicCircle*, CDynamicCircle*> CCirclePair;
+
+/// \brief Sweep and prune entry.
+///
+/// The extent of a dynamic circle's AABB along the \f$x\f$-axis,
+/// copied out of the AABB so that sorting and sweeping don't have
+/// to chase pointers.
+
+class CSweepEntry{
+  public:
+    float m_fMinX = 0.0f; ///< Left side of AABB.
+    float m_fMaxX = 0.0f; ///< Right side of AABB.
+    CDynamicCircle* m_pCircle = nullptr; ///< Pointer to dynamic circle.
+}; //CSweepEntry
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Sweep and prune.
+///
+/// Sweep and prune finds the pairs of dynamic circles whose AABBs overlap.
+/// The circles are kept in a list sorted by the left side of their AABBs.
+/// Sweeping along this list, a circle need only be checked against the circles
+/// that follow it until one is found whose left side is to the right of its
+/// right side. The list is persistent and is re-sorted using insertion sort,
+/// which takes close to linear time since the order changes very little from
+/// one step to the next. Inserting and removing a dynamic circle both take
+/// constant time, so that spawning or draining many balls in one frame doesn't
+/// take quadratic time. A new entry is appended to the end of the list and
+/// left for the insertion sort to move into place, and a removed one is
+/// marked by a null pointer, found from the index stored in the dynamic
+/// circle, and squeezed out before the next sort. Call Update() after any
+/// insertions or removals before calling GetPairs().
+
+class CSweepAndPrune{
+  private:
+    std::vector<CSweepEntry> m_stdEntries; ///< Entries sorted by left side.
+    size_t m_nRemoved = 0; ///< Number of entries marked as removed.
+
+  public:
+    void Insert(CDynamicCircle*); ///< Insert a dynamic circle.
+    void Remove(CDynamicCircle*); ///< Remove a dynamic circle.
+    void Clear(); ///< Remove all dynamic circles.
+
+    void Update(); ///< Update extents and re-sort.
+    void GetPairs(std::vector<CCirclePair>&, float =0.0f); ///< Get overlapping pairs.
+
+    const size_t GetSize() const; ///< Get number of dynamic circles.
+}; //CSweepAndPrune
+
+#endif //__L4RC_PHYSICS_SWEEPANDPRUNE_H__
@@ -0,0 +1,804 @@
+/// \file TableDesc.cpp
+/// \brief Code for the table descriptor class CTableDesc.
+
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+
+#include "TableDesc.h"
+#include "ShapeStore.h"
+
+const UINT TABLE_VERSION = 4; ///< Version of the compiled form, change whenever its layout changes.
+const char TABLE_MAGIC[4] = {'L', '4', 'T', 'B'}; ///< First four bytes of the compiled form.
+const float DEGREES = XM_PI/180.0f; ///< Radians per degree.
+const UINT FNV_OFFSET = 2166136261U; ///< FNV-1a offset basis for 32-bit hashes.
+const UINT FNV_PRIME = 16777619U; ///< FNV-1a prime for 32-bit hashes.
+
+/// \brief Header of the compiled form.
+///
+/// The header is followed by the shapes, the flippers, the polygon and
+/// chain vertices, the names one after the other with a null character
+/// after each, and the four arrays of the grid index, in that order.
+
+class CTableHeader{
+  public:
+    char m_pMagic[4]; ///< Must be TABLE_MAGIC.
+    UINT m_nVersion; ///< Must be TABLE_VERSION.
+    UINT m_nSourceHash; ///< Hash of the source form.
+
+    UINT m_nShapes; ///< Number of shapes.
+    UINT m_nFlippers; ///< Number of flippers.
+    UINT m_nVertices; ///< Number of polygon and chain vertices.
+    UINT m_nNameBytes; ///< Number of bytes of names, including null characters.
+
+    Vector2 m_vOrigin; ///< Bottom left corner of the grid.
+    float m_fCellSize; ///< Width and height of a grid cell.
+    UINT m_nCols; ///< Number of columns of grid cells.
+    UINT m_nRows; ///< Number of rows of grid cells.
+
+    UINT m_nCellStart; ///< Size of grid cell start array.
+    UINT m_nCellList; ///< Size of grid cell list array.
+    UINT m_nLineSegStart; ///< Size of grid line segment start array.
+    UINT m_nLineSegList; ///< Size of grid line segment list array.
+}; //CTableHeader
+
+/// Write an array to a file.
+/// \param output File pointer.
+/// \param v Array.
+/// \return true if it was all written.
+
+template<class T> static bool Write(FILE* output, const std::vector<T>& v){
+  return v.empty() || fwrite(v.data(), sizeof(T), v.size(), output) == v.size();
+} //Write
+
+/// Read an array from a file.
+/// \param input File pointer.
+/// \param v [out] Array.
+/// \param n Number of entries to read.
+/// \return true if they were all read.
+
+template<class T> static bool Read(FILE* input, std::vector<T>& v, UINT n){
+  v.resize(n);
+  return n == 0 || fread(v.data(), sizeof(T), n, input) == n;
+} //Read
+
+/// Read a whole file into a string.
+/// \param fname File name.
+/// \param s [out] Contents of the file.
+/// \return true if the file could be opened.
+
+static bool ReadFile(const char* fname, std::string& s){
+  FILE* input = nullptr;
+  if(fopen_s(&input, fname, "rb") != 0 || input == nullptr)return false;
+
+  char buffer[4096];
+  size_t n = 0;
+
+  s.clear();
+
+  while((n = fread(buffer, 1, sizeof(buffer), input)) > 0)
+    s.append(buffer, n);
+
+  fclose(input);
+  return true;
+} //ReadFile
+
+/// Convert a number to text using the fewest digits that read back as the
+/// same float, but no more than a given number of significant digits.
+/// \param f A number.
+/// \param n Maximum number of significant digits.
+/// \return The number as text.
+
+static std::string ToString(float f, int n=9){
+  char buffer[32];
+  f += 0.0f; //no negative zero
+
+  for(int i=6; i<=n; i++){
+    snprintf(buffer, sizeof(buffer), "%.*g", i, f);
+    if(strtof(buffer, nullptr) == f)break;
+  } //for
+
+  return buffer;
+} //ToString
+
+/// Check that a polygon is convex and has no zero-length edges, which is what
+/// CPolygonShape needs. The turns from each edge to the next must all be the
+/// same way, or straight on, and they must add up to a single full turn,
+/// which rules out stars and edges that double back.
+/// \param v Vertices, in either order around the polygon.
+/// \param n Number of vertices.
+/// \return true if the polygon is convex.
+
+static bool IsConvex(const Vector2* v, UINT n){
+  float sign = 0.0f; //sign of the turns so far, zero if none yet
+  float turn = 0.0f; //total angle turned
+
+  for(UINT i=0; i<n; i++){
+    const Vector2 e0 = v[i] - v[(i + n - 1)%n]; //edge into vertex i
+    const Vector2 e1 = v[(i + 1)%n] - v[i]; //edge out of vertex i
+    if(e1.LengthSquared() <= 0.0f)return false; //zero-length edge
+
+    const float cross = e0.x*e1.y - e0.y*e1.x;
+    if(cross*sign < 0.0f)return false; //turns the other way
+    if(cross != 0.0f)sign = cross;
+
+    turn += atan2f(cross, e0.Dot(e1));
+  } //for
+
+  return fabsf(fabsf(turn) - XM_2PI) < 0.01f;
+} //IsConvex
+
+/// Check whether a chain has a zero-length edge, which would give
+/// CChainShape a zero normal.
+/// \param v Vertices.
+/// \param n Number of vertices.
+/// \param bLoop Whether the last vertex is joined to the first.
+/// \return true if two vertices joined by an edge are the same.
+
+static bool HasZeroEdge(const Vector2* v, UINT n, bool bLoop){
+  for(UINT i=0; i+1<n; i++)
+    if((v[i + 1] - v[i]).LengthSquared() <= 0.0f)
+      return true;
+
+  return bLoop && (v[0] - v[n - 1]).LengthSquared() <= 0.0f;
+} //HasZeroEdge
+
+/////////////////////////////////////////////////////////////////////////////
+// CTableDesc private functions
+
+/// Remove all shapes, flippers, vertices, names, and the grid index.
+
+void CTableDesc::Reset(){
+  m_stdShapes.clear();
+  m_stdFlippers.clear();
+  m_stdVertices.clear();
+  m_stdNames.clear();
+  m_cGrid = CGridIndex();
+  m_nSourceHash = 0;
+} //Reset
+
+/// Find a name in the name list, adding it if it isn't already there.
+/// \param s A name.
+/// \return Index of the name in the name list.
+
+UINT CTableDesc::AddName(const std::string& s){
+  for(UINT i=0; i<(UINT)m_stdNames.size(); i++)
+    if(m_stdNames[i] == s)return i;
+
+  m_stdNames.push_back(s);
+  return (UINT)m_stdNames.size() - 1;
+} //AddName
+
+/// Parse a line of the source form and add the shape or flipper that it
+/// describes. Comments are stripped and blank lines are ignored. A shape
+/// that the shape store has no container for, a polygon that isn't convex,
+/// and a polygon or chain with a zero-length edge, don't make sense.
+/// \param line A line of text, which will be overwritten.
+/// \return true if the line made sense.
+
+bool CTableDesc::ParseLine(char* line){
+  char* p = strchr(line, '#'); //start of comment
+  if(p)*p = '\0';
+
+  //split into words
+
+  std::vector<char*> word;
+
+  for(p=line; *p; ){
+    while(*p && isspace((unsigned char)*p))*p++ = '\0';
+    if(*p)word.push_back(p);
+    while(*p && !isspace((unsigned char)*p))++p;
+  } //for
+
+  if(word.empty())return true; //blank line
+
+  //count the numbers after the keyword
+
+  const std::string key = word[0];
+  std::vector<float> f(word.size() + 5, 0.0f); //numbers, with room for missing ones
+  UINT n = 0; //how many
+
+  for(; n + 1<(UINT)word.size(); n++){
+    char* end = nullptr;
+    f[n] = strtof(word[n + 1], &end);
+    if(end == word[n + 1] || *end)break; //not a number
+  } //for
+
+  //flippers
+
+  if(key == "flipper"){
+    if(word.size() != 5)return false;
+
+    for(n=0; n<3; n++){
+      char* end = nullptr;
+      f[n] = strtof(word[n + 2], &end);
+      if(end == word[n + 2] || *end)return false;
+    } //for
+
+    CTableFlipper flipper;
+    flipper.m_bLeft = strcmp(word[1], "left") == 0;
+    if(!flipper.m_bLeft && strcmp(word[1], "right") != 0)return false;
+
+    flipper.m_vRotCenter = Vector2(f[0], f[1]);
+    flipper.m_fOrientation = f[2]*DEGREES;
+    m_stdFlippers.push_back(flipper);
+    return true;
+  } //if
+
+  //shape geometry
+
+  CTableShape s;
+  UINT needed = 0; //number of numbers needed
+
+  if(key == "point"){
+    s.m_eShapeType = eShape::Point;
+    needed = 2;
+  } //if
+
+  else if(key == "segment"){
+    s.m_eShapeType = eShape::LineSeg;
+    needed = 4;
+    s.m_vPos2 = Vector2(f[2], f[3]);
+  } //else if
+
+  else if(key == "circle"){
+    s.m_eShapeType = eShape::Circle;
+    needed = 3;
+    s.m_fRadius = f[2];
+  } //else if
+
+  else if(key == "arc"){
+    s.m_eShapeType = eShape::Arc;
+    needed = 5;
+    s.m_fRadius = f[2];
+    s.m_fAngle0 = f[3]*DEGREES;
+    s.m_fAngle1 = f[4]*DEGREES;
+  } //else if
+
+  else if(key == "polygon"){
+    if(n < 6 || n%2 == 1 || n > 2*CPolygonDesc::MAX_VERTICES)return false; //wrong number of numbers
+    s.m_eShapeType = eShape::Polygon;
+    needed = n;
+    s.m_nFirstVertex = (UINT)m_stdVertices.size();
+    s.m_nVertices = n/2;
+
+    for(UINT i=0; i<n; i+=2)
+      m_stdVertices.push_back(Vector2(f[i], f[i + 1]));
+  } //else if
+
+  else if(key == "chain"){
+    if(n < 4 || n%2 == 1)return false; //not enough vertices, or an odd number of numbers
+    s.m_eShapeType = eShape::Chain;
+    needed = n;
+    s.m_nFirstVertex = (UINT)m_stdVertices.size();
+    s.m_nVertices = n/2;
+
+    for(UINT i=0; i<n; i+=2)
+      m_stdVertices.push_back(Vector2(f[i], f[i + 1]));
+  } //else if
+
+  else if(key == "capsule"){
+    s.m_eShapeType = eShape::Capsule;
+    needed = 6;
+    s.m_fRadius = f[2];
+    s.m_vPos2 = Vector2(f[3], f[4]);
+    s.m_fRadius2 = f[5];
+  } //else if
+
+  else return false; //unknown keyword
+
+  if(n < needed)return false; //not enough numbers
+  s.m_vPos = Vector2(f[0], f[1]);
+
+  //options
+
+  for(UINT i=needed + 1; i<(UINT)word.size(); i++){
+    char* value = strchr(word[i], '=');
+    if(value)*value++ = '\0';
+
+    const std::string option = word[i];
+    char* comma = value? strchr(value, ','): nullptr;
+    if(comma)*comma++ = '\0';
+
+    if(option == "kinematic")
+      s.m_eMotionType = eMotion::Kinematic;
+
+    else if(option == "sensor")
+      s.m_bIsSensor = true;
+
+    else if(option == "nocollide")
+      s.m_bCanCollide = false;
+
+    else if(option == "loop")
+      s.m_bLoop = true;
+
+    else if(option == "e" && value)
+      s.m_fElasticity = strtof(value, nullptr);
+
+    else if(option == "score" && value)
+      s.m_nScore = (UINT)strtoul(value, nullptr, 10);
+
+    else if(option == "sound" && value)
+      s.m_nSound = AddName(value);
+
+    else if(option == "sprite" && value){
+      s.m_nUnlitSprite = AddName(value);
+      s.m_nLitSprite = AddName(comma? comma: value);
+    } //else if
+
+    else if(option == "offset" && value && comma)
+      s.m_vSpriteOffset = Vector2(strtof(value, nullptr), strtof(comma, nullptr));
+
+    else if(option == "part" && value){
+      char* colon = strchr(value, ':');
+      if(colon)*colon++ = '\0';
+
+      if(strcmp(value, "gate") == 0)s.m_ePart = eTablePart::Gate;
+      else if(strcmp(value, "flipper") == 0)s.m_ePart = eTablePart::Flipper;
+      else if(strcmp(value, "bumper") == 0)s.m_ePart = eTablePart::Bumper;
+      else return false;
+
+      s.m_nPart = colon? (UINT)strtoul(colon, nullptr, 10): 0;
+    } //else if
+
+    else return false; //unknown option
+  } //for
+
+  if(!CShapeStore::CanMake(s.m_eShapeType, s.m_eMotionType))
+    return false; //such as a kinematic chain
+
+  //check the vertices, now that it is known whether a chain loops
+
+  const Vector2* v = s.m_nVertices > 0? &m_stdVertices[s.m_nFirstVertex]: nullptr;
+
+  if(s.m_eShapeType == eShape::Polygon && !IsConvex(v, s.m_nVertices))
+    return false;
+
+  if(s.m_eShapeType == eShape::Chain && HasZeroEdge(v, s.m_nVertices, s.m_bLoop))
+    return false;
+
+  m_stdShapes.push_back(s);
+  return true;
+} //ParseLine
+
+/////////////////////////////////////////////////////////////////////////////
+// CTableDesc public functions
+
+/// Load a table from its source form, replacing whatever was there before.
+/// The grid index is left empty, so call Bake() before using it.
+/// \param fname File name.
+/// \return true if the file was opened and every line made sense.
+
+bool CTableDesc::LoadText(const char* fname){
+  Reset();
+
+  std::string text;
+  if(!ReadFile(fname, text))return false;
+
+  m_nSourceHash = Hash(text.data(), text.size());
+  bool bOK = true;
+
+  for(size_t i=0; i<text.size() && bOK; ){ //for each line
+    size_t j = text.find('\n', i);
+    if(j == std::string::npos)j = text.size();
+
+    std::string line = text.substr(i, j - i);
+    bOK = ParseLine(&line[0]);
+    i = j + 1;
+  } //for
+
+  for(auto const& s: m_stdShapes) //check parts
+    bOK = bOK && IsValidPart(s);
+
+  if(!bOK)Reset();
+  return bOK;
+} //LoadText
+
+/// Save a table in its source form, which LoadText() can read back.
+/// Numbers are written with enough digits to get the same floats back,
+/// apart from angles, which are converted to degrees and rounded to seven
+/// significant digits.
+/// \param fname File name.
+/// \return true if the file was written.
+
+bool CTableDesc::SaveText(const char* fname) const{
+  FILE* output = nullptr;
+  if(fopen_s(&output, fname, "wt") != 0 || output == nullptr)return false;
+
+  fprintf(output, "# Pinball table, see CTableDesc for the format.\n\n");
+
+  for(auto const& f: m_stdFlippers)
+    fprintf(output, "flipper %s %s %s %s\n", f.m_bLeft? "left": "right",
+      ToString(f.m_vRotCenter.x).c_str(), ToString(f.m_vRotCenter.y).c_str(),
+      ToString(f.m_fOrientation/DEGREES, 7).c_str());
+
+  if(!m_stdFlippers.empty())
+    fprintf(output, "\n");
+
+  for(auto const& s: m_stdShapes){
+    switch(s.m_eShapeType){
+      case eShape::Point:
+        fprintf(output, "point %s %s", ToString(s.m_vPos.x).c_str(), ToString(s.m_vPos.y).c_str());
+        break;
+
+      case eShape::LineSeg:
+        fprintf(output, "segment %s %s %s %s",
+          ToString(s.m_vPos.x).c_str(), ToString(s.m_vPos.y).c_str(),
+          ToString(s.m_vPos2.x).c_str(), ToString(s.m_vPos2.y).c_str());
+        break;
+
+      case eShape::Circle:
+        fprintf(output, "circle %s %s %s", ToString(s.m_vPos.x).c_str(),
+          ToString(s.m_vPos.y).c_str(), ToString(s.m_fRadius).c_str());
+        break;
+
+      case eShape::Arc:
+        fprintf(output, "arc %s %s %s %s %s", ToString(s.m_vPos.x).c_str(),
+          ToString(s.m_vPos.y).c_str(), ToString(s.m_fRadius).c_str(),
+          ToString(s.m_fAngle0/DEGREES, 7).c_str(), ToString(s.m_fAngle1/DEGREES, 7).c_str());
+        break;
+
+      case eShape::Polygon:
+      case eShape::Chain:
+        fprintf(output, s.m_eShapeType == eShape::Polygon? "polygon": "chain");
+
+        for(UINT i=0; i<s.m_nVertices; i++){
+          const Vector2& v = m_stdVertices[s.m_nFirstVertex + i];
+          fprintf(output, " %s %s", ToString(v.x).c_str(), ToString(v.y).c_str());
+        } //for
+        break;
+
+      case eShape::Capsule:
+        fprintf(output, "capsule %s %s %s %s %s %s",
+          ToString(s.m_vPos.x).c_str(), ToString(s.m_vPos.y).c_str(), ToString(s.m_fRadius).c_str(),
+          ToString(s.m_vPos2.x).c_str(), ToString(s.m_vPos2.y).c_str(), ToString(s.m_fRadius2).c_str());
+        break;
+
+      default: continue;
+    } //switch
+
+    fprintf(output, " e=%s", ToString(s.m_fElasticity).c_str());
+
+    if(s.m_eMotionType == eMotion::Kinematic)fprintf(output, " kinematic");
+    if(s.m_bIsSensor)fprintf(output, " sensor");
+    if(!s.m_bCanCollide)fprintf(output, " nocollide");
+    if(s.m_bLoop)fprintf(output, " loop");
+
+    if(s.m_nUnlitSprite != CTableShape::NO_NAME)
+      fprintf(output, " sprite=%s,%s", GetName(s.m_nUnlitSprite), GetName(s.m_nLitSprite));
+
+    if(s.m_vSpriteOffset != Vector2(0.0f))
+      fprintf(output, " offset=%s,%s", ToString(s.m_vSpriteOffset.x).c_str(),
+        ToString(s.m_vSpriteOffset.y).c_str());
+
+    if(s.m_nSound != CTableShape::NO_NAME)fprintf(output, " sound=%s", GetName(s.m_nSound));
+    if(s.m_nScore > 0)fprintf(output, " score=%u", s.m_nScore);
+
+    switch(s.m_ePart){
+      case eTablePart::Gate:    fprintf(output, " part=gate"); break;
+      case eTablePart::Flipper: fprintf(output, " part=flipper:%u", s.m_nPart); break;
+      case eTablePart::Bumper:  fprintf(output, " part=bumper:%u", s.m_nPart); break;
+      default: break; //not part of anything
+    } //switch
+
+    fprintf(output, "\n");
+  } //for
+
+  const bool bOK = ferror(output) == 0;
+  fclose(output);
+  return bOK;
+} //SaveText
+
+/// Load a table from its compiled form, replacing whatever was there before.
+/// Each array is read straight into memory with a single read. Since the file
+/// may have been damaged or truncated, nothing in it is trusted until it has
+/// been checked: the array sizes in the header must add up to the file size,
+/// the names must end in a NUL, each shape must pass IsValidShape(), and the
+/// grid index must fit the shapes that go into the grid.
+/// \param fname File name.
+/// \return true if the file was opened, is the right version, and checks out.
+
+bool CTableDesc::LoadBinary(const char* fname){
+  Reset();
+
+  FILE* input = nullptr;
+  if(fopen_s(&input, fname, "rb") != 0 || input == nullptr)return false;
+
+  fseek(input, 0, SEEK_END);
+  const long nFileSize = ftell(input);
+  fseek(input, 0, SEEK_SET);
+
+  CTableHeader h;
+  bool bOK = fread(&h, sizeof(h), 1, input) == 1 &&
+    memcmp(h.m_pMagic, TABLE_MAGIC, sizeof(TABLE_MAGIC)) == 0 &&
+    h.m_nVersion == TABLE_VERSION;
+
+  if(bOK){ //array sizes add up to the file size, so they can be allocated
+    const unsigned long long n = sizeof(h) +
+      (unsigned long long)h.m_nShapes*sizeof(CTableShape) +
+      (unsigned long long)h.m_nFlippers*sizeof(CTableFlipper) +
+      (unsigned long long)h.m_nVertices*sizeof(Vector2) + h.m_nNameBytes +
+      ((unsigned long long)h.m_nCellStart + h.m_nCellList +
+        h.m_nLineSegStart + h.m_nLineSegList)*sizeof(UINT);
+
+    bOK = nFileSize >= 0 && n == (unsigned long long)nFileSize;
+  } //if
+
+  std::vector<char> names;
+
+  bOK = bOK && Read(input, m_stdShapes, h.m_nShapes) &&
+    Read(input, m_stdFlippers, h.m_nFlippers) && Read(input, m_stdVertices, h.m_nVertices) &&
+    Read(input, names, h.m_nNameBytes) &&
+    Read(input, m_cGrid.m_stdCellStart, h.m_nCellStart) &&
+    Read(input, m_cGrid.m_stdCellList, h.m_nCellList) &&
+    Read(input, m_cGrid.m_stdLineSegStart, h.m_nLineSegStart) &&
+    Read(input, m_cGrid.m_stdLineSegList, h.m_nLineSegList);
+
+  fclose(input);
+
+  bOK = bOK && (names.empty() || names.back() == '\0'); //last name ends in NUL
+
+  if(bOK) //split names so that the shapes' name indices can be checked
+    for(size_t i=0; i<names.size(); i+=m_stdNames.back().size() + 1)
+      m_stdNames.push_back(&names[i]);
+
+  for(auto const& s: m_stdShapes)
+    bOK = bOK && IsValidShape(s);
+
+  if(bOK){ //grid index fits the grid shapes
+    m_cGrid.m_vOrigin = h.m_vOrigin;
+    m_cGrid.m_fCellSize = h.m_fCellSize;
+    m_cGrid.m_nCols = h.m_nCols;
+    m_cGrid.m_nRows = h.m_nRows;
+
+    UINT nLineSegs = 0, nOthers = 0;
+
+    for(UINT i=0; i<(UINT)m_stdShapes.size(); i++)
+      if(IsGridShape(i))
+        ++(m_stdShapes[i].m_eShapeType == eShape::LineSeg? nLineSegs: nOthers);
+
+    bOK = m_cGrid.IsValid(nLineSegs, nOthers);
+  } //if
+
+  if(bOK)m_nSourceHash = h.m_nSourceHash;
+  else Reset();
+
+  return bOK;
+} //LoadBinary
+
+/// Save a table in its compiled form, which LoadBinary() can read back.
+/// Call Bake() first so that the grid index goes with it.
+/// \param fname File name.
+/// \return true if the file was written.
+
+bool CTableDesc::SaveBinary(const char* fname) const{
+  FILE* output = nullptr;
+  if(fopen_s(&output, fname, "wb") != 0 || output == nullptr)return false;
+
+  std::vector<char> names;
+
+  for(auto const& s: m_stdNames)
+    names.insert(names.end(), s.c_str(), s.c_str() + s.size() + 1);
+
+  CTableHeader h;
+  memcpy(h.m_pMagic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+  h.m_nVersion = TABLE_VERSION;
+  h.m_nSourceHash = m_nSourceHash;
+
+  h.m_nShapes = (UINT)m_stdShapes.size();
+  h.m_nFlippers = (UINT)m_stdFlippers.size();
+  h.m_nVertices = (UINT)m_stdVertices.size();
+  h.m_nNameBytes = (UINT)names.size();
+
+  h.m_vOrigin = m_cGrid.m_vOrigin;
+  h.m_fCellSize = m_cGrid.m_fCellSize;
+  h.m_nCols = m_cGrid.m_nCols;
+  h.m_nRows = m_cGrid.m_nRows;
+
+  h.m_nCellStart = (UINT)m_cGrid.m_stdCellStart.size();
+  h.m_nCellList = (UINT)m_cGrid.m_stdCellList.size();
+  h.m_nLineSegStart = (UINT)m_cGrid.m_stdLineSegStart.size();
+  h.m_nLineSegList = (UINT)m_cGrid.m_stdLineSegList.size();
+
+  const bool bOK = fwrite(&h, sizeof(h), 1, output) == 1 &&
+    Write(output, m_stdShapes) && Write(output, m_stdFlippers) &&
+    Write(output, m_stdVertices) && Write(output, names) &&
+    Write(output, m_cGrid.m_stdCellStart) && Write(output, m_cGrid.m_stdCellList) &&
+    Write(output, m_cGrid.m_stdLineSegStart) && Write(output, m_cGrid.m_stdLineSegList);
+
+  fclose(output);
+  return bOK;
+} //SaveBinary
+
+/// Load a table from its compiled form if that was compiled from the source
+/// form as it is now. Otherwise, load the source form, bake it, and save the
+/// compiled form for next time. The compiled form is used on its own if the
+/// source form can't be found.
+/// \param source Source form file name.
+/// \param compiled Compiled form file name.
+/// \param s Width and height of a grid cell, used if baking.
+/// \return true if the table was loaded from either file.
+
+bool CTableDesc::Load(const char* source, const char* compiled, float s){
+  std::string text;
+  const bool bSource = ReadFile(source, text);
+
+  if(LoadBinary(compiled) && m_cGrid.m_fCellSize == s &&
+    (!bSource || m_nSourceHash == Hash(text.data(), text.size())))
+    return true; //up to date
+
+  if(!LoadText(source))return false;
+
+  Bake(s);
+  SaveBinary(compiled); //not fatal if this fails, we'll bake again next time
+  return true;
+} //Load
+
+/// Work out the grid index by making the static shapes that go into the
+/// grid in a scratch shape store and asking a scratch grid where they go.
+/// \param s Width and height of a grid cell.
+
+void CTableDesc::Bake(float s){
+  CShapeStore store;
+  std::vector<CShape*> shapes;
+
+  for(UINT i=0; i<(UINT)m_stdShapes.size(); i++)
+    if(IsGridShape(i)) //so the shape can be made
+      shapes.push_back(store.Get(store.Make(GetShapeDesc(i))));
+
+  CGrid grid;
+  grid.MakeIndex(shapes, s, m_cGrid);
+} //Bake
+
+/// Reader function for whether the grid index has been worked out,
+/// either by Bake() or by loading the compiled form.
+/// \return true if there is a grid index.
+
+bool CTableDesc::IsBaked() const{
+  return m_cGrid.m_fCellSize > 0.0f;
+} //IsBaked
+
+/// Can a shape be made? Its shape type must be known and the shape store
+/// must have a container for its shape type and motion type. Shapes that
+/// can't be made are skipped, both when baking and when loading a table.
+/// \param i Index of a shape.
+/// \return true if the shape can be made.
+
+bool CTableDesc::CanMake(UINT i) const{
+  const CTableShape& s = m_stdShapes[i];
+  return CShapeStore::CanMake(s.m_eShapeType, s.m_eMotionType);
+} //CanMake
+
+/// Is a shape part of something that exists? A flipper part must refer to one
+/// of the flippers. A bumper part can refer to any bumper, but since each
+/// bumper has at least one shape there can't be more bumpers than shapes.
+/// \param s A table shape.
+/// \return true if the part checks out.
+
+bool CTableDesc::IsValidPart(const CTableShape& s) const{
+  switch(s.m_ePart){
+    case eTablePart::None:
+    case eTablePart::Gate:    return true;
+    case eTablePart::Flipper: return s.m_nPart < (UINT)m_stdFlippers.size();
+    case eTablePart::Bumper:  return s.m_nPart < (UINT)m_stdShapes.size();
+    default:                  return false;
+  } //switch
+} //IsValidPart
+
+/// Check a shape that has been read from the compiled form, so that a damaged
+/// file can't get a bad index into GetShapeDesc() or GetName(). Its shape type
+/// and motion type must be ones that can be made, its part must check out,
+/// its vertices must be in the vertex list and there must be enough of them
+/// for its shape type, and its sprite and sound names must be in the name
+/// list. Call this after the vertex list, flipper list, and name list
+/// have been read.
+/// \param s A table shape.
+/// \return true if the shape checks out.
+
+bool CTableDesc::IsValidShape(const CTableShape& s) const{
+  FailIf(!CShapeStore::CanMake(s.m_eShapeType, s.m_eMotionType));
+  FailIf(!IsValidPart(s));
+  FailIf((size_t)s.m_nFirstVertex + s.m_nVertices > m_stdVertices.size());
+
+  FailIf(s.m_eShapeType == eShape::Polygon &&
+    (s.m_nVertices < 3 || s.m_nVertices > CPolygonDesc::MAX_VERTICES));
+  FailIf(s.m_eShapeType == eShape::Chain && s.m_nVertices < 2);
+
+  const UINT n = (UINT)m_stdNames.size();
+
+  for(UINT i: {s.m_nUnlitSprite, s.m_nLitSprite, s.m_nSound})
+    FailIf(i != CTableShape::NO_NAME && i >= n);
+
+  return true;
+} //IsValidShape
+
+/// Does a shape go into the grid? The static shapes that can be made and
+/// aren't gates do, since gates have their own collision detection.
+/// \param i Index of a shape.
+/// \return true if the shape goes into the grid.
+
+bool CTableDesc::IsGridShape(UINT i) const{
+  const CTableShape& s = m_stdShapes[i];
+  return CanMake(i) && s.m_eMotionType == eMotion::Static && s.m_ePart != eTablePart::Gate;
+} //IsGridShape
+
+/// Fill in a shape descriptor of the right type for a shape. The descriptor
+/// belongs to the table descriptor and is overwritten by the next call.
+/// \param i Index of a shape.
+/// \return Pointer to a shape descriptor, nullptr if the shape type is unknown.
+
+CShapeDesc* CTableDesc::GetShapeDesc(UINT i){
+  const CTableShape& s = m_stdShapes[i];
+  CShapeDesc* p = nullptr;
+
+  switch(s.m_eShapeType){
+    case eShape::Point:
+      m_cPointDesc.m_vPos = s.m_vPos;
+      p = &m_cPointDesc;
+      break;
+
+    case eShape::LineSeg:
+      m_cLineSegDesc.SetEndPts(s.m_vPos, s.m_vPos2);
+      p = &m_cLineSegDesc;
+      break;
+
+    case eShape::Circle:
+      m_cCircleDesc.m_vPos = s.m_vPos;
+      m_cCircleDesc.m_fRadius = s.m_fRadius;
+      p = &m_cCircleDesc;
+      break;
+
+    case eShape::Arc:
+      m_cArcDesc.m_vPos = s.m_vPos;
+      m_cArcDesc.m_fRadius = s.m_fRadius;
+      m_cArcDesc.SetAngles(s.m_fAngle0, s.m_fAngle1);
+      p = &m_cArcDesc;
+      break;
+
+    case eShape::Polygon:
+      m_cPolygonDesc.SetVertices(&m_stdVertices[s.m_nFirstVertex], s.m_nVertices);
+      p = &m_cPolygonDesc;
+      break;
+
+    case eShape::Chain:
+      m_cChainDesc.SetVertices(&m_stdVertices[s.m_nFirstVertex], s.m_nVertices, s.m_bLoop);
+      p = &m_cChainDesc;
+      break;
+
+    case eShape::Capsule:
+      m_cCapsuleDesc = CCapsuleDesc(s.m_vPos, s.m_fRadius, s.m_vPos2, s.m_fRadius2);
+      p = &m_cCapsuleDesc;
+      break;
+
+    default: return nullptr;
+  } //switch
+
+  p->m_eMotionType = s.m_eMotionType;
+  p->m_fElasticity = s.m_fElasticity;
+  p->m_bIsSensor = s.m_bIsSensor;
+
+  return p;
+} //GetShapeDesc
+
+/// Get a name from the name list.
+/// \param i Index of a name.
+/// \return The name, or nullptr if there isn't one.
+
+const char* CTableDesc::GetName(UINT i) const{
+  return i < (UINT)m_stdNames.size()? m_stdNames[i].c_str(): nullptr;
+} //GetName
+
+/// Hash some text using 32-bit FNV-1a, so that the compiled form can
+/// tell whether the source form has changed since it was compiled.
+/// \param p Pointer to text.
+/// \param n Number of bytes.
+/// \return Hash.
+
+UINT CTableDesc::Hash(const char* p, size_t n){
+  UINT h = FNV_OFFSET;
+
+  for(size_t i=0; i<n; i++)
+    h = (h ^ (unsigned char)p[i])*FNV_PRIME;
+
+  return h;
+} //Hash
@@ -0,0 +1,160 @@
+/// \file TableDesc.h
+/// \brief Interface for the table descriptor class CTableDesc.
+
+#ifndef __L4RC_PHYSICS_TABLEDESC_H__
+#define __L4RC_PHYSICS_TABLEDESC_H__
+
+#include <string>
+#include <vector>
+
+#include "Point.h"
+#include "LineSeg.h"
+#include "Circle.h"
+#include "Arc.h"
+#include "PolygonShape.h"
+#include "ChainShape.h"
+#include "CapsuleShape.h"
+#include "Grid.h"
+
+/// \brief Table part type.
+///
+/// What a shape in a table is part of, if anything. `Size` must be last.
+
+enum class eTablePart: UINT{
+  None, Gate, Flipper, Bumper,
+  Size //MUST be last
+}; //eTablePart
+
+/// \brief Table shape.
+///
+/// Everything needed to make one shape of a table and its game object, with
+/// all positions and angles worked out. Sprites and sounds are given by name,
+/// that is, by their index in the table's name list, so that the collision
+/// module doesn't need to know what they are. This is plain old data so that
+/// a list of them can be read and written in one go.
+
+class CTableShape{
+  public:
+    eShape m_eShapeType = eShape::Unknown; ///< Shape type.
+    eMotion m_eMotionType = eMotion::Static; ///< Motion type.
+    bool m_bIsSensor = false; ///< Sensor only, no rebound.
+    bool m_bCanCollide = true; ///< Can collide, false for decoration only.
+    bool m_bLoop = false; ///< Whether a chain's last vertex is joined to its first.
+    float m_fElasticity = 1.0f; ///< Elasticity.
+
+    Vector2 m_vPos; ///< Position of a point, center of a circle or arc, first end point of a line segment, or center of a capsule's end 0.
+    Vector2 m_vPos2; ///< Second end point of a line segment, or center of a capsule's end 1.
+    float m_fRadius = 0.0f; ///< Radius of a circle or arc, or of a capsule's end 0.
+    float m_fRadius2 = 0.0f; ///< Radius of a capsule's end 1.
+    float m_fAngle0 = 0.0f; ///< First angle of an arc.
+    float m_fAngle1 = 0.0f; ///< Second angle of an arc.
+    UINT m_nFirstVertex = 0; ///< Index of a polygon's or chain's first vertex in the table's vertex list.
+    UINT m_nVertices = 0; ///< Number of vertices of a polygon or chain.
+
+    eTablePart m_ePart = eTablePart::None; ///< What this shape is part of.
+    UINT m_nPart = 0; ///< Which flipper or bumper it is part of.
+
+    UINT m_nUnlitSprite = NO_NAME; ///< Unlit sprite name.
+    UINT m_nLitSprite = NO_NAME; ///< Lit sprite name.
+    UINT m_nSound = NO_NAME; ///< Collision sound name.
+    UINT m_nScore = 0; ///< Score for collision.
+    Vector2 m_vSpriteOffset; ///< Sprite offset in local coordinates.
+
+    static const UINT NO_NAME = 0xFFFFFFFF; ///< Name index for none.
+}; //CTableShape
+
+/// \brief Table flipper.
+///
+/// The center of rotation and initial orientation of a flipper. The shapes
+/// that are part of it are given at orientation zero and are rotated into
+/// place when the table is made.
+
+class CTableFlipper{
+  public:
+    Vector2 m_vRotCenter; ///< Center of rotation.
+    float m_fOrientation = 0.0f; ///< Initial orientation.
+    bool m_bLeft = true; ///< Whether this is a left flipper.
+}; //CTableFlipper
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Table descriptor.
+///
+/// A pinball table described as data instead of code. The source form is a text
+/// file that can be edited by hand, with one shape or flipper per line. The
+/// compiled form is a binary file that holds the same shapes together with a
+/// grid index for the static shapes, so that a table can be loaded by reading
+/// a few arrays straight into memory, with no parsing and no bucketing of
+/// shapes into grid cells. The static shapes in the grid are those that aren't
+/// gates, in the order in which they appear in the shape list.
+///
+/// The text form has a line for each shape or flipper, and anything after a
+/// `#` is a comment. Positions are in pixels and angles in degrees.
+///
+///     flipper left|right x y angle
+///     point x y [options]
+///     segment x0 y0 x1 y1 [options]
+///     circle x y r [options]
+///     arc x y r angle0 angle1 [options]
+///     polygon x0 y0 x1 y1 x2 y2 ... [options]
+///     chain x0 y0 x1 y1 ... [options]
+///     capsule x0 y0 r0 x1 y1 r1 [options]
+///
+/// A polygon must be convex and have between 3 and CPolygonDesc::MAX_VERTICES
+/// vertices, in either order. A chain is a static wall with any number of
+/// vertices from 2 up, each joined to the next. Neither may have two
+/// consecutive vertices in the same place. The vertices of both go into
+/// a separate vertex list so that the shapes stay the same size. A capsule is
+/// a circle of radius r0 centered at (x0, y0) and one of radius r1 centered
+/// at (x1, y1), joined by their common tangents, which is the shape of a
+/// flipper.
+///
+/// The options are `e=elasticity`, `kinematic`, `sensor`, `nocollide` for a
+/// shape that is only there to carry a sprite, `loop` for a chain whose last
+/// vertex is joined to its first, `sprite=unlit,lit`,
+/// `sound=name`, `score=n`, `offset=x,y` for the sprite offset, and `part=gate`,
+/// `part=flipper:n`, or `part=bumper:n`. The first shape of a bumper is the
+/// one that lights up and scores when any of the bumper's shapes is hit.
+
+class CTableDesc{
+  private:
+    CPointDesc m_cPointDesc; ///< Point descriptor for GetShapeDesc().
+    CLineSegDesc m_cLineSegDesc; ///< Line segment descriptor for GetShapeDesc().
+    CCircleDesc m_cCircleDesc; ///< Circle descriptor for GetShapeDesc().
+    CArcDesc m_cArcDesc; ///< Arc descriptor for GetShapeDesc().
+    CPolygonDesc m_cPolygonDesc; ///< Polygon descriptor for GetShapeDesc().
+    CChainDesc m_cChainDesc; ///< Chain descriptor for GetShapeDesc().
+    CCapsuleDesc m_cCapsuleDesc; ///< Capsule descriptor for GetShapeDesc().
+
+    UINT AddName(const std::string&); ///< Find or add name.
+    bool ParseLine(char*); ///< Parse a line of text.
+    bool IsValidPart(const CTableShape&) const; ///< Is a shape's part valid?
+    bool IsValidShape(const CTableShape&) const; ///< Is a compiled shape valid?
+    void Reset(); ///< Remove everything.
+
+  public:
+    std::vector<CTableShape> m_stdShapes; ///< Shapes.
+    std::vector<CTableFlipper> m_stdFlippers; ///< Flippers.
+    std::vector<Vector2> m_stdVertices; ///< Polygon and chain vertices.
+    std::vector<std::string> m_stdNames; ///< Names of sprites and sounds.
+    CGridIndex m_cGrid; ///< Grid index for static shapes, if baked.
+    UINT m_nSourceHash = 0; ///< Hash of the text the table was parsed from.
+
+    bool LoadText(const char*); ///< Load source form.
+    bool SaveText(const char*) const; ///< Save source form.
+    bool LoadBinary(const char*); ///< Load compiled form.
+    bool SaveBinary(const char*) const; ///< Save compiled form.
+    bool Load(const char*, const char*, float); ///< Load compiled form, or compile it if out of date.
+
+    void Bake(float); ///< Work out grid index.
+    bool IsBaked() const; ///< Has the grid index been worked out?
+    bool CanMake(UINT) const; ///< Can a shape be made?
+    bool IsGridShape(UINT) const; ///< Does a shape go in the grid?
+
+    CShapeDesc* GetShapeDesc(UINT); ///< Get shape descriptor for a shape.
+    const char* GetName(UINT) const; ///< Get name from index.
+
+    static UINT Hash(const char*, size_t); ///< Hash some text.
+}; //CTableDesc
+
+#endif //__L4RC_PHYSICS_TABLEDESC_H__
@@ -0,0 +1,115 @@
+/// \file VectorMath.h
+/// \brief Portable vector math for the collision module.
+///
+/// On Windows this includes the Windows headers, DirectXMath, and the
+/// DirectXTK SimpleMath header, exactly as the collision module always has.
+/// Elsewhere it provides the small part of them that the collision module
+/// actually uses, that is, `UINT`, `min`, `max`, `fopen_s`, unqualified
+/// `isfinite` and `isinf`, the constants `XM_PI` and `XM_2PI`, and a 
+/// `Vector2` with the same interface as the SimpleMath one, so that the
+/// collision module and the benchmarks can be built and measured on
+/// other platforms.
+
+#ifndef __L4RC_PHYSICS_VECTORMATH_H__
+#define __L4RC_PHYSICS_VECTORMATH_H__
+
+#ifdef _WIN32
+
+#include <windows.h>
+#include <windowsx.h>
+
+#include <d3d11_2.h>
+#include <dxgi1_3.h>
+#include <DirectXMath.h>
+#include "SimpleMath.h"
+
+#else //not _WIN32
+
+#include <cmath>
+#include <cstdio>
+
+typedef unsigned int UINT; ///< Unsigned integer, as in windows.h.
+
+using std::isfinite;
+using std::isinf;
+
+/// Minimum of two values of the same type, standing in for the Windows macro.
+/// \param a A value.
+/// \param b Another value.
+/// \return The smaller of a and b.
+
+template<class T> inline T min(T a, T b){
+  return b < a? b: a;
+} //min
+
+/// Maximum of two values of the same type, standing in for the Windows macro.
+/// \param a A value.
+/// \param b Another value.
+/// \return The larger of a and b.
+
+template<class T> inline T max(T a, T b){
+  return a < b? b: a;
+} //max
+
+/// Open a file, standing in for the Microsoft secure version of fopen().
+/// \param pFile [out] Pointer to the file, or nullptr if it can't be opened.
+/// \param fname File name.
+/// \param mode File access mode, as for fopen().
+/// \return 0 if the file was opened, nonzero otherwise.
+
+inline int fopen_s(FILE** pFile, const char* fname, const char* mode){
+  *pFile = fopen(fname, mode);
+  return *pFile? 0: 1;
+} //fopen_s
+
+namespace DirectX{
+  const float XM_PI = 3.141592654f; ///< Pi.
+  const float XM_2PI = 6.283185307f; ///< Two pi.
+
+  namespace SimpleMath{
+    /// \brief 2D vector.
+    ///
+    /// A stand-in for the SimpleMath `Vector2`, with only the
+    /// functions and operators that the collision module uses.
+
+    struct Vector2{
+      float x; ///< X coordinate.
+      float y; ///< Y coordinate.
+
+      Vector2(): x(0.0f), y(0.0f){} ///< Zero vector.
+      explicit Vector2(float a): x(a), y(a){} ///< Both coordinates the same.
+      Vector2(float a, float b): x(a), y(b){} ///< Given coordinates.
+
+      Vector2& operator+=(const Vector2& v){x += v.x; y += v.y; return *this;} ///< Add.
+      Vector2& operator-=(const Vector2& v){x -= v.x; y -= v.y; return *this;} ///< Subtract.
+      Vector2& operator*=(float s){x *= s; y *= s; return *this;} ///< Scale.
+      Vector2& operator/=(float s){x /= s; y /= s; return *this;} ///< Divide.
+
+      Vector2 operator+() const{return *this;} ///< Unary plus.
+      Vector2 operator-() const{return Vector2(-x, -y);} ///< Negate.
+
+      bool operator==(const Vector2& v) const{return x == v.x && y == v.y;} ///< Equal.
+      bool operator!=(const Vector2& v) const{return x != v.x || y != v.y;} ///< Not equal.
+
+      float Dot(const Vector2& v) const{return x*v.x + y*v.y;} ///< Dot product.
+      float LengthSquared() const{return x*x + y*y;} ///< Square of length.
+      float Length() const{return sqrtf(x*x + y*y);} ///< Length.
+
+      /// Make unit length, leaving the zero vector alone.
+      void Normalize(){
+        const float d = Length();
+        if(d > 0.0f){x /= d; y /= d;}
+      } //Normalize
+    }; //Vector2
+
+    inline Vector2 operator+(Vector2 u, const Vector2& v){return u += v;} ///< Sum.
+    inline Vector2 operator-(Vector2 u, const Vector2& v){return u -= v;} ///< Difference.
+    inline Vector2 operator*(Vector2 u, float s){return u *= s;} ///< Scale.
+    inline Vector2 operator*(float s, Vector2 u){return u *= s;} ///< Scale.
+    inline Vector2 operator/(Vector2 u, float s){return u /= s;} ///< Divide.
+  } //SimpleMath
+} //DirectX
+
+#endif //_WIN32
+
+#endif //__L4RC_PHYSICS_VECTORMATH_H__
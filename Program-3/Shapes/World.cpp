@@ -0,0 +1,340 @@
+/// \file World.cpp
+/// \brief Code for the physics world class CWorld.
+
+#include "World.h"
+#include "ShapeStore.h"
+#include "CollisionStats.h"
+
+const UINT MAX_IMPACTS = 4; ///< Maximum number of impacts resolved by a swept move.
+const float CACHE_MARGIN = 2.0f; ///< How close a shape must be to a dynamic circle to be a candidate.
+
+/// The destructor is virtual so that derived classes can override the
+/// functions that take part in a substep.
+
+CWorld::~CWorld(){
+} //destructor
+
+/// Add a shape to the world. A static shape goes into the static shape list,
+/// from which the grid is to be built once all of them have been added. A
+/// kinematic shape goes into the AABB tree, and a dynamic circle into the
+/// dynamic circle list and sweep and prune. The shape still belongs to
+/// whoever made it.
+/// \param p Pointer to a shape.
+
+void CWorld::Add(CShape* p){
+  switch(p->GetMotionType()){
+    case eMotion::Static:
+      m_stdStatic.push_back(p);
+      break;
+
+    case eMotion::Kinematic:
+      m_cTree.Insert(p);
+      break;
+
+    case eMotion::Dynamic:
+      m_stdCircles.push_back((CDynamicCircle*)p);
+      m_cSweep.Insert((CDynamicCircle*)p);
+      break;
+
+    default: break;
+  } //switch
+} //Add
+
+/// Add a compound shape, which will be moved at the start of each substep.
+/// Its shapes should be added too, so that they go into the AABB tree.
+/// \param p Pointer to a compound shape.
+
+void CWorld::Add(CCompoundShape* p){
+  m_stdCompounds.push_back(p);
+} //Add
+
+/// Set the bounds of the world. A dynamic circle whose AABB leaves them is
+/// lost, and is removed at the end of the move part of a substep. Until this
+/// is called, dynamic circles are never lost.
+/// \param aabb Bounds.
+
+void CWorld::SetBounds(const CAabb2D& aabb){
+  m_cBounds = aabb;
+  m_bBounded = true;
+} //SetBounds
+
+/// Remove all of the shapes from the world and empty the grid, the AABB
+/// tree, sweep and prune, and the contact solver. The bounds are kept.
+/// The shapes themselves are not deleted, so beware.
+
+void CWorld::Clear(){
+  m_stdStatic.clear();
+  m_stdCircles.clear();
+  m_stdCompounds.clear();
+
+  m_cGrid.Clear();
+  m_cTree.Clear();
+  m_cSweep.Clear();
+  m_cSolver.Clear();
+
+  m_stdCandidates.clear();
+  m_stdRotating.clear();
+  m_stdCache.clear();
+  m_stdPairs.clear();
+} //Clear
+
+/// Take one substep. Move the compound shapes, move each dynamic circle,
+/// remove the lost ones, find the candidates for collision, do narrow phase
+/// collision detection on them, and resolve the contacts that it finds.
+/// \param n Number of contact solver iterations.
+
+void CWorld::Substep(UINT n){
+  MoveCompounds();
+
+  for(auto const& p: m_stdCircles){
+    p->UpdateSleep(); //fall asleep if it's been still
+    SweptMove(p); //move it
+  } //for
+
+  RemoveLost();
+  FindCandidates();
+  NarrowPhase();
+  m_cSolver.Solve(n); //collision response
+} //Substep
+
+/// Move the compound shapes and update the AABB tree for the kinematic
+/// shapes that have moved. The ones that are rotating are listed for
+/// SweptMove().
+
+void CWorld::MoveCompounds(){
+  m_stdRotating.clear();
+
+  for(auto const& p: m_stdCompounds)
+    if(p->move()) //false if it hasn't moved since the last substep
+      for(auto const& q: p->GetShapes()){
+        m_cTree.Update(q); //reinserted only if it left its fat AABB
+        if(q->GetRotating())m_stdRotating.push_back(q);
+      } //for
+} //MoveCompounds
+
+/// Move a dynamic circle through one time step. A slow one is simply moved,
+/// since NarrowPhase() will catch anything that it hits. A fast one might pass
+/// right through a thin static shape between one substep and the next, so it
+/// is swept through the static shapes in the grid instead. It is advanced to
+/// the earliest time of impact, the impact is resolved exactly using
+/// CollisionResponse(), and then it continues on through the rest of the time
+/// step. A rotating flipper can sweep right through even a slow dynamic
+/// circle, or one that is asleep, so every dynamic circle is also swept
+/// against the rotating kinematic shapes, which are where they will be at
+/// the end of the substep, by CDynamicCircle::KinematicTOI(). At most
+/// MAX_IMPACTS impacts are resolved this way, after which any others are
+/// left to NarrowPhase().
+/// \param pCirc Pointer to a dynamic circle.
+
+void CWorld::SweptMove(CDynamicCircle* pCirc){
+  float f = 1.0f; //fraction of the time step remaining
+  const bool bFast = pCirc->IsFast();
+
+  if(bFast || !m_stdRotating.empty())
+    for(UINT n=0; n<MAX_IMPACTS && f > 0.0f; n++){
+      float t = f; //fraction of the time step to the impact
+      CContactDesc cd(nullptr, pCirc);
+      bool bHit = false; //whether it hits anything
+
+      if(bFast){
+        const CAabb2D aabb = pCirc->GetSweptAABB(f);
+        m_cGrid.Query(aabb, m_stdCandidates); //static shapes near its path
+        m_cGrid.QueryLineSegs(aabb, m_stdCandidates); //static line segments near its path
+        bHit = pCirc->TimeOfImpact(m_stdCandidates, t, cd);
+      } //if
+
+      bHit = pCirc->KinematicTOI(m_stdRotating, 1.0f - f, t, cd) || bHit;
+      if(!bHit)break; //clear path
+
+      pCirc->Wake(); //in case a flipper hit it in its sleep
+      pCirc->move(t); //advance to the time of impact
+      CollisionResponse(cd); //and bounce
+      f -= t;
+    } //for
+
+  pCirc->move(f); //the rest of the way
+} //SweptMove
+
+/// Immediate collision response for a contact found by time of impact, which
+/// can't wait for the contact solver because the dynamic circle has the rest
+/// of its time step still to travel. The dynamic circle bounces off the shape
+/// unless the shape is a sensor.
+/// \param cd Contact descriptor which has been filled in by collision detection.
+
+void CWorld::CollisionResponse(const CContactDesc& cd){
+  if(!cd.m_pShape->GetSensor())
+    cd.m_pCircle->PostCollide(cd);
+
+  OnCollision(cd);
+} //CollisionResponse
+
+/// Remove the dynamic circles whose AABBs have left the bounds, if there are
+/// any bounds, from the dynamic circle list and sweep and prune, and pass
+/// each of them to OnLost().
+
+void CWorld::RemoveLost(){
+  if(!m_bBounded)return; //nothing is ever lost
+
+  for(size_t i=0; i<m_stdCircles.size();){
+    CDynamicCircle* p = m_stdCircles[i];
+
+    if(!(m_cBounds && p->GetAABB())){
+      m_cSweep.Remove(p); //remove from sweep and prune
+
+      m_stdCircles[i] = m_stdCircles.back(); //move the last one into its place
+      m_stdCircles.pop_back(); //and look at that one next
+      OnLost(p); //now that it is out of the world
+    } //if
+
+    else ++i;
+  } //for
+} //RemoveLost
+
+/// Find the candidates for collision with each dynamic circle: the static
+/// and kinematic shapes, and the dynamic circles that appear after it in the
+/// dynamic circle list, that are within CACHE_MARGIN of it. Static line
+/// segments are found in batches by the grid, and other static shapes using
+/// the grid and an AABB test. Kinematic shapes are found using the AABB tree.
+/// Pairs of dynamic circles are found using sweep and prune, which reports
+/// each pair only once. A dynamic circle that is asleep hasn't moved, so it
+/// gets no candidates unless a rotating kinematic shape or an awake dynamic
+/// circle comes close enough to wake it up. Collision response moves dynamic
+/// circles by only a little more than their setback distance, so the
+/// candidates found here are good for the whole substep.
+
+void CWorld::FindCandidates(){
+  m_stdCache.clear();
+
+  for(auto const& pCirc: m_stdCircles){
+    CAabb2D aabb = pCirc->GetAABB();
+    aabb.Expand(CACHE_MARGIN);
+
+    if(pCirc->IsAsleep()){ //wake it only if a moving kinematic shape is near
+      m_cTree.Query(aabb, m_stdCandidates);
+
+      for(auto const& pShape: m_stdCandidates)
+        if(pShape->GetRotating() && AabbTest(pShape, aabb)){
+          pCirc->Wake();
+          break;
+        } //if
+
+      if(pCirc->IsAsleep())continue; //still asleep, so nothing has changed
+    } //if
+
+    m_stdCandidates.clear();
+    m_cGrid.NearLineSegs(pCirc, CACHE_MARGIN, m_stdCandidates); //static line segments
+
+    for(auto const& pShape: m_stdCandidates)
+      m_stdCache.push_back(CShapePair(pShape, pCirc));
+
+    m_cGrid.Query(aabb, m_stdCandidates); //other static shapes
+
+    for(auto const& pShape: m_stdCandidates)
+      if(AabbTest(pShape, aabb))
+        m_stdCache.push_back(CShapePair(pShape, pCirc));
+
+    m_cTree.Query(aabb, m_stdCandidates); //kinematic shapes
+
+    for(auto const& pShape: m_stdCandidates)
+      if(AabbTest(pShape, aabb))
+        m_stdCache.push_back(CShapePair(pShape, pCirc));
+  } //for
+
+  m_cSweep.Update(); //re-sort after moving
+  m_cSweep.GetPairs(m_stdPairs, CACHE_MARGIN); //dynamic circles
+
+  size_t n = 0; //number of pairs kept
+
+  for(auto const& pair: m_stdPairs)
+    if(!pair.first->IsAsleep() || !pair.second->IsAsleep()){ //one of them can have moved
+      pair.first->Wake(); //one of them is awake and close to the other
+      pair.second->Wake();
+      m_stdPairs[n++] = pair;
+    } //if
+
+  m_stdPairs.resize(n);
+} //FindCandidates
+
+/// Test whether the AABB of a shape overlaps another AABB,
+/// and record the test in the collision statistics.
+/// \param pShape Pointer to a static or kinematic shape.
+/// \param aabb AABB of a moving circle, possibly expanded.
+/// \return true if the AABBs overlap.
+
+bool CWorld::AabbTest(CShape* pShape, const CAabb2D& aabb){
+  CCollisionStats::AabbTest(pShape->GetShapeType());
+  return pShape->GetAABB() && aabb;
+} //AabbTest
+
+/// Do narrow phase collision detection for the candidates found by
+/// FindCandidates(), after giving Collide() a chance to do its own for
+/// each awake dynamic circle. The contacts found go into the contact
+/// solver's buffer, to be resolved together by CContactSolver::Solve().
+
+void CWorld::NarrowPhase(){
+  m_cSolver.Begin();
+
+  for(auto const& p: m_stdCircles)
+    if(!p->IsAsleep())
+      Collide(p);
+
+  for(auto const& pair: m_stdCache) //static and kinematic shapes
+    NarrowPhase(pair.first, pair.second);
+
+  for(auto const& pair: m_stdPairs) //dynamic circles
+    NarrowPhase(pair.second, pair.first);
+} //NarrowPhase
+
+/// Narrow phase collision detection for a dynamic circle against a shape,
+/// which may touch it at more than one place if it is a chain. Each contact
+/// or near miss within the cache margin is added to the contact solver's
+/// buffer unless the shape is a sensor, and each one that is touching is
+/// passed to OnCollision().
+/// \param pShape Pointer to a shape.
+/// \param pCirc Pointer to a dynamic circle.
+/// \return true if they collided.
+
+bool CWorld::NarrowPhase(CShape* pShape, CDynamicCircle* pCirc){
+  CContactDesc cd(pShape, pCirc);
+  cd.m_fMargin = CACHE_MARGIN; //near misses too
+
+  m_stdContacts.clear();
+  CShapeStore::PreCollide(pShape, cd, m_stdContacts); //no virtual call
+  bool bHit = false; //whether any of them are actually touching
+
+  for(auto const& c: m_stdContacts){
+    if(!pShape->GetSensor())
+      m_cSolver.Add(c);
+
+    if(c.m_fSetback < 0.0f){ //there's a collision
+      OnCollision(c);
+      bHit = true;
+    } //if
+  } //for
+
+  CCollisionStats::PreCollide(pShape->GetShapeType(), bHit);
+  return bHit;
+} //NarrowPhase
+
+/// Extra collision detection for an awake dynamic circle, called by
+/// NarrowPhase() before the candidates are tested. A derived class can
+/// override this for shapes that need collision response of their own and
+/// so aren't in the world, such as the game's one-way gates. This one
+/// does nothing.
+
+void CWorld::Collide(CDynamicCircle*){
+} //Collide
+
+/// Hear about a collision, whether found by narrow phase or by time of
+/// impact. A derived class can override this to make sounds, keep score,
+/// and so on. This one does nothing.
+
+void CWorld::OnCollision(const CContactDesc&){
+} //OnCollision
+
+/// Get rid of a dynamic circle that has left the bounds, which RemoveLost()
+/// has already taken out of the world. A derived class can override this
+/// to delete the dynamic circle. This one does nothing.
+
+void CWorld::OnLost(CDynamicCircle*){
+} //OnLost
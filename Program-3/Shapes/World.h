@@ -0,0 +1,79 @@
+/// \file World.h
+/// \brief Interface for the physics world class CWorld.
+
+#ifndef __L4RC_PHYSICS_WORLD_H__
+#define __L4RC_PHYSICS_WORLD_H__
+
+#include <vector>
+
+#include "Grid.h"
+#include "AabbTree.h"
+#include "SweepAndPrune.h"
+#include "ContactSolver.h"
+#include "Compound.h"
+
+/// \brief Physics world.
+///
+/// The broad phase data structures and the substep pipeline, shared by the
+/// game's object manager and the benchmark scenes so that they take each
+/// substep the same way. Static shapes go into a uniform grid, which is built
+/// once all of them have been added, kinematic shapes into an AABB tree, and
+/// dynamic circles into sweep and prune. Each substep moves the compound
+/// shapes, moves the dynamic circles, sweeping them through the static shapes
+/// if they are fast and through the rotating kinematic shapes whether they
+/// are or not, removes the ones that have left the bounds, finds the
+/// candidates for collision, does narrow phase collision detection on them,
+/// and resolves the contacts with the contact solver.
+///
+/// The world doesn't own any shapes. A derived class can take part in a
+/// substep by overriding Collide(), which does its own collision detection
+/// for each awake dynamic circle, OnCollision(), which hears about each
+/// collision, and OnLost(), which is told about each dynamic circle that
+/// leaves the bounds so that it can get rid of it. A derived class can also
+/// put the stages of a substep together in its own way.
+
+class CWorld{
+  protected:
+    std::vector<CShape*> m_stdStatic; ///< Static shapes, which the grid is built from.
+    std::vector<CDynamicCircle*> m_stdCircles; ///< Dynamic circles.
+    std::vector<CCompoundShape*> m_stdCompounds; ///< Compound shapes, which move the kinematic shapes.
+
+    CGrid m_cGrid; ///< Uniform grid of static shapes.
+    CAabbTree m_cTree; ///< AABB tree of kinematic shapes.
+    CSweepAndPrune m_cSweep; ///< Sweep and prune for dynamic circles.
+    CContactSolver m_cSolver; ///< Solves the contacts found in each substep.
+
+    CAabb2D m_cBounds; ///< Dynamic circles outside this are lost.
+    bool m_bBounded = false; ///< Whether dynamic circles can be lost.
+
+    std::vector<CShape*> m_stdCandidates; ///< Shapes found by the latest broad phase query.
+    std::vector<CShape*> m_stdRotating; ///< Kinematic shapes that are rotating, found once per substep.
+    std::vector<CShapePair> m_stdCache; ///< Candidates for collision with dynamic circles, found once per substep.
+    std::vector<CContactDesc> m_stdContacts; ///< Contacts found by the latest narrow phase test.
+    std::vector<CCirclePair> m_stdPairs; ///< Pairs of dynamic circles found by sweep and prune.
+
+    virtual void Collide(CDynamicCircle*); ///< Extra collision detection.
+    virtual void OnCollision(const CContactDesc&); ///< Hear about a collision.
+    virtual void OnLost(CDynamicCircle*); ///< Get rid of a lost dynamic circle.
+
+    void MoveCompounds(); ///< Move compound shapes.
+    void SweptMove(CDynamicCircle*); ///< Move dynamic circle with continuous collision detection.
+    void CollisionResponse(const CContactDesc&); ///< Immediate collision response.
+    void RemoveLost(); ///< Remove dynamic circles outside the bounds.
+    void FindCandidates(); ///< Find candidates for collision.
+    bool AabbTest(CShape*, const CAabb2D&); ///< AABB test for broad phase.
+    void NarrowPhase(); ///< Narrow phase for all candidates.
+    bool NarrowPhase(CShape*, CDynamicCircle*); ///< Narrow phase for one candidate.
+
+  public:
+    virtual ~CWorld(); ///< Destructor.
+
+    void Add(CShape*); ///< Add a shape.
+    void Add(CCompoundShape*); ///< Add a compound shape.
+    void SetBounds(const CAabb2D&); ///< Set bounds.
+    void Clear(); ///< Remove everything.
+
+    void Substep(UINT); ///< Take one substep.
+}; //CWorld
+
+#endif //__L4RC_PHYSICS_WORLD_H__